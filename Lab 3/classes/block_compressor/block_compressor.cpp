@@ -0,0 +1,604 @@
+/**
+ * @file block_compressor.cpp
+ * @brief BlockCompressor class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "block_compressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/job_runner/job_runner.h"
+
+namespace bgq_opengl {
+
+	void BlockCompressor::compress(const unsigned char* pixels, int width, int height, int format, unsigned char* out) {
+
+		if (format == TEXTURE_FORMAT_RGBA8) {
+
+			memcpy(out, pixels, (size_t) width * height * 4);
+			return;
+
+		}
+
+		// Keep only the first channels of every pixel.
+		if (!BlockCompressor::isCompressed(format)) {
+
+			int channels = format == TEXTURE_FORMAT_R8 ? 1 : 2;
+			size_t count = (size_t) width * height;
+
+			for (size_t i = 0; i < count; i++)
+				memcpy(out + i * channels, pixels + i * 4, channels);
+
+			return;
+
+		}
+
+		int blocks_x = (width + 3) / 4;
+		int blocks_y = (height + 3) / 4;
+		size_t block_bytes = BlockCompressor::getSize(4, 4, format);
+
+		// Every job is a row of blocks.
+		JobRunner::run(blocks_y, 0, [=](int by) {
+
+			unsigned char block[64];
+
+			for (int bx = 0; bx < blocks_x; bx++) {
+
+				// Gather the block, repeating the last row and column past the edges.
+				for (int y = 0; y < 4; y++) {
+
+					int source_y = std::min(by * 4 + y, height - 1);
+
+					for (int x = 0; x < 4; x++) {
+
+						int source_x = std::min(bx * 4 + x, width - 1);
+						memcpy(block + (y * 4 + x) * 4, pixels + ((size_t) source_y * width + source_x) * 4, 4);
+
+					}
+
+				}
+
+				BlockCompressor::encodeBlock(block, format, out + ((size_t) by * blocks_x + bx) * block_bytes);
+
+			}
+
+		});
+
+	}
+
+	size_t BlockCompressor::getSize(int width, int height, int format) {
+
+		size_t blocks = (size_t) ((width + 3) / 4) * ((height + 3) / 4);
+
+		switch (format) {
+
+			case TEXTURE_FORMAT_BC1:
+			case TEXTURE_FORMAT_BC4:
+				return blocks * 8;
+
+			case TEXTURE_FORMAT_BC3:
+			case TEXTURE_FORMAT_BC5:
+			case TEXTURE_FORMAT_BC7:
+				return blocks * 16;
+
+			case TEXTURE_FORMAT_R8:
+				return (size_t) width * height;
+
+			case TEXTURE_FORMAT_RG8:
+				return (size_t) width * height * 2;
+
+			default:
+				return (size_t) width * height * 4;
+
+		}
+
+	}
+
+	bool BlockCompressor::isCompressed(int format) {
+
+		return format != TEXTURE_FORMAT_RGBA8 && format != TEXTURE_FORMAT_R8 && format != TEXTURE_FORMAT_RG8;
+
+	}
+
+	bool BlockCompressor::isSupported(int format) {
+
+		switch (format) {
+
+			case TEXTURE_FORMAT_BC1:
+			case TEXTURE_FORMAT_BC3:
+				return GLEW_EXT_texture_compression_s3tc;
+
+			case TEXTURE_FORMAT_BC4:
+			case TEXTURE_FORMAT_BC5:
+				return GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+
+			// Not in the 4.1 contexts macOS gives.
+			case TEXTURE_FORMAT_BC7:
+				return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+
+			default:
+				return true;
+
+		}
+
+	}
+
+	int BlockCompressor::choose(int preferred, int fallback) {
+
+		if (BlockCompressor::isSupported(preferred))
+			return preferred;
+
+		if (BlockCompressor::isSupported(fallback))
+			return fallback;
+
+		return TEXTURE_FORMAT_RGBA8;
+
+	}
+
+	int BlockCompressor::chooseFor(int usage) {
+
+		switch (usage) {
+
+			// BC1 has no sRGB format without EXT_texture_sRGB, so colors stay uncompressed sRGB then
+			// rather than being sampled as linear.
+			case TEXTURE_USAGE_COLOR:
+				return BlockCompressor::choose(TEXTURE_FORMAT_BC7, GLEW_EXT_texture_sRGB ? TEXTURE_FORMAT_BC1 : TEXTURE_FORMAT_RGBA8);
+
+			case TEXTURE_USAGE_BUMP:
+				return BlockCompressor::choose(TEXTURE_FORMAT_BC4, TEXTURE_FORMAT_R8);
+
+			case TEXTURE_USAGE_NORMAL:
+			case TEXTURE_USAGE_DERIVATIVE:
+				return BlockCompressor::choose(TEXTURE_FORMAT_BC5, TEXTURE_FORMAT_RG8);
+
+			default:
+				return TEXTURE_FORMAT_RGBA8;
+
+		}
+
+	}
+
+	GLenum BlockCompressor::getInternalFormat(int format, int usage) {
+
+		// The sRGB S3TC formats come in their own extension. chooseFor() never picks them without it,
+		// but a format asked for directly falls back to linear, so say so.
+		if (usage == TEXTURE_USAGE_COLOR) {
+
+			switch (format) {
+
+				case TEXTURE_FORMAT_BC1: if (GLEW_EXT_texture_sRGB) return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT; break;
+				case TEXTURE_FORMAT_BC3: if (GLEW_EXT_texture_sRGB) return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT; break;
+				case TEXTURE_FORMAT_BC7: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+				case TEXTURE_FORMAT_RGBA8: return GL_SRGB8_ALPHA8;
+
+			}
+
+			if (format == TEXTURE_FORMAT_BC1 || format == TEXTURE_FORMAT_BC3)
+				std::cerr << "BlockCompressor warning - No sRGB " << BlockCompressor::getName(format) << " without EXT_texture_sRGB, the colors will be sampled as linear." << std::endl;
+
+		}
+
+		switch (format) {
+
+			case TEXTURE_FORMAT_BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+			case TEXTURE_FORMAT_BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			case TEXTURE_FORMAT_BC4: return GL_COMPRESSED_RED_RGTC1;
+			case TEXTURE_FORMAT_BC5: return GL_COMPRESSED_RG_RGTC2;
+			case TEXTURE_FORMAT_BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+			case TEXTURE_FORMAT_R8: return GL_R8;
+			case TEXTURE_FORMAT_RG8: return GL_RG8;
+			default: return GL_RGBA8;
+
+		}
+
+	}
+
+	GLenum BlockCompressor::getPixelFormat(int format) {
+
+		switch (format) {
+
+			case TEXTURE_FORMAT_R8: return GL_RED;
+			case TEXTURE_FORMAT_RG8: return GL_RG;
+			default: return GL_RGBA;
+
+		}
+
+	}
+
+	const char* BlockCompressor::getName(int format) {
+
+		switch (format) {
+
+			case TEXTURE_FORMAT_BC1: return "BC1";
+			case TEXTURE_FORMAT_BC3: return "BC3";
+			case TEXTURE_FORMAT_BC4: return "BC4";
+			case TEXTURE_FORMAT_BC5: return "BC5";
+			case TEXTURE_FORMAT_BC7: return "BC7";
+			case TEXTURE_FORMAT_R8: return "R8";
+			case TEXTURE_FORMAT_RG8: return "RG8";
+			default: return "RGBA8";
+
+		}
+
+	}
+
+	void BlockCompressor::encodeBlock(const unsigned char* block, int format, unsigned char* out) {
+
+		switch (format) {
+
+			case TEXTURE_FORMAT_BC1:
+				BlockCompressor::encodeBC1(block, out);
+				break;
+
+			// Alpha first, then the color.
+			case TEXTURE_FORMAT_BC3:
+				BlockCompressor::encodeBC4(block, 3, out);
+				BlockCompressor::encodeBC1(block, out + 8);
+				break;
+
+			case TEXTURE_FORMAT_BC4:
+				BlockCompressor::encodeBC4(block, 0, out);
+				break;
+
+			case TEXTURE_FORMAT_BC5:
+				BlockCompressor::encodeBC4(block, 0, out);
+				BlockCompressor::encodeBC4(block, 1, out + 8);
+				break;
+
+			case TEXTURE_FORMAT_BC7:
+				BlockCompressor::encodeBC7(block, out);
+				break;
+
+		}
+
+	}
+
+	void BlockCompressor::encodeBC1(const unsigned char* block, unsigned char* out) {
+
+		float start[4], end[4];
+		BlockCompressor::fitLine(block, 3, start, end);
+
+		// Round the ends to 5:6:5.
+		auto pack = [](const float* color) {
+
+			int r = (int) (std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+			int g = (int) (std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+			int b = (int) (std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+
+			return (uint16_t) ((r << 11) | (g << 5) | b);
+
+		};
+
+		uint16_t color0 = pack(end);
+		uint16_t color1 = pack(start);
+
+		// The first color has to be the larger one, or the block is read as having transparency.
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		uint32_t indices = 0;
+
+		if (color0 != color1) {
+
+			// Expand the ends back the way the GPU does, and build the two colors in between.
+			float palette[4][3];
+			uint16_t ends[2] = { color0, color1 };
+
+			for (int i = 0; i < 2; i++) {
+
+				int r = (ends[i] >> 11) & 31, g = (ends[i] >> 5) & 63, b = ends[i] & 31;
+				palette[i][0] = (float) ((r << 3) | (r >> 2));
+				palette[i][1] = (float) ((g << 2) | (g >> 4));
+				palette[i][2] = (float) ((b << 3) | (b >> 2));
+
+			}
+
+			for (int c = 0; c < 3; c++) {
+
+				palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+				palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+
+			}
+
+			for (int i = 0; i < 16; i++) {
+
+				int best = 0;
+				float best_error = 1e30f;
+
+				for (int j = 0; j < 4; j++) {
+
+					float dr = block[i * 4] - palette[j][0];
+					float dg = block[i * 4 + 1] - palette[j][1];
+					float db = block[i * 4 + 2] - palette[j][2];
+					float error = dr * dr + dg * dg + db * db;
+
+					if (error < best_error) {
+
+						best = j;
+						best_error = error;
+
+					}
+
+				}
+
+				indices |= (uint32_t) best << (i * 2);
+
+			}
+
+		}
+
+		// Everything is little endian.
+		out[0] = color0 & 0xFF;
+		out[1] = color0 >> 8;
+		out[2] = color1 & 0xFF;
+		out[3] = color1 >> 8;
+
+		for (int i = 0; i < 4; i++)
+			out[4 + i] = (indices >> (i * 8)) & 0xFF;
+
+	}
+
+	void BlockCompressor::encodeBC4(const unsigned char* block, int channel, unsigned char* out) {
+
+		int low = 255, high = 0;
+
+		for (int i = 0; i < 16; i++) {
+
+			low = std::min(low, (int) block[i * 4 + channel]);
+			high = std::max(high, (int) block[i * 4 + channel]);
+
+		}
+
+		// The larger value first picks the mode with 6 steps in between.
+		out[0] = (unsigned char) high;
+		out[1] = (unsigned char) low;
+
+		uint64_t indices = 0;
+
+		if (high != low) {
+
+			int palette[8];
+			palette[0] = high;
+			palette[1] = low;
+
+			for (int i = 2; i < 8; i++)
+				palette[i] = ((8 - i) * high + (i - 1) * low + 3) / 7;
+
+			for (int i = 0; i < 16; i++) {
+
+				int value = block[i * 4 + channel];
+				int best = 0;
+
+				for (int j = 1; j < 8; j++)
+					if (std::abs(value - palette[j]) < std::abs(value - palette[best]))
+						best = j;
+
+				indices |= (uint64_t) best << (i * 3);
+
+			}
+
+		}
+
+		for (int i = 0; i < 6; i++)
+			out[2 + i] = (indices >> (i * 8)) & 0xFF;
+
+	}
+
+	void BlockCompressor::encodeBC7(const unsigned char* block, unsigned char* out) {
+
+		static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		float start[4], end[4];
+		BlockCompressor::fitLine(block, 4, start, end);
+
+		int best_ends[2][4] = {};
+		int best_bits[2] = { 0, 0 };
+		int best_indices[16] = {};
+		long best_error = -1;
+
+		// The endpoints are 7 bits plus a shared low bit each, so try all four low bits.
+		for (int combination = 0; combination < 4; combination++) {
+
+			int bits[2] = { combination & 1, combination >> 1 };
+			int ends[2][4];
+			int expanded[2][4];
+
+			for (int c = 0; c < 4; c++) {
+
+				ends[0][c] = std::clamp((int) std::lround((start[c] - bits[0]) / 2.0f), 0, 127);
+				ends[1][c] = std::clamp((int) std::lround((end[c] - bits[1]) / 2.0f), 0, 127);
+				expanded[0][c] = (ends[0][c] << 1) | bits[0];
+				expanded[1][c] = (ends[1][c] << 1) | bits[1];
+
+			}
+
+			int palette[16][4];
+
+			for (int i = 0; i < 16; i++)
+				for (int c = 0; c < 4; c++)
+					palette[i][c] = ((64 - weights[i]) * expanded[0][c] + weights[i] * expanded[1][c] + 32) >> 6;
+
+			int indices[16];
+			long error = 0;
+
+			for (int i = 0; i < 16; i++) {
+
+				int best = 0;
+				int best_distance = INT32_MAX;
+
+				for (int j = 0; j < 16; j++) {
+
+					int distance = 0;
+
+					for (int c = 0; c < 4; c++) {
+
+						int d = block[i * 4 + c] - palette[j][c];
+						distance += d * d;
+
+					}
+
+					if (distance < best_distance) {
+
+						best = j;
+						best_distance = distance;
+
+					}
+
+				}
+
+				indices[i] = best;
+				error += best_distance;
+
+			}
+
+			if (best_error < 0 || error < best_error) {
+
+				best_error = error;
+				memcpy(best_ends, ends, sizeof(ends));
+				memcpy(best_bits, bits, sizeof(bits));
+				memcpy(best_indices, indices, sizeof(indices));
+
+			}
+
+		}
+
+		// The top bit of the first index is not stored, so it must be 0. Swapping the ends clears it.
+		if (best_indices[0] >= 8) {
+
+			for (int c = 0; c < 4; c++)
+				std::swap(best_ends[0][c], best_ends[1][c]);
+
+			std::swap(best_bits[0], best_bits[1]);
+
+			for (int i = 0; i < 16; i++)
+				best_indices[i] = 15 - best_indices[i];
+
+		}
+
+		memset(out, 0, 16);
+		int position = 0;
+
+		auto write = [&](int value, int bits) {
+
+			for (int i = 0; i < bits; i++, position++)
+				out[position >> 3] |= ((value >> i) & 1) << (position & 7);
+
+		};
+
+		// Mode 6 is six zeros and a one.
+		write(1 << 6, 7);
+
+		for (int c = 0; c < 4; c++) {
+
+			write(best_ends[0][c], 7);
+			write(best_ends[1][c], 7);
+
+		}
+
+		write(best_bits[0], 1);
+		write(best_bits[1], 1);
+		write(best_indices[0], 3);
+
+		for (int i = 1; i < 16; i++)
+			write(best_indices[i], 4);
+
+	}
+
+	void BlockCompressor::fitLine(const unsigned char* block, int channels, float* start, float* end) {
+
+		float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		for (int i = 0; i < 16; i++)
+			for (int c = 0; c < channels; c++)
+				mean[c] += block[i * 4 + c] / 16.0f;
+
+		float covariance[4][4] = {};
+
+		for (int i = 0; i < 16; i++)
+			for (int a = 0; a < channels; a++)
+				for (int b = 0; b < channels; b++)
+					covariance[a][b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+
+		// Start from the channel that varies the most. Its column of the covariance already leans
+		// towards the main axis, where a fixed start can be orthogonal to it.
+		int widest = 0;
+
+		for (int c = 1; c < channels; c++)
+			if (covariance[c][c] > covariance[widest][widest])
+				widest = c;
+
+		float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		axis[widest] = 1.0f;
+
+		// Always the same number of power iterations, so every block converges as far.
+		for (int iteration = 0; iteration < BLOCK_COMPRESSOR_ITERATIONS; iteration++) {
+
+			float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float length = 0.0f;
+
+			for (int a = 0; a < channels; a++) {
+
+				for (int b = 0; b < channels; b++)
+					next[a] += covariance[a][b] * axis[b];
+
+				length += next[a] * next[a];
+
+			}
+
+			// Flat blocks have no axis, every pixel is the mean whatever the axis.
+			if (length < 1e-12f)
+				continue;
+
+			length = std::sqrt(length);
+
+			for (int a = 0; a < channels; a++)
+				axis[a] = next[a] / length;
+
+		}
+
+		float low = 0.0f, high = 0.0f;
+
+		for (int i = 0; i < 16; i++) {
+
+			float t = 0.0f;
+
+			for (int c = 0; c < channels; c++)
+				t += (block[i * 4 + c] - mean[c]) * axis[c];
+
+			low = std::min(low, t);
+			high = std::max(high, t);
+
+		}
+
+		// Pull the ends in a little, so the steps in between land closer to most pixels.
+		float inset = (high - low) / 16.0f;
+		low += inset;
+		high -= inset;
+
+		for (int c = 0; c < 4; c++) {
+
+			start[c] = c < channels ? mean[c] + axis[c] * low : 255.0f;
+			end[c] = c < channels ? mean[c] + axis[c] * high : 255.0f;
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,240 @@
+/**
+ * @file block_compressor.h
+ * @brief BlockCompressor class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BLOCK_COMPRESSOR_H_
+#define BGQ_OPENGL_CLASSES_BLOCK_COMPRESSOR_H_
+
+#define TEXTURE_FORMAT_RGBA8 0	/// Uncompressed, 4 bytes per pixel.
+#define TEXTURE_FORMAT_BC1 1	/// RGB, 8 bytes per 4x4 block.
+#define TEXTURE_FORMAT_BC3 2	/// RGBA, 16 bytes per block: BC1 color and BC4 alpha.
+#define TEXTURE_FORMAT_BC4 3	/// Red only, 8 bytes per block.
+#define TEXTURE_FORMAT_BC5 4	/// Red and green, 16 bytes per block: two BC4.
+#define TEXTURE_FORMAT_BC7 5	/// RGBA, 16 bytes per block, better quality than BC1 and BC3.
+#define TEXTURE_FORMAT_R8 6		/// Uncompressed red only, 1 byte per pixel.
+#define TEXTURE_FORMAT_RG8 7	/// Uncompressed red and green, 2 bytes per pixel.
+#define TEXTURE_FORMATS 8		/// Number of texture formats.
+
+#define TEXTURE_USAGE_DATA 0	/// Anything, all four channels kept as they are.
+#define TEXTURE_USAGE_COLOR 1	/// Colors stored in sRGB, sampled as linear.
+#define TEXTURE_USAGE_BUMP 2	/// Heights in the red channel.
+#define TEXTURE_USAGE_NORMAL 3	/// Normals in red and green, the shaders rebuild the third component.
+#define TEXTURE_USAGE_DERIVATIVE 4	/// Slopes of a bump map in red and green.
+
+#define BLOCK_COMPRESSOR_ITERATIONS 8	/// Power iterations when fitting the endpoints of a block.
+
+#include <cstddef>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a BlockCompressor class.
+	 *
+	 * Compresses RGBA8 images into the block formats the GPU samples directly,
+	 * so textures take 4 to 8 times less memory. Images are cut into 4x4
+	 * blocks that are encoded on their own, so the rows of blocks are split
+	 * across every core.
+	 *
+	 * BC1 and BC7 suit color maps, BC4 single channel maps such as bump maps,
+	 * and BC5 normal maps, whose third component is rebuilt in the shader.
+	 * Drivers without them still save memory with R8 and RG8, which only keep
+	 * the channels those maps use.
+	 * BC7 only gets a single subset mode (mode 6), which is plenty for smooth
+	 * images and far faster than searching every partition.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class BlockCompressor {
+
+		public:
+
+			/**
+			 * @brief Compresses an image.
+			 *
+			 * Compresses an RGBA8 image into a format, block row after block row.
+			 * Blocks that go past the edges repeat the last row and column. The
+			 * uncompressed formats just keep the channels they have.
+			 *
+			 * @param pixels The pixels, RGBA8.
+			 * @param width The width of the image.
+			 * @param height The height of the image.
+			 * @param format The format, one of the TEXTURE_FORMAT_ values.
+			 * @param out Output for the blocks, getSize() bytes.
+			 */
+			static void compress(const unsigned char* pixels, int width, int height, int format, unsigned char* out);
+
+			/**
+			 * @brief Get the size of an image.
+			 *
+			 * Get the size of an image once compressed into a format.
+			 *
+			 * @param width The width of the image.
+			 * @param height The height of the image.
+			 * @param format The format.
+			 *
+			 * @returns The size in bytes.
+			 */
+			static size_t getSize(int width, int height, int format);
+
+			/**
+			 * @brief Check whether a format is compressed.
+			 *
+			 * Check whether a format is made of blocks.
+			 *
+			 * @param format The format.
+			 *
+			 * @returns True unless it is RGBA8, R8 or RG8.
+			 */
+			static bool isCompressed(int format);
+
+			/**
+			 * @brief Check whether a format is supported.
+			 *
+			 * Check whether the driver can sample a format.
+			 *
+			 * @param format The format.
+			 *
+			 * @returns True if it is supported.
+			 */
+			static bool isSupported(int format);
+
+			/**
+			 * @brief Choose a supported format.
+			 *
+			 * Choose the first format the driver supports, or RGBA8 if neither is.
+			 *
+			 * @param preferred The format to use if possible.
+			 * @param fallback The format to use otherwise.
+			 *
+			 * @returns The format.
+			 */
+			static int choose(int preferred, int fallback);
+
+			/**
+			 * @brief Choose the format for a usage.
+			 *
+			 * Choose the smallest supported format that keeps the channels a kind
+			 * of texture uses: BC7 or else BC1 for colors, BC4 or else R8 for
+			 * bumps, BC5 or else RG8 for normals and derivatives, and RGBA8 for
+			 * anything else. Colors stay RGBA8 rather than BC1 when there is no
+			 * sRGB BC1.
+			 *
+			 * @param usage The usage, one of the TEXTURE_USAGE_ values.
+			 *
+			 * @returns The format.
+			 */
+			static int chooseFor(int usage);
+
+			/**
+			 * @brief Get the internal format.
+			 *
+			 * Get the OpenGL internal format of a format. Colors get the sRGB
+			 * variant, so they are filtered and shaded in linear space.
+			 *
+			 * @param format The format.
+			 * @param usage The usage, one of the TEXTURE_USAGE_ values.
+			 *
+			 * @returns The OpenGL internal format.
+			 */
+			static GLenum getInternalFormat(int format, int usage = TEXTURE_USAGE_DATA);
+
+			/**
+			 * @brief Get the pixel format.
+			 *
+			 * Get the OpenGL format of the pixels of an uncompressed format.
+			 *
+			 * @param format The format.
+			 *
+			 * @returns The OpenGL pixel format.
+			 */
+			static GLenum getPixelFormat(int format);
+
+			/**
+			 * @brief Get the name of a format.
+			 *
+			 * Get the name of a format to show to the user.
+			 *
+			 * @param format The format.
+			 *
+			 * @returns The name.
+			 */
+			static const char* getName(int format);
+
+		private:
+
+			/**
+			 * @brief Encodes a block.
+			 *
+			 * Encodes a 4x4 block into a format.
+			 *
+			 * @param block The 16 pixels of the block, RGBA8, row after row.
+			 * @param format The format.
+			 * @param out Output for the encoded block.
+			 */
+			static void encodeBlock(const unsigned char* block, int format, unsigned char* out);
+
+			/**
+			 * @brief Encodes a BC1 block.
+			 *
+			 * Fits the colors to a line along their main axis, and picks the
+			 * closest of the 4 colors on it for every pixel.
+			 *
+			 * @param block The 16 pixels of the block, RGBA8.
+			 * @param out Output for the 8 bytes of the block.
+			 */
+			static void encodeBC1(const unsigned char* block, unsigned char* out);
+
+			/**
+			 * @brief Encodes a BC4 block.
+			 *
+			 * Spans the 8 values between the smallest and the largest, and picks
+			 * the closest of them for every pixel.
+			 *
+			 * @param block The 16 pixels of the block, RGBA8.
+			 * @param channel The channel to encode.
+			 * @param out Output for the 8 bytes of the block.
+			 */
+			static void encodeBC4(const unsigned char* block, int channel, unsigned char* out);
+
+			/**
+			 * @brief Encodes a BC7 block.
+			 *
+			 * Encodes the block in mode 6: one line through RGBA with 16 steps,
+			 * trying every combination of the low bits of the endpoints.
+			 *
+			 * @param block The 16 pixels of the block, RGBA8.
+			 * @param out Output for the 16 bytes of the block.
+			 */
+			static void encodeBC7(const unsigned char* block, unsigned char* out);
+
+			/**
+			 * @brief Finds the main axis of some colors.
+			 *
+			 * Finds the mean of the colors and the direction they spread along the
+			 * most, and where they start and end along it.
+			 *
+			 * @param block The 16 pixels of the block, RGBA8.
+			 * @param channels The number of channels to look at, 3 or 4.
+			 * @param start Output for the first end of the line.
+			 * @param end Output for the other end of the line.
+			 */
+			static void fitLine(const unsigned char* block, int channels, float* start, float* end);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_BLOCK_COMPRESSOR_H_
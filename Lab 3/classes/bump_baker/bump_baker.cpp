@@ -0,0 +1,307 @@
+/**
+ * @file bump_baker.cpp
+ * @brief BumpBaker class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "bump_baker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stb/stb_image.h"
+
+#include "classes/job_runner/job_runner.h"
+#include "classes/mip_chain/mip_chain.h"
+#include "structs/lanes/lanes.h"
+
+namespace bgq_opengl {
+
+	void BumpBaker::convert(const float* heights, int width, int height, int kernel, int output, float strength, unsigned char* out, bool vectorized, int threads) {
+
+		int tiles = (height + BUMP_BAKER_TILE - 1) / BUMP_BAKER_TILE;
+
+		JobRunner::run(tiles, threads, [&](int tile) {
+
+			// A few rows of floats, cheap next to the tile.
+			std::vector<float> scratch((size_t) width * 6 + 6);
+
+			int first = tile * BUMP_BAKER_TILE;
+			BumpBaker::convertRows(heights, width, height, kernel, output, strength, first, std::min(first + BUMP_BAKER_TILE, height), vectorized, scratch.data(), out);
+
+		});
+
+	}
+
+	void BumpBaker::bake(const std::vector<std::string> &images, int kernel, int output, int format, const std::string &path) {
+
+		int width = 0, height = 0;
+		int layers = (int) images.size();
+		std::vector<unsigned char> pixels;
+		std::vector<float> heights;
+
+		for (int layer = 0; layer < layers; layer++) {
+
+			int image_width, image_height;
+			BumpBaker::load(images[layer], &heights, &image_width, &image_height);
+
+			if (layer == 0) {
+
+				width = image_width;
+				height = image_height;
+				pixels.resize((size_t) width * height * 4 * layers);
+
+			} else if (image_width != width || image_height != height) {
+
+				std::cerr << "BumpBaker error - " << images[layer] << " is " << image_width << "x" << image_height << " but the others are " << width << "x" << height << "." << std::endl;
+				exit(1);
+
+			}
+
+			BumpBaker::convert(heights.data(), width, height, kernel, output, 1.0f, pixels.data() + (size_t) width * height * 4 * layer);
+
+		}
+
+		MipChain::bake(std::move(pixels), width, height, layers, format, path);
+
+	}
+
+	std::string BumpBaker::makeFilename(const std::vector<std::string> &images, int kernel, int output, int format) {
+
+		std::string tag = std::string(BumpBaker::getKernelName(kernel)) + (output == BUMP_OUTPUT_NORMAL ? "_normal" : "_derivative");
+		std::transform(tag.begin(), tag.end(), tag.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+
+		return MipChain::makeFilename(images, format, tag);
+
+	}
+
+	void BumpBaker::benchmark(std::ostream &out) {
+
+		int sizes[2] = { 4096, 8192 };
+		int cores = JobRunner::getThreads(0);
+
+		out << "BumpBaker benchmark, " << LANES_NAME << " with " << LANES_WIDTH << " lanes, " << cores << " threads:" << std::endl;
+
+		for (int size : sizes) {
+
+			// Rolling hills with some finer ripples on top, so no two rows are alike.
+			std::vector<float> heights((size_t) size * size);
+			std::vector<unsigned char> pixels((size_t) size * size * 4);
+
+			for (int y = 0; y < size; y++)
+				for (int x = 0; x < size; x++)
+					heights[(size_t) y * size + x] = 0.5f + 0.25f * std::sin(x * 0.01f) * std::cos(y * 0.013f) + 0.1f * std::sin((x + y) * 0.2f);
+
+			for (int kernel = 0; kernel < BUMP_KERNELS; kernel++) {
+
+				double times[3];
+
+				for (int run = 0; run < 3; run++) {
+
+					auto start = std::chrono::steady_clock::now();
+					BumpBaker::convert(heights.data(), size, size, kernel, BUMP_OUTPUT_DERIVATIVE, 1.0f, pixels.data(), run > 0, run == 2 ? cores : 1);
+					times[run] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				}
+
+				double megapixels = (double) size * size / 1e6;
+
+				out << "    " << size << "x" << size << " " << std::left << std::setw(8) << BumpBaker::getKernelName(kernel) << std::right << std::fixed << std::setprecision(1)
+					<< " scalar " << times[0] << " ms, vector " << times[1] << " ms, threaded " << times[2] << " ms ("
+					<< megapixels / (times[2] / 1000.0) << " Mpixel/s)" << std::endl;
+
+			}
+
+		}
+
+	}
+
+	const char* BumpBaker::getKernelName(int kernel) {
+
+		switch (kernel) {
+
+			case BUMP_KERNEL_CENTRAL: return "Central";
+			case BUMP_KERNEL_SOBEL: return "Sobel";
+			case BUMP_KERNEL_SCHARR: return "Scharr";
+			default: return "Unknown";
+
+		}
+
+	}
+
+	void BumpBaker::convertRows(const float* heights, int width, int height, int kernel, int output, float strength, int first, int last, bool vectorized, float* scratch, unsigned char* out) {
+
+		// Weights of the side rows and of the middle one, scaled so a ramp that
+		// rises by 1 per texel has a slope of 1.
+		float side = kernel == BUMP_KERNEL_SOBEL ? 1.0f / 8.0f : kernel == BUMP_KERNEL_SCHARR ? 3.0f / 32.0f : 0.0f;
+		float middle = kernel == BUMP_KERNEL_SOBEL ? 2.0f / 8.0f : kernel == BUMP_KERNEL_SCHARR ? 10.0f / 32.0f : 0.5f;
+
+		// The rows above, at and below, with the first and last texels repeated on the other end.
+		int padded = width + 2;
+		float* rows[3] = { scratch, scratch + padded, scratch + padded * 2 };
+		float* channels[3] = { scratch + padded * 3, scratch + padded * 3 + width, scratch + padded * 3 + width * 2 };
+
+		for (int y = first; y < last; y++) {
+
+			for (int i = 0; i < 3; i++) {
+
+				const float* source = heights + (size_t) ((y + i - 1 + height) % height) * width;
+				memcpy(rows[i] + 1, source, (size_t) width * sizeof(float));
+				rows[i][0] = source[width - 1];
+				rows[i][width + 1] = source[0];
+
+			}
+
+			// Texel x sits at x + 1 in the padded rows, so x is its left and x + 2 its right.
+			int x = 0;
+
+			if (vectorized) {
+
+				Lanes side_weight = Lanes::fill(side);
+				Lanes middle_weight = Lanes::fill(middle);
+				Lanes scale = Lanes::fill(strength);
+				Lanes half = Lanes::fill(127.5f);
+				Lanes one = Lanes::fill(1.0f);
+
+				for (; x + LANES_WIDTH <= width; x += LANES_WIDTH) {
+
+					Lanes above_left = Lanes::load(rows[0] + x), above = Lanes::load(rows[0] + x + 1), above_right = Lanes::load(rows[0] + x + 2);
+					Lanes left = Lanes::load(rows[1] + x), right = Lanes::load(rows[1] + x + 2);
+					Lanes below_left = Lanes::load(rows[2] + x), below = Lanes::load(rows[2] + x + 1), below_right = Lanes::load(rows[2] + x + 2);
+
+					Lanes dx = (side_weight * ((above_right - above_left) + (below_right - below_left)) + middle_weight * (right - left)) * scale;
+					Lanes dy = (side_weight * ((below_left - above_left) + (below_right - above_right)) + middle_weight * (below - above)) * scale;
+
+					if (output == BUMP_OUTPUT_NORMAL) {
+
+						// The same normal the shaders get from the differences two texels apart.
+						Lanes nx = Lanes::fill(-2.0f) * dx;
+						Lanes ny = Lanes::fill(-2.0f) * dy;
+						Lanes length = Lanes::sqrt(nx * nx + ny * ny + one);
+
+						(nx / length * half + half).store(channels[0] + x);
+						(ny / length * half + half).store(channels[1] + x);
+						(one / length * half + half).store(channels[2] + x);
+
+					} else {
+
+						Lanes range = Lanes::fill(1.0f / (float) BUMP_DERIVATIVE_RANGE);
+						Lanes ex = Lanes::copySign(Lanes::sqrt(Lanes::min(Lanes::abs(dx) * range, one)), dx);
+						Lanes ey = Lanes::copySign(Lanes::sqrt(Lanes::min(Lanes::abs(dy) * range, one)), dy);
+
+						(ex * half + half).store(channels[0] + x);
+						(ey * half + half).store(channels[1] + x);
+						Lanes::fill(0.0f).store(channels[2] + x);
+
+					}
+
+				}
+
+			}
+
+			// Whatever does not fill the lanes, or everything without them.
+			for (; x < width; x++) {
+
+				float dx = (side * ((rows[0][x + 2] - rows[0][x]) + (rows[2][x + 2] - rows[2][x])) + middle * (rows[1][x + 2] - rows[1][x])) * strength;
+				float dy = (side * ((rows[2][x] - rows[0][x]) + (rows[2][x + 2] - rows[0][x + 2])) + middle * (rows[2][x + 1] - rows[0][x + 1])) * strength;
+
+				if (output == BUMP_OUTPUT_NORMAL) {
+
+					float nx = -2.0f * dx;
+					float ny = -2.0f * dy;
+					float length = std::sqrt(nx * nx + ny * ny + 1.0f);
+
+					channels[0][x] = nx / length * 127.5f + 127.5f;
+					channels[1][x] = ny / length * 127.5f + 127.5f;
+					channels[2][x] = 1.0f / length * 127.5f + 127.5f;
+
+				} else {
+
+					float ex = std::copysign(std::sqrt(std::min(std::fabs(dx) / (float) BUMP_DERIVATIVE_RANGE, 1.0f)), dx);
+					float ey = std::copysign(std::sqrt(std::min(std::fabs(dy) / (float) BUMP_DERIVATIVE_RANGE, 1.0f)), dy);
+
+					channels[0][x] = ex * 127.5f + 127.5f;
+					channels[1][x] = ey * 127.5f + 127.5f;
+					channels[2][x] = 0.0f;
+
+				}
+
+			}
+
+			// Round and interleave.
+			unsigned char* row = out + (size_t) y * width * 4;
+
+			for (x = 0; x < width; x++) {
+
+				row[x * 4 + 0] = (unsigned char) (channels[0][x] + 0.5f);
+				row[x * 4 + 1] = (unsigned char) (channels[1][x] + 0.5f);
+				row[x * 4 + 2] = (unsigned char) (channels[2][x] + 0.5f);
+				row[x * 4 + 3] = 255;
+
+			}
+
+		}
+
+	}
+
+	void BumpBaker::load(const std::string &image, std::vector<float>* heights, int* width, int* height) {
+
+		// Same as the textures, flip them so they are not upside down.
+		stbi_set_flip_vertically_on_load(true);
+
+		int channels;
+
+		if (stbi_is_16_bit(image.c_str())) {
+
+			unsigned short* image_bytes = stbi_load_16(image.c_str(), width, height, &channels, 1);
+
+			if (image_bytes != nullptr) {
+
+				heights->resize((size_t) *width * *height);
+				for (size_t i = 0; i < heights->size(); i++)
+					(*heights)[i] = image_bytes[i] / 65535.0f;
+
+				stbi_image_free(image_bytes);
+				return;
+
+			}
+
+		} else {
+
+			unsigned char* image_bytes = stbi_load(image.c_str(), width, height, &channels, 1);
+
+			if (image_bytes != nullptr) {
+
+				heights->resize((size_t) *width * *height);
+				for (size_t i = 0; i < heights->size(); i++)
+					(*heights)[i] = image_bytes[i] / 255.0f;
+
+				stbi_image_free(image_bytes);
+				return;
+
+			}
+
+		}
+
+		std::cerr << "BumpBaker error - Could not load " << image << ": " << stbi_failure_reason() << std::endl;
+		exit(1);
+
+	}
+
+}  // namespace bgq_opengl
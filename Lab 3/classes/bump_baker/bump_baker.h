@@ -0,0 +1,164 @@
+/**
+ * @file bump_baker.h
+ * @brief BumpBaker class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BUMP_BAKER_H_
+#define BGQ_OPENGL_CLASSES_BUMP_BAKER_H_
+
+#define BUMP_KERNEL_CENTRAL 0		/// Difference of the texels on either side.
+#define BUMP_KERNEL_SOBEL 1			/// 3x3 Sobel, smooths across the gradient with 1 2 1.
+#define BUMP_KERNEL_SCHARR 2		/// 3x3 Scharr, smooths with 3 10 3 and is closer to rotation invariant.
+#define BUMP_KERNELS 3				/// Number of kernels.
+
+#define BUMP_OUTPUT_DERIVATIVE 0	/// Slopes in red and green.
+#define BUMP_OUTPUT_NORMAL 1		/// Tangent space normal in red, green and blue.
+
+#define BUMP_DERIVATIVE_RANGE 0.5	/// Largest slope stored, in height per texel. Heights go from 0 to 1.
+#define BUMP_BAKER_TILE 32			/// Rows every thread takes at a time.
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a BumpBaker class.
+	 *
+	 * Turns height maps into derivative maps or tangent space normal maps, so
+	 * the shaders get the slope of a bump map with a single fetch instead of
+	 * finite differences of four.
+	 *
+	 * The slopes come from a 3x3 kernel that wraps around the edges. Every row
+	 * is computed with as many texels at once as the vector instructions of
+	 * the target allow, and the rows are handed out in tiles to every core.
+	 *
+	 * Derivative maps store the square root of the slope with its sign, so
+	 * the gentle slopes most bump maps are made of keep their precision in
+	 * 8 bits. The shaders square it back.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class BumpBaker {
+
+		public:
+
+			/**
+			 * @brief Converts a height map.
+			 *
+			 * Computes the slope of every texel of a height map and stores it as
+			 * a derivative or a normal.
+			 *
+			 * @param heights The heights, from 0 to 1, row after row.
+			 * @param width The width of the height map.
+			 * @param height The height of the height map.
+			 * @param kernel The kernel, one of the BUMP_KERNEL_ values.
+			 * @param output What to store, one of the BUMP_OUTPUT_ values.
+			 * @param strength How much the slopes are scaled.
+			 * @param out Output for the texels, RGBA8.
+			 * @param vectorized Whether to use the vector instructions.
+			 * @param threads Number of threads, or 0 for one per core.
+			 */
+			static void convert(const float* heights, int width, int height, int kernel, int output, float strength, unsigned char* out, bool vectorized = true, int threads = 0);
+
+			/**
+			 * @brief Bakes the mip chain of some height maps.
+			 *
+			 * Converts every height map and bakes the result into a mip chain,
+			 * one layer per height map.
+			 *
+			 * @param images The height maps, all the same size.
+			 * @param kernel The kernel, one of the BUMP_KERNEL_ values.
+			 * @param output What to store, one of the BUMP_OUTPUT_ values.
+			 * @param format The format of the chain, one of the TEXTURE_FORMAT_ values.
+			 * @param path Where to write the chain.
+			 */
+			static void bake(const std::vector<std::string> &images, int kernel, int output, int format, const std::string &path);
+
+			/**
+			 * @brief Makes the filename of a baked chain.
+			 *
+			 * Makes the filename of the chain of some height maps, which tells
+			 * apart every kernel, output and format.
+			 *
+			 * @param images The height maps.
+			 * @param kernel The kernel.
+			 * @param output The output.
+			 * @param format The format.
+			 *
+			 * @returns The filename, without a directory.
+			 */
+			static std::string makeFilename(const std::vector<std::string> &images, int kernel, int output, int format);
+
+			/**
+			 * @brief Measures the baker.
+			 *
+			 * Converts generated 4K and 8K height maps with every kernel, without
+			 * and with the vector instructions and the threads, and prints the
+			 * times.
+			 *
+			 * @param out The stream to print to.
+			 */
+			static void benchmark(std::ostream &out);
+
+			/**
+			 * @brief Get the name of a kernel.
+			 *
+			 * Get the name of a kernel to show to the user.
+			 *
+			 * @param kernel The kernel.
+			 *
+			 * @returns The name.
+			 */
+			static const char* getKernelName(int kernel);
+
+		private:
+
+			/**
+			 * @brief Converts some rows.
+			 *
+			 * Converts a range of rows of a height map.
+			 *
+			 * @param heights The heights.
+			 * @param width The width of the height map.
+			 * @param height The height of the height map.
+			 * @param kernel The kernel.
+			 * @param output The output.
+			 * @param strength How much the slopes are scaled.
+			 * @param first The first row.
+			 * @param last One past the last row.
+			 * @param vectorized Whether to use the vector instructions.
+			 * @param scratch Working memory, 6 floats per texel of a row plus 6.
+			 * @param out Output for the texels of the whole map.
+			 */
+			static void convertRows(const float* heights, int width, int height, int kernel, int output, float strength, int first, int last, bool vectorized, float* scratch, unsigned char* out);
+
+			/**
+			 * @brief Loads a height map.
+			 *
+			 * Loads the first channel of an image as heights from 0 to 1, with
+			 * all 16 bits if it has them.
+			 *
+			 * @param image The image.
+			 * @param heights Output for the heights.
+			 * @param width Output for the width.
+			 * @param height Output for the height.
+			 */
+			static void load(const std::string &image, std::vector<float>* heights, int* width, int* height);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_BUMP_BAKER_H_
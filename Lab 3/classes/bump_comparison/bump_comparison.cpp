@@ -0,0 +1,148 @@
+/**
+ * @file bump_comparison.cpp
+ * @brief BumpComparison class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "bump_comparison.h"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/mip_chain/mip_chain.h"
+#include "classes/render_target/render_target.h"
+
+namespace bgq_opengl {
+
+	BumpComparison::BumpComparison() {
+
+	}
+
+	BumpComparison::BumpComparison(int width, int height) {
+
+		this->target = RenderTarget(width, height);
+		this->reference_target = RenderTarget(width * 2, height * 2);
+
+	}
+
+	double BumpComparison::measure(const std::function<void()> &draw, int passes, std::vector<unsigned char>* pixels) {
+
+		// The first pass also gets the textures resident before timing.
+		this->drawInto(this->target, draw, pixels);
+
+		GLint previous_framebuffer = 0;
+		GLint previous_viewport[4];
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+		glGetIntegerv(GL_VIEWPORT, previous_viewport);
+
+		this->target.bind();
+
+		GLuint query;
+		glGenQueries(1, &query);
+		glBeginQuery(GL_TIME_ELAPSED, query);
+
+		for (int i = 0; i < passes; i++) {
+
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			draw();
+
+		}
+
+		glEndQuery(GL_TIME_ELAPSED);
+
+		// Waits for the GPU.
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		glDeleteQueries(1, &query);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+		glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]);
+
+		return elapsed / 1000000.0 / passes;
+
+	}
+
+	void BumpComparison::capture(const std::function<void()> &draw, std::vector<unsigned char>* pixels) {
+
+		this->drawInto(this->target, draw, pixels);
+
+	}
+
+	void BumpComparison::reference(const std::function<void()> &draw, std::vector<unsigned char>* pixels) {
+
+		std::vector<unsigned char> large;
+		this->drawInto(this->reference_target, draw, &large);
+
+		pixels->resize((size_t) this->target.getWidth() * this->target.getHeight() * 4);
+		MipChain::downsample(large.data(), this->reference_target.getWidth(), this->reference_target.getHeight(), pixels->data());
+
+	}
+
+	double BumpComparison::computePSNR(const std::vector<unsigned char> &image, const std::vector<unsigned char> &reference) {
+
+		double error = 0.0;
+		size_t samples = 0;
+
+		// Alpha is left out, it is the same everywhere.
+		for (size_t i = 0; i < image.size() && i < reference.size(); i++) {
+
+			if (i % 4 == 3)
+				continue;
+
+			double difference = (double) image[i] - reference[i];
+			error += difference * difference;
+			samples++;
+
+		}
+
+		if (error == 0.0)
+			return std::numeric_limits<double>::infinity();
+
+		return 10.0 * std::log10(255.0 * 255.0 / (error / samples));
+
+	}
+
+	void BumpComparison::remove() {
+
+		this->target.remove();
+		this->reference_target.remove();
+
+	}
+
+	void BumpComparison::drawInto(RenderTarget &target, const std::function<void()> &draw, std::vector<unsigned char>* pixels) {
+
+		// Keep the state that will be changed.
+		GLint previous_framebuffer = 0;
+		GLint previous_viewport[4];
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+		glGetIntegerv(GL_VIEWPORT, previous_viewport);
+
+		target.bind();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		draw();
+
+		// Rows of RGBA8 are always aligned, so nothing needs changing to read them.
+		pixels->resize((size_t) target.getWidth() * target.getHeight() * 4);
+		glReadPixels(0, 0, target.getWidth(), target.getHeight(), GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
+
+		glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+		glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]);
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,139 @@
+/**
+ * @file bump_comparison.h
+ * @brief BumpComparison class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BUMP_COMPARISON_H_
+#define BGQ_OPENGL_CLASSES_BUMP_COMPARISON_H_
+
+#include <functional>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/render_target/render_target.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a BumpComparison class.
+	 *
+	 * Draws the scene offscreen with each way of bump mapping, timing it with
+	 * GL_TIME_ELAPSED queries and reading the image back, so the methods can
+	 * be compared both in speed and in how far they are from a reference.
+	 *
+	 * The reference is the same scene drawn at twice the size and filtered
+	 * down, which averages four samples per pixel.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class BumpComparison {
+
+		public:
+
+			/**
+			 * @brief Construct the comparison.
+			 *
+			 * Construct an empty comparison.
+			 */
+			BumpComparison();
+
+			/**
+			 * @brief Construct the comparison.
+			 *
+			 * Construct the comparison with offscreen targets of the given size,
+			 * and twice as large for the reference.
+			 *
+			 * @param width Width of the target in pixels.
+			 * @param height Height of the target in pixels.
+			 */
+			BumpComparison(int width, int height);
+
+			/**
+			 * @brief Measure a method.
+			 *
+			 * Draws the scene once and reads it back, then draws it a number of
+			 * times and measures them. Restores the framebuffer and viewport
+			 * afterwards.
+			 *
+			 * @param draw Draws the scene with the method.
+			 * @param passes The number of times the scene is drawn.
+			 * @param pixels Output for the image, RGBA8.
+			 *
+			 * @returns The average GPU time of a pass in milliseconds.
+			 */
+			double measure(const std::function<void()> &draw, int passes, std::vector<unsigned char>* pixels);
+
+			/**
+			 * @brief Captures the scene.
+			 *
+			 * Draws the scene once into the target and reads it back, without
+			 * timing it.
+			 *
+			 * @param draw Draws the scene.
+			 * @param pixels Output for the image, RGBA8.
+			 */
+			void capture(const std::function<void()> &draw, std::vector<unsigned char>* pixels);
+
+			/**
+			 * @brief Draws the reference.
+			 *
+			 * Draws the scene at twice the size and filters it down to the size
+			 * of the target.
+			 *
+			 * @param draw Draws the scene with the reference method.
+			 * @param pixels Output for the image, RGBA8.
+			 */
+			void reference(const std::function<void()> &draw, std::vector<unsigned char>* pixels);
+
+			/**
+			 * @brief Computes the PSNR.
+			 *
+			 * Computes the peak signal to noise ratio of an image against another,
+			 * over the color channels.
+			 *
+			 * @param image The image.
+			 * @param reference The reference image.
+			 *
+			 * @returns The PSNR in dB, or infinity if they are the same.
+			 */
+			static double computePSNR(const std::vector<unsigned char> &image, const std::vector<unsigned char> &reference);
+
+			/**
+			 * @brief Removes the comparison from OpenGL.
+			 *
+			 * Removes the targets from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			/**
+			 * @brief Draws into a target.
+			 *
+			 * Clears a target, draws the scene into it and reads it back.
+			 *
+			 * @param target The target.
+			 * @param draw Draws the scene.
+			 * @param pixels Output for the image, RGBA8.
+			 */
+			void drawInto(RenderTarget &target, const std::function<void()> &draw, std::vector<unsigned char>* pixels);
+
+			RenderTarget target;			/// Offscreen target.
+			RenderTarget reference_target;	/// Offscreen target twice as large.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_BUMP_COMPARISON_H_
@@ -40,59 +40,74 @@ namespace bgq_opengl {
 	
 	}
 
-	glm::mat4 Camera::getCameraMatrix() {
+	const glm::mat4& Camera::getCameraMatrix() const {
 
-        return this->getProjection() * this->getView();
+        this->updateCache();
+
+        return this->view_projection;
 
 	}
 
-	glm::vec3 Camera::getDirection() {
+	glm::vec3 Camera::getDirection() const {
 
         return glm::normalize(glm::vec3(transforms * glm::vec4(this->direction, 1.0)));
 
 	}
 
-	glm::vec3 Camera::getPosition() {
+	glm::vec3 Camera::getPosition() const {
 
         return glm::vec3(transforms * glm::vec4(this->position, 1.0));
 
 	}
 
-	glm::mat4 Camera::getProjection() {
+	const glm::mat4& Camera::getProjection() const {
         
-        // Adds perspective to the scene.
-        float ratio = (float)this->window_width / this->window_height;
-        return glm::perspective(glm::radians(this->fov), ratio, this->near, this->far);
+        this->updateCache();
+
+        return this->projection;
 
 	}
 
-	glm::vec3 Camera::getUp() {
+	glm::vec3 Camera::getUp() const {
 
 		return glm::normalize(glm::vec3(transforms * glm::vec4(this->up, 1.0)));
 
 	}
 
-	glm::mat4 Camera::getView() {
+	const glm::mat4& Camera::getView() const {
         
-        // Get the position and direction.
-        glm::vec3 position = this->getPosition();
-        glm::vec3 direction = this->getDirection();
-        glm::vec3 up = this->getUp();
-        
-        // Calculate the view matrix.
-        return glm::lookAt(position, position + direction, up);
+        this->updateCache();
+
+        return this->view;
+
+	}
+
+	const glm::vec4* Camera::getFrustumPlanes() const {
+
+        this->updateCache();
+
+        return this->frustum;
 
 	}
 
     void Camera::setWidth(int new_width) {
         
+        // The window size is set every frame, so only invalidate when it actually changed.
+        if (this->window_width == new_width)
+            return;
+
         this->window_width = new_width;
+        this->projection_dirty = true;
         
     }
 
     void Camera::setHeight(int new_height) {
         
+        if (this->window_height == new_height)
+            return;
+
         this->window_height = new_height;
+        this->projection_dirty = true;
         
     }
 
@@ -190,6 +205,7 @@ namespace bgq_opengl {
     void Camera::resetTransforms() {
 
         this->transforms = glm::mat4(1.0f);
+        this->view_dirty = true;
 
     }
 
@@ -203,6 +219,7 @@ namespace bgq_opengl {
         glm::mat4 rotation_matrix = glm::rotate(identity_matrix, radians, glm::vec3(x, y, z));
 
         this->transforms = rotation_matrix * this->transforms;
+        this->view_dirty = true;
 
     }
 
@@ -213,10 +230,11 @@ namespace bgq_opengl {
 
         // Apply it to the transormations.
         this->transforms = trans_matrix * this->transforms;
+        this->view_dirty = true;
 
     }
 
-    glm::mat4 Camera::getTransformMat() {
+    glm::mat4 Camera::getTransformMat() const {
         
         return this->transforms;
         
@@ -225,7 +243,58 @@ namespace bgq_opengl {
     void Camera::setTransformMat(glm::mat4 transform) {
         
         this->transforms = transform;
+        this->view_dirty = true;
         
     }
 
+    void Camera::updateCache() const {
+
+        if (!this->view_dirty && !this->projection_dirty)
+            return;
+
+        if (this->view_dirty) {
+
+            // Get the position and direction.
+            glm::vec3 position = this->getPosition();
+            glm::vec3 direction = this->getDirection();
+            glm::vec3 up = this->getUp();
+
+            // Calculate the view matrix.
+            this->view = glm::lookAt(position, position + direction, up);
+
+        }
+
+        if (this->projection_dirty) {
+
+            // Adds perspective to the scene.
+            float ratio = (float)this->window_width / this->window_height;
+            this->projection = glm::perspective(glm::radians(this->fov), ratio, this->near, this->far);
+
+        }
+
+        this->view_projection = this->projection * this->view;
+
+        // Extract the frustum planes from the rows of the camera matrix (Gribb & Hartmann).
+        const glm::mat4 &m = this->view_projection;
+        glm::vec4 row_x(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row_y(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row_z(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row_w(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        this->frustum[0] = row_w + row_x;
+        this->frustum[1] = row_w - row_x;
+        this->frustum[2] = row_w + row_y;
+        this->frustum[3] = row_w - row_y;
+        this->frustum[4] = row_w + row_z;
+        this->frustum[5] = row_w - row_z;
+
+        // Normalize them so the distances are in world units.
+        for (int i = 0; i < 6; i++)
+            this->frustum[i] = this->frustum[i] / glm::length(glm::vec3(this->frustum[i]));
+
+        this->view_dirty = false;
+        this->projection_dirty = false;
+
+    }
+
 }  // namespace bgq_opengl
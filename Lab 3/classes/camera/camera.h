@@ -50,44 +50,54 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the camera matrix.
 			 *
-			 * Get the camera matrix.
+			 * Get the camera matrix (projection times view).
 			 */
-			glm::mat4 getCameraMatrix();
+			const glm::mat4& getCameraMatrix() const;
 
 			/**
 			 * @brief Get the camera direction.
 			 * 
 			 * Get the camera direction.
 			 */
-			glm::vec3 getDirection();
+			glm::vec3 getDirection() const;
 
 			/**
 			 * @brief Get the camera position.
 			 *
 			 * Get the camera position.
 			 */
-			glm::vec3 getPosition();
+			glm::vec3 getPosition() const;
 
 			/**
 			 * @brief Get the projection matrix.
 			 * 
 			 * Get the projection matrix corresponding to this camera.
 			 */
-			glm::mat4 getProjection();
+			const glm::mat4& getProjection() const;
 
 			/**
 			 * @brief Get the camera up vector.
 			 *
 			 * Get the camera up vector.
 			 */
-			glm::vec3 getUp();
+			glm::vec3 getUp() const;
 
 			/**
 			 * @brief Get the view matrix.
 			 * 
 			 * Get the view matrix corresponding to this camera.
 			 */
-			glm::mat4 getView();
+			const glm::mat4& getView() const;
+
+			/**
+			 * @brief Get the frustum planes.
+			 *
+			 * Get the left, right, bottom, top, near and far planes of the view frustum
+			 * in world space, as (normal, distance) with the normal pointing inwards.
+			 *
+			 * @returns A pointer to the six planes.
+			 */
+			const glm::vec4* getFrustumPlanes() const;
         
             /**
              * @brief Set the width of the camera.
@@ -210,7 +220,7 @@ namespace bgq_opengl {
              *
              * @returns The transform matrix.
              */
-            glm::mat4 getTransformMat();
+            glm::mat4 getTransformMat() const;
         
             /**
              * @brief Set the transform matrix.
@@ -223,6 +233,13 @@ namespace bgq_opengl {
 
 		private:
 
+			/**
+			 * @brief Recomputes the cached matrices.
+			 *
+			 * Recomputes the cached matrices and frustum planes that were invalidated.
+			 */
+			void updateCache() const;
+
 			glm::vec3 direction;		/// Vector indicating where the camera is looking.
 			float far;					/// Maximum clipping limit.
 			float fov;					/// Field of view;
@@ -233,6 +250,13 @@ namespace bgq_opengl {
 			int window_width;			/// Width of the GLUT window.
             glm::mat4 transforms = glm::mat4(1.0f); /// Tranform matrixes that will be passed to the shader.
 
+			mutable glm::mat4 view;					/// Cached view matrix.
+			mutable glm::mat4 projection;			/// Cached projection matrix.
+			mutable glm::mat4 view_projection;		/// Cached projection times view.
+			mutable glm::vec4 frustum[6];			/// Cached frustum planes.
+			mutable bool view_dirty = true;			/// Whether the view changed since it was cached.
+			mutable bool projection_dirty = true;	/// Whether the projection changed since it was cached.
+
 			const float speed = 0.25f;				/// Speed of the camera movement.
 			const float horizontal_rotation = 3.0f;	/// How much it rotates for every step.
 			const float vertical_rotation = 0.1f;	/// How much it rotates for every step.
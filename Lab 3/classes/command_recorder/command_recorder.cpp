@@ -0,0 +1,466 @@
+/**
+ * @file command_recorder.cpp
+ * @brief CommandRecorder class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "command_recorder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/recorded_uniform/recorded_uniform.h"
+
+namespace bgq_opengl {
+
+	CommandRecorder* CommandRecorder::active = nullptr;
+
+	CommandRecorder::CommandRecorder() {
+
+	}
+
+	void CommandRecorder::begin() {
+
+		this->commands.clear();
+		this->blocks.clear();
+		this->program_uniforms.clear();
+		this->uniform_values.clear();
+		this->textures.clear();
+		this->samplers.clear();
+		this->block_values.clear();
+		this->state.clear();
+		this->program = -1;
+		this->vertex_array = -1;
+		this->draws = 0;
+
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &this->alignment);
+
+		this->width = viewport[2];
+		this->height = viewport[3];
+
+		CommandRecorder::active = this;
+
+	}
+
+	bool CommandRecorder::end(const std::string &path) {
+
+		if (CommandRecorder::active == this)
+			CommandRecorder::active = nullptr;
+
+		// The first draw sets the state from scratch, so only the state after the last one is missing to loop.
+		this->recordState();
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		uint32_t header[2] = { COMMAND_FILE_MAGIC, COMMAND_FILE_VERSION };
+		int32_t sizes[3] = { this->width, this->height, (int32_t) this->draws };
+		uint64_t lengths[2] = { this->blocks.size(), this->commands.size() };
+
+		file.write((const char*) header, sizeof(header));
+		file.write((const char*) sizes, sizeof(sizes));
+		file.write((const char*) lengths, sizeof(lengths));
+		file.write((const char*) this->blocks.data(), this->blocks.size());
+		file.write((const char*) this->commands.data(), this->commands.size());
+
+		return (bool) file;
+
+	}
+
+	size_t CommandRecorder::getDraws() {
+
+		return this->draws;
+
+	}
+
+	size_t CommandRecorder::getSize() {
+
+		return this->commands.size() + this->blocks.size();
+
+	}
+
+	void CommandRecorder::drawElements(GLenum mode, GLsizei count, GLenum type, GLintptr offset) {
+
+		if (CommandRecorder::active != nullptr)
+			CommandRecorder::active->record(mode, count, type, offset);
+
+		glDrawElements(mode, count, type, (const void*) offset);
+
+	}
+
+	CommandRecorder* CommandRecorder::suspend() {
+
+		CommandRecorder* recorder = CommandRecorder::active;
+		CommandRecorder::active = nullptr;
+
+		return recorder;
+
+	}
+
+	void CommandRecorder::resume(CommandRecorder* recorder) {
+
+		CommandRecorder::active = recorder;
+
+	}
+
+	int CommandRecorder::getComponents(GLenum type, bool* integer) {
+
+		*integer = false;
+
+		switch (type) {
+
+			case GL_FLOAT:
+				return 1;
+			case GL_FLOAT_VEC2:
+				return 2;
+			case GL_FLOAT_VEC3:
+				return 3;
+			case GL_FLOAT_VEC4:
+			case GL_FLOAT_MAT2:
+				return 4;
+			case GL_FLOAT_MAT3:
+				return 9;
+			case GL_FLOAT_MAT4:
+				return 16;
+
+		}
+
+		*integer = true;
+
+		switch (type) {
+
+			case GL_INT:
+			case GL_UNSIGNED_INT:
+			case GL_BOOL:
+				return 1;
+			case GL_INT_VEC2:
+			case GL_UNSIGNED_INT_VEC2:
+			case GL_BOOL_VEC2:
+				return 2;
+			case GL_INT_VEC3:
+			case GL_UNSIGNED_INT_VEC3:
+			case GL_BOOL_VEC3:
+				return 3;
+			case GL_INT_VEC4:
+			case GL_UNSIGNED_INT_VEC4:
+			case GL_BOOL_VEC4:
+				return 4;
+
+		}
+
+		// Samplers hold the unit they read from.
+		GLenum binding;
+		if (CommandRecorder::getTarget(type, &binding) != 0)
+			return 1;
+
+		*integer = false;
+
+		return 0;
+
+	}
+
+	void CommandRecorder::record(GLenum mode, GLsizei count, GLenum type, GLintptr offset) {
+
+		GLint program = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+
+		if (program != this->program) {
+
+			this->put<uint8_t>(COMMAND_PROGRAM);
+			this->put<uint32_t>(program);
+			this->program = program;
+
+		}
+
+		this->recordState();
+
+		GLint vertex_array = 0;
+		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertex_array);
+
+		if (vertex_array != this->vertex_array) {
+
+			this->put<uint8_t>(COMMAND_VERTEX_ARRAY);
+			this->put<uint32_t>(vertex_array);
+			this->vertex_array = vertex_array;
+
+		}
+
+		if (program != 0) {
+
+			this->recordUniforms(program);
+			this->recordBlocks(program);
+
+		}
+
+		this->put<uint8_t>(COMMAND_DRAW);
+		this->put<uint32_t>(mode);
+		this->put<int32_t>(count);
+		this->put<uint32_t>(type);
+		this->put<uint64_t>(offset);
+
+		this->draws++;
+
+	}
+
+	void CommandRecorder::recordState() {
+
+		GLint depth_function = GL_LESS;
+		GLboolean depth_mask = GL_TRUE;
+		glGetIntegerv(GL_DEPTH_FUNC, &depth_function);
+		glGetBooleanv(GL_DEPTH_WRITEMASK, &depth_mask);
+
+		std::vector<uint32_t> state = {
+			glIsEnabled(GL_DEPTH_TEST),
+			(uint32_t) depth_function,
+			depth_mask,
+			glIsEnabled(GL_BLEND),
+			glIsEnabled(GL_CULL_FACE)
+		};
+
+		if (state == this->state)
+			return;
+
+		this->put<uint8_t>(COMMAND_STATE);
+		for (size_t i = 0; i < state.size(); i++)
+			this->put<uint32_t>(state[i]);
+
+		this->state = state;
+
+	}
+
+	void CommandRecorder::recordUniforms(GLuint program) {
+
+		// Which uniforms a program has never changes, so it is only asked once.
+		auto found = this->program_uniforms.find(program);
+
+		if (found == this->program_uniforms.end()) {
+
+			std::vector<RecordedUniform> uniforms;
+			GLint count = 0;
+			glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+
+			for (GLint i = 0; i < count; i++) {
+
+				char name[256];
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveUniform(program, i, sizeof(name), &length, &size, &type, name);
+
+				RecordedUniform uniform;
+				uniform.type = type;
+				uniform.components = CommandRecorder::getComponents(type, &uniform.integer);
+
+				// Doubles and images are not used by the engine, so a replay would miss them.
+				if (uniform.components == 0) {
+
+					std::cerr << "CommandRecorder warning - Uniform " << std::string(name, length) << " of type 0x" << std::hex << type << std::dec << " is not recorded." << std::endl;
+					continue;
+
+				}
+
+				// Arrays are listed once as name[0], every element has a location of its own.
+				std::string base(name, length);
+				if (base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+					base.resize(base.size() - 3);
+
+				for (GLint element = 0; element < size; element++) {
+
+					std::string element_name = size > 1 ? base + "[" + std::to_string(element) + "]" : base;
+					uniform.location = glGetUniformLocation(program, element_name.c_str());
+
+					// Members of uniform blocks have no location.
+					if (uniform.location >= 0)
+						uniforms.push_back(uniform);
+
+				}
+
+			}
+
+			found = this->program_uniforms.emplace(program, uniforms).first;
+
+		}
+
+		GLint active_texture = GL_TEXTURE0;
+		glGetIntegerv(GL_ACTIVE_TEXTURE, &active_texture);
+
+		for (const RecordedUniform &uniform : found->second) {
+
+			std::vector<unsigned char> value(uniform.components * 4);
+
+			bool unsigned_integer = uniform.type == GL_UNSIGNED_INT || uniform.type == GL_UNSIGNED_INT_VEC2 || uniform.type == GL_UNSIGNED_INT_VEC3 || uniform.type == GL_UNSIGNED_INT_VEC4;
+
+			if (unsigned_integer)
+				glGetUniformuiv(program, uniform.location, (GLuint*) value.data());
+			else if (uniform.integer)
+				glGetUniformiv(program, uniform.location, (GLint*) value.data());
+			else
+				glGetUniformfv(program, uniform.location, (GLfloat*) value.data());
+
+			std::vector<unsigned char> &last = this->uniform_values[std::make_pair(program, uniform.location)];
+
+			if (value != last) {
+
+				this->put<uint8_t>(COMMAND_UNIFORM);
+				this->put<int32_t>(uniform.location);
+				this->put<uint32_t>(uniform.type);
+				this->commands.insert(this->commands.end(), value.begin(), value.end());
+				last = value;
+
+			}
+
+			// A sampler also needs the texture and the sampler of its unit.
+			GLenum binding;
+			GLenum target = CommandRecorder::getTarget(uniform.type, &binding);
+
+			if (target == 0)
+				continue;
+
+			GLint unit = 0, texture = 0, sampler = 0;
+			memcpy(&unit, value.data(), sizeof(GLint));
+
+			glActiveTexture(GL_TEXTURE0 + unit);
+			glGetIntegerv(binding, &texture);
+			glGetIntegerv(GL_SAMPLER_BINDING, &sampler);
+
+			auto key = std::make_pair((GLuint) unit, target);
+			auto bound = this->textures.find(key);
+
+			if (bound == this->textures.end() || bound->second != (GLuint) texture) {
+
+				this->put<uint8_t>(COMMAND_TEXTURE);
+				this->put<uint32_t>(unit);
+				this->put<uint32_t>(target);
+				this->put<uint32_t>(texture);
+				this->textures[key] = texture;
+
+			}
+
+			auto sampled = this->samplers.find(unit);
+
+			if (sampled == this->samplers.end() || sampled->second != (GLuint) sampler) {
+
+				this->put<uint8_t>(COMMAND_SAMPLER);
+				this->put<uint32_t>(unit);
+				this->put<uint32_t>(sampler);
+				this->samplers[unit] = sampler;
+
+			}
+
+		}
+
+		glActiveTexture(active_texture);
+
+	}
+
+	void CommandRecorder::recordBlocks(GLuint program) {
+
+		GLint count = 0;
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+
+		for (GLint i = 0; i < count; i++) {
+
+			GLint binding = 0, buffer = 0;
+			glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+			glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, binding, &buffer);
+
+			if (buffer == 0)
+				continue;
+
+			GLint64 start = 0, size = 0;
+			glGetInteger64i_v(GL_UNIFORM_BUFFER_START, binding, &start);
+			glGetInteger64i_v(GL_UNIFORM_BUFFER_SIZE, binding, &size);
+
+			// Bound whole, the size is that of the buffer.
+			if (size == 0) {
+
+				GLint buffer_size = 0;
+				glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+				glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &buffer_size);
+				size = buffer_size - start;
+
+			}
+
+			std::vector<unsigned char> data((size_t) size);
+			glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+			glGetBufferSubData(GL_COPY_READ_BUFFER, start, size, data.data());
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+			// The same data is bound from where it was recorded before.
+			std::vector<unsigned char> &last = this->block_values[binding];
+			if (data == last)
+				continue;
+
+			uint32_t offset = (uint32_t) ((this->blocks.size() + this->alignment - 1) / this->alignment * this->alignment);
+			this->blocks.resize(offset);
+			this->blocks.insert(this->blocks.end(), data.begin(), data.end());
+
+			this->put<uint8_t>(COMMAND_BLOCK);
+			this->put<uint32_t>(binding);
+			this->put<uint32_t>(offset);
+			this->put<uint32_t>((uint32_t) size);
+
+			last = data;
+
+		}
+
+	}
+
+	GLenum CommandRecorder::getTarget(GLenum type, GLenum* binding) {
+
+		switch (type) {
+
+			case GL_SAMPLER_2D:
+			case GL_SAMPLER_2D_SHADOW:
+			case GL_INT_SAMPLER_2D:
+			case GL_UNSIGNED_INT_SAMPLER_2D:
+				*binding = GL_TEXTURE_BINDING_2D;
+				return GL_TEXTURE_2D;
+
+			case GL_SAMPLER_2D_ARRAY:
+			case GL_SAMPLER_2D_ARRAY_SHADOW:
+			case GL_INT_SAMPLER_2D_ARRAY:
+			case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+				*binding = GL_TEXTURE_BINDING_2D_ARRAY;
+				return GL_TEXTURE_2D_ARRAY;
+
+			case GL_SAMPLER_3D:
+			case GL_INT_SAMPLER_3D:
+			case GL_UNSIGNED_INT_SAMPLER_3D:
+				*binding = GL_TEXTURE_BINDING_3D;
+				return GL_TEXTURE_3D;
+
+			case GL_SAMPLER_CUBE:
+			case GL_INT_SAMPLER_CUBE:
+			case GL_UNSIGNED_INT_SAMPLER_CUBE:
+				*binding = GL_TEXTURE_BINDING_CUBE_MAP;
+				return GL_TEXTURE_CUBE_MAP;
+
+		}
+
+		*binding = 0;
+
+		return 0;
+
+	}
+
+}  // namespace bgq_opengl
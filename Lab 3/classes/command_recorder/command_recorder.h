@@ -0,0 +1,244 @@
+/**
+ * @file command_recorder.h
+ * @brief CommandRecorder class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_COMMAND_RECORDER_H_
+#define BGQ_OPENGL_CLASSES_COMMAND_RECORDER_H_
+
+#define COMMAND_FILE_MAGIC 0x43514742	/// "BGQC" read as a little endian integer.
+#define COMMAND_FILE_VERSION 1			/// Bumped whenever the layout changes.
+
+#define COMMAND_PROGRAM 0			/// Use a program.
+#define COMMAND_STATE 1				/// Set the depth, blending and culling state.
+#define COMMAND_VERTEX_ARRAY 2		/// Bind a vertex array.
+#define COMMAND_UNIFORM 3			/// Set a uniform of the current program.
+#define COMMAND_TEXTURE 4			/// Bind a texture to a unit.
+#define COMMAND_SAMPLER 5			/// Bind a sampler to a unit.
+#define COMMAND_BLOCK 6				/// Bind a range of the recorded uniform data to a block binding.
+#define COMMAND_DRAW 7				/// Draw indexed triangles.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/recorded_uniform/recorded_uniform.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a CommandRecorder class.
+	 *
+	 * Records the draws of a frame, with everything they use, into a compact
+	 * binary file that a CommandReplay can issue again. Every draw of the
+	 * engine goes through drawElements(), and while a recorder is active it
+	 * looks up the program, the uniforms, the textures, the samplers, the
+	 * uniform blocks and the fixed state the draw uses, and writes down only
+	 * what changed since the draw before.
+	 *
+	 * The data of the uniform blocks is copied into the file, since the stream
+	 * buffers it lives in are reused every frame. Programs, vertex arrays,
+	 * textures and samplers are kept as their OpenGL names, so a recording is
+	 * replayed in the same run that recorded it.
+	 *
+	 * Looking the state up stalls, so recording a frame is slow, but nothing is
+	 * looked up when no recorder is active.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class CommandRecorder {
+
+		public:
+
+			/**
+			 * @brief Construct the recorder.
+			 *
+			 * Construct a recorder that records nothing until begun.
+			 */
+			CommandRecorder();
+
+			/**
+			 * @brief Begins recording.
+			 *
+			 * Makes this the active recorder and forgets anything recorded
+			 * before. The size of the frame is taken from the viewport.
+			 */
+			void begin();
+
+			/**
+			 * @brief Ends recording.
+			 *
+			 * Records the state the frame leaves behind, so a replay can loop,
+			 * and writes the recording to a file.
+			 *
+			 * @param path The file.
+			 *
+			 * @returns True if the file was written.
+			 */
+			bool end(const std::string &path);
+
+			/**
+			 * @brief Get the number of draws.
+			 *
+			 * Get the number of draws recorded.
+			 *
+			 * @returns The number of draws.
+			 */
+			size_t getDraws();
+
+			/**
+			 * @brief Get the size.
+			 *
+			 * Get the size of the recording, commands and uniform data.
+			 *
+			 * @returns The size in bytes.
+			 */
+			size_t getSize();
+
+			/**
+			 * @brief Draws indexed triangles.
+			 *
+			 * Issues glDrawElements, recording it first if a recorder is active.
+			 *
+			 * @param mode The primitives.
+			 * @param count The number of indices.
+			 * @param type The type of the indices.
+			 * @param offset Offset of the first index in the element buffer.
+			 */
+			static void drawElements(GLenum mode, GLsizei count, GLenum type, GLintptr offset);
+
+			/**
+			 * @brief Suspends recording.
+			 *
+			 * Stops the active recorder from recording, for passes that draw into
+			 * targets a replay does not have.
+			 *
+			 * @returns The recorder that was active, if any, to resume later.
+			 */
+			static CommandRecorder* suspend();
+
+			/**
+			 * @brief Resumes recording.
+			 *
+			 * Makes a suspended recorder the active one again.
+			 *
+			 * @param recorder The recorder suspend() returned.
+			 */
+			static void resume(CommandRecorder* recorder);
+
+			/**
+			 * @brief Get the size of a uniform type.
+			 *
+			 * Get how many values a uniform of a type holds, and whether they are
+			 * integers, signed or not.
+			 *
+			 * @param type The type, like GL_FLOAT_VEC3.
+			 * @param integer Output for whether the values are integers.
+			 *
+			 * @returns The number of values, or 0 if the type is not supported.
+			 */
+			static int getComponents(GLenum type, bool* integer);
+
+		private:
+
+			/**
+			 * @brief Records a draw.
+			 *
+			 * Records whatever the draw uses that changed since the last one, and
+			 * the draw itself.
+			 *
+			 * @param mode The primitives.
+			 * @param count The number of indices.
+			 * @param type The type of the indices.
+			 * @param offset Offset of the first index in the element buffer.
+			 */
+			void record(GLenum mode, GLsizei count, GLenum type, GLintptr offset);
+
+			/**
+			 * @brief Records the fixed state.
+			 *
+			 * Records the depth, blending and culling state if it changed.
+			 */
+			void recordState();
+
+			/**
+			 * @brief Records the uniforms.
+			 *
+			 * Records the uniforms of a program that changed, and the textures and
+			 * samplers its sampler uniforms point at.
+			 *
+			 * @param program The program.
+			 */
+			void recordUniforms(GLuint program);
+
+			/**
+			 * @brief Records the uniform blocks.
+			 *
+			 * Copies the ranges bound to the uniform blocks of a program into the
+			 * recording, if their contents changed.
+			 *
+			 * @param program The program.
+			 */
+			void recordBlocks(GLuint program);
+
+			/**
+			 * @brief Get the texture target of a sampler type.
+			 *
+			 * Get the texture target a sampler uniform of a type samples, and the
+			 * query of what is bound to it.
+			 *
+			 * @param type The type, like GL_SAMPLER_2D.
+			 * @param binding Output for the query, like GL_TEXTURE_BINDING_2D.
+			 *
+			 * @returns The target, or 0 if the type is not a sampler.
+			 */
+			static GLenum getTarget(GLenum type, GLenum* binding);
+
+			/**
+			 * @brief Appends a value to the commands.
+			 *
+			 * @param value The value.
+			 */
+			template <typename T> void put(T value) {
+
+				const unsigned char* bytes = (const unsigned char*) &value;
+				this->commands.insert(this->commands.end(), bytes, bytes + sizeof(T));
+
+			}
+
+			static CommandRecorder* active;										/// Recorder the draws go to, if any.
+			std::vector<unsigned char> commands;								/// Recorded commands.
+			std::vector<unsigned char> blocks;									/// Recorded data of the uniform blocks.
+			std::map<GLuint, std::vector<RecordedUniform>> program_uniforms;	/// Uniforms of every program seen.
+			std::map<std::pair<GLuint, GLint>, std::vector<unsigned char>> uniform_values;	/// Last value of every uniform.
+			std::map<std::pair<GLuint, GLenum>, GLuint> textures;				/// Last texture of every unit and target.
+			std::map<GLuint, GLuint> samplers;									/// Last sampler of every unit.
+			std::map<GLuint, std::vector<unsigned char>> block_values;			/// Last data of every block binding.
+			std::vector<uint32_t> state;										/// Last fixed state.
+			GLint program = -1;													/// Last program.
+			GLint vertex_array = -1;											/// Last vertex array.
+			GLint alignment = 256;												/// Alignment of the uniform data.
+			int width = 0;														/// Width of the frame in pixels.
+			int height = 0;														/// Height of the frame in pixels.
+			size_t draws = 0;													/// Draws recorded.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_COMMAND_RECORDER_H_
@@ -0,0 +1,308 @@
+/**
+ * @file command_replay.cpp
+ * @brief CommandReplay class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "command_replay.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/command_recorder/command_recorder.h"
+
+namespace bgq_opengl {
+
+	CommandReplay::CommandReplay() {
+
+	}
+
+	CommandReplay::CommandReplay(const std::string &path) {
+
+		std::ifstream file(path, std::ios::binary);
+
+		uint32_t header[2] = { 0, 0 };
+		int32_t sizes[3] = { 0, 0, 0 };
+		uint64_t lengths[2] = { 0, 0 };
+		file.read((char*) header, sizeof(header));
+		file.read((char*) sizes, sizeof(sizes));
+		file.read((char*) lengths, sizeof(lengths));
+
+		if (!file || header[0] != COMMAND_FILE_MAGIC || header[1] != COMMAND_FILE_VERSION) {
+
+			std::cerr << "CommandReplay error - " << path << " is not a command recording." << std::endl;
+			exit(1);
+
+		}
+
+		this->width = sizes[0];
+		this->height = sizes[1];
+		this->draws = sizes[2];
+
+		std::vector<unsigned char> blocks(lengths[0]);
+		this->commands.resize(lengths[1]);
+		file.read((char*) blocks.data(), blocks.size());
+		file.read((char*) this->commands.data(), this->commands.size());
+
+		if (!file) {
+
+			std::cerr << "CommandReplay error - " << path << " is truncated." << std::endl;
+			exit(1);
+
+		}
+
+		if (!blocks.empty()) {
+
+			glGenBuffers(1, &this->buffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+			glBufferData(GL_UNIFORM_BUFFER, blocks.size(), blocks.data(), GL_STATIC_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		}
+
+		// Walk the commands once to count them, and to make sure they are whole.
+		size_t cursor = 0;
+		const size_t payloads[8] = { 4, 20, 4, 8, 12, 8, 12, 20 };
+
+		while (cursor < this->commands.size()) {
+
+			uint8_t command = this->get<uint8_t>(&cursor);
+
+			if (command > COMMAND_DRAW) {
+
+				std::cerr << "CommandReplay error - " << path << " has an unknown command." << std::endl;
+				exit(1);
+
+			}
+
+			size_t size = payloads[command];
+
+			// Uniforms are followed by their value, as long as their type says.
+			if (command == COMMAND_UNIFORM && cursor + size <= this->commands.size()) {
+
+				uint32_t type;
+				memcpy(&type, this->commands.data() + cursor + 4, sizeof(uint32_t));
+
+				bool integer;
+				size += CommandRecorder::getComponents(type, &integer) * 4;
+
+			}
+
+			cursor += size;
+			this->count++;
+
+		}
+
+		if (cursor != this->commands.size()) {
+
+			std::cerr << "CommandReplay error - " << path << " is truncated." << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	void CommandReplay::draw() {
+
+		size_t cursor = 0;
+
+		while (cursor < this->commands.size()) {
+
+			switch (this->get<uint8_t>(&cursor)) {
+
+				case COMMAND_PROGRAM:
+					glUseProgram(this->get<uint32_t>(&cursor));
+					break;
+
+				case COMMAND_STATE: {
+
+					GLenum capabilities[3] = { GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE };
+					uint32_t depth_test = this->get<uint32_t>(&cursor);
+					uint32_t depth_function = this->get<uint32_t>(&cursor);
+					uint32_t depth_mask = this->get<uint32_t>(&cursor);
+					uint32_t enabled[3] = { depth_test, this->get<uint32_t>(&cursor), this->get<uint32_t>(&cursor) };
+
+					for (int i = 0; i < 3; i++) {
+
+						if (enabled[i])
+							glEnable(capabilities[i]);
+						else
+							glDisable(capabilities[i]);
+
+					}
+
+					glDepthFunc(depth_function);
+					glDepthMask(depth_mask ? GL_TRUE : GL_FALSE);
+					break;
+
+				}
+
+				case COMMAND_VERTEX_ARRAY:
+					glBindVertexArray(this->get<uint32_t>(&cursor));
+					break;
+
+				case COMMAND_UNIFORM: {
+
+					GLint location = this->get<int32_t>(&cursor);
+					GLenum type = this->get<uint32_t>(&cursor);
+
+					bool integer;
+					CommandReplay::setUniform(location, type, this->commands.data() + cursor);
+					cursor += CommandRecorder::getComponents(type, &integer) * 4;
+					break;
+
+				}
+
+				case COMMAND_TEXTURE: {
+
+					GLuint unit = this->get<uint32_t>(&cursor);
+					GLenum target = this->get<uint32_t>(&cursor);
+					glActiveTexture(GL_TEXTURE0 + unit);
+					glBindTexture(target, this->get<uint32_t>(&cursor));
+					break;
+
+				}
+
+				case COMMAND_SAMPLER: {
+
+					GLuint unit = this->get<uint32_t>(&cursor);
+					glBindSampler(unit, this->get<uint32_t>(&cursor));
+					break;
+
+				}
+
+				case COMMAND_BLOCK: {
+
+					GLuint binding = this->get<uint32_t>(&cursor);
+					GLintptr offset = this->get<uint32_t>(&cursor);
+					glBindBufferRange(GL_UNIFORM_BUFFER, binding, this->buffer, offset, this->get<uint32_t>(&cursor));
+					break;
+
+				}
+
+				case COMMAND_DRAW: {
+
+					GLenum mode = this->get<uint32_t>(&cursor);
+					GLsizei count = this->get<int32_t>(&cursor);
+					GLenum type = this->get<uint32_t>(&cursor);
+					glDrawElements(mode, count, type, (const void*) (uintptr_t) this->get<uint64_t>(&cursor));
+					break;
+
+				}
+
+			}
+
+		}
+
+	}
+
+	int CommandReplay::getWidth() {
+
+		return this->width;
+
+	}
+
+	int CommandReplay::getHeight() {
+
+		return this->height;
+
+	}
+
+	size_t CommandReplay::getDraws() {
+
+		return this->draws;
+
+	}
+
+	size_t CommandReplay::getCommands() {
+
+		return this->count;
+
+	}
+
+	void CommandReplay::remove() {
+
+		glDeleteBuffers(1, &this->buffer);
+		this->buffer = 0;
+
+	}
+
+	void CommandReplay::setUniform(GLint location, GLenum type, const unsigned char* value) {
+
+		const GLfloat* floats = (const GLfloat*) value;
+		const GLint* integers = (const GLint*) value;
+
+		switch (type) {
+
+			case GL_FLOAT:
+				glUniform1fv(location, 1, floats);
+				break;
+			case GL_FLOAT_VEC2:
+				glUniform2fv(location, 1, floats);
+				break;
+			case GL_FLOAT_VEC3:
+				glUniform3fv(location, 1, floats);
+				break;
+			case GL_FLOAT_VEC4:
+				glUniform4fv(location, 1, floats);
+				break;
+			case GL_FLOAT_MAT2:
+				glUniformMatrix2fv(location, 1, GL_FALSE, floats);
+				break;
+			case GL_FLOAT_MAT3:
+				glUniformMatrix3fv(location, 1, GL_FALSE, floats);
+				break;
+			case GL_FLOAT_MAT4:
+				glUniformMatrix4fv(location, 1, GL_FALSE, floats);
+				break;
+			case GL_UNSIGNED_INT:
+				glUniform1uiv(location, 1, (const GLuint*) value);
+				break;
+			case GL_UNSIGNED_INT_VEC2:
+				glUniform2uiv(location, 1, (const GLuint*) value);
+				break;
+			case GL_UNSIGNED_INT_VEC3:
+				glUniform3uiv(location, 1, (const GLuint*) value);
+				break;
+			case GL_UNSIGNED_INT_VEC4:
+				glUniform4uiv(location, 1, (const GLuint*) value);
+				break;
+			case GL_INT_VEC2:
+			case GL_BOOL_VEC2:
+				glUniform2iv(location, 1, integers);
+				break;
+			case GL_INT_VEC3:
+			case GL_BOOL_VEC3:
+				glUniform3iv(location, 1, integers);
+				break;
+			case GL_INT_VEC4:
+			case GL_BOOL_VEC4:
+				glUniform4iv(location, 1, integers);
+				break;
+			default:
+				// Ints, bools and samplers.
+				glUniform1iv(location, 1, integers);
+				break;
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
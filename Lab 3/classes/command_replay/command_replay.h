@@ -0,0 +1,151 @@
+/**
+ * @file command_replay.h
+ * @brief CommandReplay class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_COMMAND_REPLAY_H_
+#define BGQ_OPENGL_CLASSES_COMMAND_REPLAY_H_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a CommandReplay class.
+	 *
+	 * Issues a frame recorded by a CommandRecorder again, as many times as
+	 * wanted, without the scene update, the culling or the GUI around it. The
+	 * recorded uniform data goes into a buffer of its own, the rest is bound
+	 * by the names it was recorded with, so it has to be replayed in the same
+	 * run, before those objects go away.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class CommandReplay {
+
+		public:
+
+			/**
+			 * @brief Construct the replay.
+			 *
+			 * Construct an empty replay.
+			 */
+			CommandReplay();
+
+			/**
+			 * @brief Construct the replay.
+			 *
+			 * Loads a recording and uploads its uniform data.
+			 *
+			 * @param path The file.
+			 */
+			CommandReplay(const std::string &path);
+
+			/**
+			 * @brief Draws the frame.
+			 *
+			 * Issues every recorded command in order. It leaves the state as the
+			 * recorded frame did, so it can be called in a loop.
+			 */
+			void draw();
+
+			/**
+			 * @brief Get the width.
+			 *
+			 * Get the width of the recorded frame.
+			 *
+			 * @returns The width in pixels.
+			 */
+			int getWidth();
+
+			/**
+			 * @brief Get the height.
+			 *
+			 * Get the height of the recorded frame.
+			 *
+			 * @returns The height in pixels.
+			 */
+			int getHeight();
+
+			/**
+			 * @brief Get the number of draws.
+			 *
+			 * Get the number of draws in the frame.
+			 *
+			 * @returns The number of draws.
+			 */
+			size_t getDraws();
+
+			/**
+			 * @brief Get the number of commands.
+			 *
+			 * Get the number of commands in the frame, draws included.
+			 *
+			 * @returns The number of commands.
+			 */
+			size_t getCommands();
+
+			/**
+			 * @brief Removes the replay from OpenGL.
+			 *
+			 * Removes the buffer of the uniform data from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			/**
+			 * @brief Reads a value from the commands.
+			 *
+			 * @param cursor Position of the value, moved past it.
+			 *
+			 * @returns The value.
+			 */
+			template <typename T> T get(size_t* cursor) const {
+
+				T value;
+				memcpy(&value, this->commands.data() + *cursor, sizeof(T));
+				*cursor += sizeof(T);
+
+				return value;
+
+			}
+
+			/**
+			 * @brief Sets a uniform.
+			 *
+			 * Sets a uniform of the current program from its recorded value.
+			 *
+			 * @param location Location in the program.
+			 * @param type Type, like GL_FLOAT_VEC3.
+			 * @param value The recorded value.
+			 */
+			static void setUniform(GLint location, GLenum type, const unsigned char* value);
+
+			std::vector<unsigned char> commands;	/// Recorded commands.
+			GLuint buffer = 0;						/// Buffer of the recorded uniform data.
+			int width = 0;							/// Width of the frame in pixels.
+			int height = 0;							/// Height of the frame in pixels.
+			size_t draws = 0;						/// Draws in the frame.
+			size_t count = 0;						/// Commands in the frame.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_COMMAND_REPLAY_H_
@@ -19,10 +19,13 @@
 #include <string>
 #include <vector>
 #include <cassert>
+#include <utility>
 
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
+#include "classes/deletion_queue/deletion_queue.h"
+
 namespace bgq_opengl {
 
     Cubemap::Cubemap(GLuint id, std::string name, GLuint slot) {
@@ -66,6 +69,9 @@ namespace bgq_opengl {
                 else
                     assert(false);
                 
+                this->face_width = width;
+                this->face_height = height;
+                
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, width, height, 0, color_model, GL_UNSIGNED_BYTE, data);
                 glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
                 stbi_image_free(data);
@@ -91,6 +97,43 @@ namespace bgq_opengl {
         
     }
 
+    Cubemap::Cubemap(Cubemap &&other) noexcept {
+
+        // Take over the other one, then leave it empty.
+        this->ID = other.ID;
+        this->slot = other.slot;
+        this->name = std::move(other.name);
+        this->face_width = other.face_width;
+        this->face_height = other.face_height;
+        other.ID = 0;
+
+    }
+
+    Cubemap& Cubemap::operator=(Cubemap &&other) noexcept {
+
+        if (this == &other)
+            return *this;
+
+        // Let go of the current one, then leave the other empty.
+        this->remove();
+
+        this->ID = other.ID;
+        this->slot = other.slot;
+        this->name = std::move(other.name);
+        this->face_width = other.face_width;
+        this->face_height = other.face_height;
+        other.ID = 0;
+
+        return *this;
+
+    }
+
+    Cubemap::~Cubemap() {
+
+        this->remove();
+
+    }
+
     GLuint Cubemap::getID() {
         
         return this->ID;
@@ -103,6 +146,18 @@ namespace bgq_opengl {
         
     }
 
+    int Cubemap::getWidth() {
+        
+        return this->face_width;
+        
+    }
+
+    int Cubemap::getHeight() {
+        
+        return this->face_height;
+        
+    }
+
     std::string Cubemap::getName() {
         
         return this->name;
@@ -118,9 +173,15 @@ namespace bgq_opengl {
     }
 
     void Cubemap::remove() {
-        
-        glDeleteTextures(1, &this->ID);
-        
+
+        // Nothing to delete if it was never created or was moved away.
+        if (this->ID == 0)
+            return;
+
+        // Deleted once the GPU is done with the frames that may still use it.
+        DeletionQueue::push(DELETE_TEXTURE, this->ID);
+        this->ID = 0;
+
     }
 
     void Cubemap::unbind() {
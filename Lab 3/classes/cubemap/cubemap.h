@@ -58,6 +58,37 @@ namespace bgq_opengl {
              */
             Cubemap(const std::vector<std::string> &textures_faces, const char* type, GLuint slot);
 
+            /**
+             * @brief Moves a cubemap.
+             *
+             * Takes over the OpenGL texture of another one, which is left empty.
+             *
+             * @param other The cubemap to move from.
+             */
+            Cubemap(Cubemap &&other) noexcept;
+
+            /**
+             * @brief Moves a cubemap.
+             *
+             * Releases the current OpenGL texture and takes over the one of another.
+             *
+             * @param other The cubemap to move from.
+             *
+             * @returns This cubemap.
+             */
+            Cubemap& operator=(Cubemap &&other) noexcept;
+
+            /**
+             * @brief Destroys the cubemap.
+             *
+             * Queues the OpenGL texture for deletion.
+             */
+            ~Cubemap();
+
+            // Only one object owns each OpenGL name, so there are no copies.
+            Cubemap(const Cubemap&) = delete;
+            Cubemap& operator=(const Cubemap&) = delete;
+
             /**
              * @brief Get the ID of the texture.
              *
@@ -76,6 +107,24 @@ namespace bgq_opengl {
              */
             GLuint getSlot();
 
+            /**
+             * @brief Gets the width of the faces.
+             *
+             * Gets the width of the faces in pixels.
+             *
+             * @returns The width of the faces in pixels.
+             */
+            int getWidth();
+
+            /**
+             * @brief Gets the height of the faces.
+             *
+             * Gets the height of the faces in pixels.
+             *
+             * @returns The height of the faces in pixels.
+             */
+            int getHeight();
+
             /**
              * @brief Gets the texture name.
              *
@@ -108,9 +157,11 @@ namespace bgq_opengl {
 
         private:
 
-            GLuint ID;                      /// Texture OpenGL ID.
-            GLuint slot;                    /// Stores the texture slot number.
+            GLuint ID = 0;                  /// Texture OpenGL ID.
+            GLuint slot = 0;                /// Stores the texture slot number.
             std::string name;               /// Texture name.
+            int face_width = 0;             /// Width of the faces in pixels.
+            int face_height = 0;            /// Height of the faces in pixels.
 
     };
 
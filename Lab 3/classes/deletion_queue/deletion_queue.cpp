@@ -0,0 +1,148 @@
+/**
+ * @file deletion_queue.cpp
+ * @brief DeletionQueue class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "deletion_queue.h"
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/pending_deletion/pending_deletion.h"
+
+namespace bgq_opengl {
+
+	std::vector<PendingDeletion>* DeletionQueue::current = new std::vector<PendingDeletion>();
+	std::deque<std::vector<PendingDeletion>>* DeletionQueue::frames = new std::deque<std::vector<PendingDeletion>>();
+	std::deque<GLsync>* DeletionQueue::fences = new std::deque<GLsync>();
+	bool DeletionQueue::closed = false;
+
+	void DeletionQueue::push(int type, GLuint id) {
+
+		if (id == 0 || DeletionQueue::closed)
+			return;
+
+		PendingDeletion pending;
+		pending.type = type;
+		pending.id = id;
+
+		DeletionQueue::current->push_back(pending);
+
+	}
+
+	void DeletionQueue::endFrame() {
+
+		if (DeletionQueue::current->empty())
+			return;
+
+		DeletionQueue::fences->push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		DeletionQueue::frames->push_back(std::vector<PendingDeletion>());
+		DeletionQueue::frames->back().swap(*DeletionQueue::current);
+
+	}
+
+	size_t DeletionQueue::collect() {
+
+		size_t deleted = 0;
+
+		// Frames finish in order, so stop at the first one still running.
+		while (!DeletionQueue::fences->empty()) {
+
+			GLsync fence = DeletionQueue::fences->front();
+			GLenum result = glClientWaitSync(fence, 0, 0);
+
+			if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+				break;
+
+			glDeleteSync(fence);
+			DeletionQueue::release(DeletionQueue::frames->front());
+			deleted += DeletionQueue::frames->front().size();
+
+			DeletionQueue::fences->pop_front();
+			DeletionQueue::frames->pop_front();
+
+		}
+
+		return deleted;
+
+	}
+
+	size_t DeletionQueue::flush() {
+
+		size_t deleted = 0;
+
+		// Nothing is in flight once the GPU is idle.
+		glFinish();
+
+		while (!DeletionQueue::fences->empty()) {
+
+			glDeleteSync(DeletionQueue::fences->front());
+			DeletionQueue::release(DeletionQueue::frames->front());
+			deleted += DeletionQueue::frames->front().size();
+
+			DeletionQueue::fences->pop_front();
+			DeletionQueue::frames->pop_front();
+
+		}
+
+		DeletionQueue::release(*DeletionQueue::current);
+		deleted += DeletionQueue::current->size();
+		DeletionQueue::current->clear();
+
+		return deleted;
+
+	}
+
+	void DeletionQueue::close() {
+
+		DeletionQueue::flush();
+		DeletionQueue::closed = true;
+
+	}
+
+	size_t DeletionQueue::getPending() {
+
+		size_t pending = DeletionQueue::current->size();
+
+		for (size_t i = 0; i < DeletionQueue::frames->size(); i++)
+			pending += (*DeletionQueue::frames)[i].size();
+
+		return pending;
+
+	}
+
+	void DeletionQueue::release(const std::vector<PendingDeletion> &batch) {
+
+		for (size_t i = 0; i < batch.size(); i++) {
+
+			GLuint id = batch[i].id;
+
+			switch (batch[i].type) {
+
+				case DELETE_BUFFER: glDeleteBuffers(1, &id); break;
+				case DELETE_VERTEX_ARRAY: glDeleteVertexArrays(1, &id); break;
+				case DELETE_TEXTURE: glDeleteTextures(1, &id); break;
+				case DELETE_SAMPLER: glDeleteSamplers(1, &id); break;
+				case DELETE_PROGRAM: glDeleteProgram(id); break;
+				case DELETE_FRAMEBUFFER: glDeleteFramebuffers(1, &id); break;
+
+			}
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,130 @@
+/**
+ * @file deletion_queue.h
+ * @brief DeletionQueue class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_DELETION_QUEUE_H_
+#define BGQ_OPENGL_CLASSES_DELETION_QUEUE_H_
+
+#define DELETE_BUFFER 0			/// Buffer objects.
+#define DELETE_VERTEX_ARRAY 1	/// Vertex array objects.
+#define DELETE_TEXTURE 2		/// Textures of any target.
+#define DELETE_SAMPLER 3		/// Sampler objects.
+#define DELETE_PROGRAM 4		/// Shader programs.
+#define DELETE_FRAMEBUFFER 5	/// Framebuffer objects.
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/pending_deletion/pending_deletion.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a DeletionQueue class.
+	 *
+	 * Holds the OpenGL objects released by their owners until the GPU is done
+	 * with every frame that could still use them. Owners push their names when
+	 * they are destroyed, endFrame() fences whatever was pushed during the
+	 * frame, and collect() deletes the batches whose fence has signalled.
+	 *
+	 * The queue is global, so the wrappers can release their names from their
+	 * destructors without knowing about the render loop. Pushing never calls
+	 * OpenGL, so it is safe from any destructor.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class DeletionQueue {
+
+		public:
+
+			/**
+			 * @brief Queues an object for deletion.
+			 *
+			 * Queues an OpenGL object to be deleted once the current frame is done.
+			 * Zero names and pushes after close() are ignored.
+			 *
+			 * @param type One of the DELETE_* types.
+			 * @param id OpenGL name of the object.
+			 */
+			static void push(int type, GLuint id);
+
+			/**
+			 * @brief Ends the frame.
+			 *
+			 * Fences the objects pushed since the last call, so they are deleted
+			 * once the GPU has finished the commands issued so far.
+			 */
+			static void endFrame();
+
+			/**
+			 * @brief Deletes the finished objects.
+			 *
+			 * Deletes the objects of every frame the GPU has already finished,
+			 * without waiting for the rest.
+			 *
+			 * @returns The number of objects deleted.
+			 */
+			static size_t collect();
+
+			/**
+			 * @brief Deletes everything.
+			 *
+			 * Waits for the GPU and deletes every queued object, fenced or not.
+			 *
+			 * @returns The number of objects deleted.
+			 */
+			static size_t flush();
+
+			/**
+			 * @brief Closes the queue.
+			 *
+			 * Flushes the queue and ignores every push from then on. Call before
+			 * the context is destroyed, the driver frees anything released later.
+			 */
+			static void close();
+
+			/**
+			 * @brief Get the number of queued objects.
+			 *
+			 * Get the number of objects waiting to be deleted.
+			 *
+			 * @returns The number of queued objects.
+			 */
+			static size_t getPending();
+
+		private:
+
+			/**
+			 * @brief Deletes a batch of objects.
+			 *
+			 * Deletes a batch of objects in OpenGL right away.
+			 *
+			 * @param batch The objects to delete.
+			 */
+			static void release(const std::vector<PendingDeletion> &batch);
+
+			// Never destroyed, so owners that outlive main() can still push.
+			static std::vector<PendingDeletion>* current;			/// Objects pushed during this frame.
+			static std::deque<std::vector<PendingDeletion>>* frames;	/// Objects of every fenced frame.
+			static std::deque<GLsync>* fences;						/// Fence of every fenced frame.
+			static bool closed;										/// Whether pushes are ignored.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_DELETION_QUEUE_H_
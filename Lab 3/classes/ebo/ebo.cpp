@@ -15,12 +15,19 @@
 
 #include "ebo.h"
 
+#include <utility>
 #include <vector>
 
 #include "GL/glew.h"
 
+#include "classes/deletion_queue/deletion_queue.h"
+
 namespace bgq_opengl {
 
+	EBO::EBO() {
+
+	}
+
 	// Constructor that generates a Elements Buffer Object and links it to indices
 	EBO::EBO(const std::vector<GLuint> &indices) {
 		
@@ -33,6 +40,35 @@ namespace bgq_opengl {
 	
 	}
 
+	EBO::EBO(EBO &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->ID = other.ID;
+		other.ID = 0;
+
+	}
+
+	EBO& EBO::operator=(EBO &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->ID = other.ID;
+		other.ID = 0;
+
+		return *this;
+
+	}
+
+	EBO::~EBO() {
+
+		this->remove();
+
+	}
+
 	void EBO::bind() {
 
 		// Binds the EBO.
@@ -42,7 +78,13 @@ namespace bgq_opengl {
 
 	void EBO::remove() {
 
-		glDeleteBuffers(1, &this->ID);
+		// Nothing to delete if it was never created or was moved away.
+		if (this->ID == 0)
+			return;
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_BUFFER, this->ID);
+		this->ID = 0;
 
 	}
 
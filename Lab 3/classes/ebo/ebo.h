@@ -34,6 +34,13 @@ namespace bgq_opengl {
 		
 		public:
 			
+			/**
+			 * @brief Constructs an empty Elements Buffer Object.
+			 *
+			 * Constructs a Elements Buffer Object with no buffer behind it.
+			 */
+			EBO();
+
 			/**
 			 * @brief Constructs a Elements Buffer Object.
 			 *
@@ -43,6 +50,37 @@ namespace bgq_opengl {
 			 */
 			EBO(const std::vector<GLuint> &indices);
 
+			/**
+			 * @brief Moves an EBO.
+			 *
+			 * Takes over the OpenGL buffer of another one, which is left empty.
+			 *
+			 * @param other The EBO to move from.
+			 */
+			EBO(EBO &&other) noexcept;
+
+			/**
+			 * @brief Moves an EBO.
+			 *
+			 * Releases the current OpenGL buffer and takes over the one of another.
+			 *
+			 * @param other The EBO to move from.
+			 *
+			 * @returns This EBO.
+			 */
+			EBO& operator=(EBO &&other) noexcept;
+
+			/**
+			 * @brief Destroys the EBO.
+			 *
+			 * Queues the OpenGL buffer for deletion.
+			 */
+			~EBO();
+
+			// Only one object owns each OpenGL name, so there are no copies.
+			EBO(const EBO&) = delete;
+			EBO& operator=(const EBO&) = delete;
+
 			/**
 			 * @brief Binds the EBO.
 			 *
@@ -66,7 +104,7 @@ namespace bgq_opengl {
 
 		private:
 
-			GLuint ID; // GL ID of the EBO.
+			GLuint ID = 0; // GL ID of the EBO.
 
 	};
 
@@ -0,0 +1,193 @@
+/**
+ * @file file_watcher.cpp
+ * @brief FileWatcher class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "file_watcher.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace bgq_opengl {
+
+	FileWatcher::FileWatcher() {
+
+	}
+
+	FileWatcher::~FileWatcher() {
+
+		this->stop();
+
+	}
+
+	void FileWatcher::start(const std::vector<std::string> &filenames) {
+
+		this->stop();
+
+		this->filenames = filenames;
+		this->running = true;
+		this->thread = std::thread(&FileWatcher::run, this);
+
+	}
+
+	bool FileWatcher::poll(std::string* filename, std::string* contents) {
+
+		std::lock_guard<std::mutex> lock(this->changes_mutex);
+
+		if (this->changes.empty())
+			return false;
+
+		auto first = this->changes.begin();
+		*filename = first->first;
+		*contents = std::move(first->second);
+		this->changes.erase(first);
+
+		return true;
+
+	}
+
+	void FileWatcher::stop() {
+
+		this->running = false;
+
+		if (this->thread.joinable())
+			this->thread.join();
+
+	}
+
+	void FileWatcher::run() {
+
+#ifdef __linux__
+
+		int fd = inotify_init1(IN_NONBLOCK);
+
+		if (fd < 0) {
+
+			std::cerr << "FileWatcher warning - Could not start inotify, hot reload is disabled." << std::endl;
+			return;
+
+		}
+
+		// Watch the directories rather than the files, since most editors save by replacing the file.
+		std::map<int, std::string> directories;
+
+		for (const std::string &filename : this->filenames) {
+
+			std::string directory = std::filesystem::absolute(filename).parent_path().string();
+			int watch = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+
+			if (watch >= 0)
+				directories[watch] = directory;
+
+		}
+
+		alignas(struct inotify_event) char buffer[4096];
+
+		while (this->running) {
+
+			// Wake up every now and then to see if we should stop.
+			struct pollfd request = { fd, POLLIN, 0 };
+			if (::poll(&request, 1, FILE_WATCHER_INTERVAL_MS) <= 0)
+				continue;
+
+			ssize_t length = read(fd, buffer, sizeof(buffer));
+
+			// Several events for the same file usually come together, so only read each one once.
+			std::set<std::string> changed;
+
+			for (ssize_t i = 0; i < length; ) {
+
+				const struct inotify_event* event = (const struct inotify_event*) (buffer + i);
+				i += sizeof(struct inotify_event) + event->len;
+
+				if (event->len == 0 || directories.count(event->wd) == 0)
+					continue;
+
+				std::filesystem::path path = std::filesystem::path(directories[event->wd]) / event->name;
+
+				for (const std::string &filename : this->filenames)
+					if (std::filesystem::absolute(filename) == path)
+						changed.insert(filename);
+
+			}
+
+			for (const std::string &filename : changed)
+				this->readChanged(filename);
+
+		}
+
+		close(fd);
+
+#else
+
+		// No inotify, so compare the modification times.
+		std::map<std::string, std::filesystem::file_time_type> times;
+		std::error_code error;
+
+		for (const std::string &filename : this->filenames)
+			times[filename] = std::filesystem::last_write_time(filename, error);
+
+		while (this->running) {
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(FILE_WATCHER_INTERVAL_MS));
+
+			for (const std::string &filename : this->filenames) {
+
+				std::filesystem::file_time_type time = std::filesystem::last_write_time(filename, error);
+
+				if (error || time == times[filename])
+					continue;
+
+				times[filename] = time;
+				this->readChanged(filename);
+
+			}
+
+		}
+
+#endif
+
+	}
+
+	void FileWatcher::readChanged(const std::string &filename) {
+
+		std::ifstream filestream(filename);
+
+		if (!filestream.is_open())
+			return;
+
+		std::stringstream str_stream;
+		str_stream << filestream.rdbuf();
+
+		// A file saved twice before being polled only needs its latest contents.
+		std::lock_guard<std::mutex> lock(this->changes_mutex);
+		this->changes[filename] = str_stream.str();
+
+	}
+
+}  // namespace bgq_opengl
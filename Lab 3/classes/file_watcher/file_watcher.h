@@ -0,0 +1,117 @@
+/**
+ * @file file_watcher.h
+ * @brief FileWatcher class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_FILE_WATCHER_H_
+#define BGQ_OPENGL_CLASSES_FILE_WATCHER_H_
+
+#define FILE_WATCHER_INTERVAL_MS 250	/// How often the watcher thread looks for changes.
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a FileWatcher class.
+	 *
+	 * Watches a set of files from a background thread. When one of them changes,
+	 * the thread reads it into memory, so the render loop only has to pick up
+	 * the new contents with poll().
+	 *
+	 * On Linux it sleeps on inotify. Everywhere else (macOS included) it compares
+	 * the modification times of the files every FILE_WATCHER_INTERVAL_MS.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class FileWatcher {
+
+		public:
+
+			/**
+			 * @brief Construct the watcher.
+			 *
+			 * Construct a watcher that does nothing until started.
+			 */
+			FileWatcher();
+
+			/**
+			 * @brief Destroy the watcher.
+			 *
+			 * Stops the background thread.
+			 */
+			~FileWatcher();
+
+			/**
+			 * @brief Start watching.
+			 *
+			 * Starts the background thread that watches the files.
+			 *
+			 * @param filenames The files to watch.
+			 */
+			void start(const std::vector<std::string> &filenames);
+
+			/**
+			 * @brief Get the next change.
+			 *
+			 * Get the next file that changed and its new contents, without blocking.
+			 *
+			 * @param filename Output variable for the name of the file, as it was given to start.
+			 * @param contents Output variable for the contents of the file.
+			 *
+			 * @returns True if there was a change.
+			 */
+			bool poll(std::string* filename, std::string* contents);
+
+			/**
+			 * @brief Stop watching.
+			 *
+			 * Stops the background thread and waits for it.
+			 */
+			void stop();
+
+		private:
+
+			/**
+			 * @brief Body of the background thread.
+			 *
+			 * Waits for changes until stopped.
+			 */
+			void run();
+
+			/**
+			 * @brief Reads a changed file.
+			 *
+			 * Reads a file and queues its contents for poll().
+			 *
+			 * @param filename The name of the file.
+			 */
+			void readChanged(const std::string &filename);
+
+			std::vector<std::string> filenames;						/// Files being watched.
+			std::map<std::string, std::string> changes;				/// Contents of the changed files not polled yet.
+			std::mutex changes_mutex;								/// Guards the changes.
+			std::thread thread;										/// Background thread.
+			std::atomic<bool> running{false};						/// Whether the thread should keep going.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_FILE_WATCHER_H_
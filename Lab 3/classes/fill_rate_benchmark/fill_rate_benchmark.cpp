@@ -0,0 +1,106 @@
+/**
+ * @file fill_rate_benchmark.cpp
+ * @brief FillRateBenchmark class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "fill_rate_benchmark.h"
+
+
+#include "GL/glew.h"
+
+#include "classes/deletion_queue/deletion_queue.h"
+#include "classes/render_target/render_target.h"
+#include "classes/sampler/sampler.h"
+#include "classes/shader/shader.h"
+#include "classes/texture_array/texture_array.h"
+
+namespace bgq_opengl {
+
+	FillRateBenchmark::FillRateBenchmark() {
+
+	}
+
+	FillRateBenchmark::FillRateBenchmark(int width, int height) {
+
+		// Nothing is drawn with depth, only the color is written.
+		this->target = RenderTarget(width, height, GL_RGBA8, false);
+
+		// Core profiles need a vertex array bound to draw, even an empty one.
+		glGenVertexArrays(1, &this->vao);
+
+		this->shader = Shader("fill_rate.vert", "fill_rate.frag");
+
+	}
+
+	double FillRateBenchmark::measure(TextureArray &texture_array, int layer, Sampler &sampler, int passes) {
+
+		// Keep the state that will be changed.
+		GLint previous_framebuffer = 0;
+		GLint previous_viewport[4];
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+		glGetIntegerv(GL_VIEWPORT, previous_viewport);
+		GLboolean depth_test = glIsEnabled(GL_DEPTH_TEST);
+
+		this->target.bind();
+		glDisable(GL_DEPTH_TEST);
+
+		// Set up the sampling.
+		this->shader.activate();
+		texture_array.bind();
+		sampler.bind(texture_array.getSlot());
+		this->shader.passInt("image", texture_array.getSlot());
+		this->shader.passFloat("layer", (float) layer);
+		glBindVertexArray(this->vao);
+
+		// One pass first, so the texture is resident before timing.
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		GLuint query;
+		glGenQueries(1, &query);
+		glBeginQuery(GL_TIME_ELAPSED, query);
+
+		for (int i = 0; i < passes; i++)
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		glEndQuery(GL_TIME_ELAPSED);
+
+		// Waits for the GPU.
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		glDeleteQueries(1, &query);
+
+		// Restore everything.
+		glBindVertexArray(0);
+		Sampler::unbind(texture_array.getSlot());
+		glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+		glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]);
+
+		if (depth_test)
+			glEnable(GL_DEPTH_TEST);
+
+		return elapsed / 1000000.0 / passes;
+
+	}
+
+	void FillRateBenchmark::remove() {
+
+		this->shader.remove();
+		this->target.remove();
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_VERTEX_ARRAY, this->vao);
+		this->vao = 0;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,92 @@
+/**
+ * @file fill_rate_benchmark.h
+ * @brief FillRateBenchmark class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_FILL_RATE_BENCHMARK_H_
+#define BGQ_OPENGL_CLASSES_FILL_RATE_BENCHMARK_H_
+
+#include "GL/glew.h"
+
+#include "classes/render_target/render_target.h"
+#include "classes/sampler/sampler.h"
+#include "classes/shader/shader.h"
+#include "classes/texture_array/texture_array.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a FillRateBenchmark class.
+	 *
+	 * Measures how long the GPU takes to fill an offscreen target while sampling
+	 * a texture the way the bump mapping does (four taps per pixel), over a
+	 * surface that recedes into the distance so minification and anisotropy
+	 * actually kick in. Timing uses GL_TIME_ELAPSED queries, so only GPU time is
+	 * counted.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class FillRateBenchmark {
+
+		public:
+
+			/**
+			 * @brief Construct the benchmark.
+			 *
+			 * Construct an empty benchmark.
+			 */
+			FillRateBenchmark();
+
+			/**
+			 * @brief Construct the benchmark.
+			 *
+			 * Construct the benchmark with an offscreen target of the given size.
+			 *
+			 * @param width Width of the target in pixels.
+			 * @param height Height of the target in pixels.
+			 */
+			FillRateBenchmark(int width, int height);
+
+			/**
+			 * @brief Measure a sampler.
+			 *
+			 * Fills the target a number of times sampling a layer of a texture array
+			 * through a sampler, and restores the framebuffer and viewport afterwards.
+			 *
+			 * @param texture_array The texture array to sample.
+			 * @param layer The layer to sample.
+			 * @param sampler The sampler to sample it with.
+			 * @param passes The number of times the target is filled.
+			 *
+			 * @returns The average GPU time of a pass in milliseconds.
+			 */
+			double measure(TextureArray &texture_array, int layer, Sampler &sampler, int passes);
+
+			/**
+			 * @brief Removes the benchmark from OpenGL.
+			 *
+			 * Removes the target, the vertex array and the shader from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			RenderTarget target;		/// Offscreen target, color only.
+			GLuint vao = 0;				/// Empty vertex array, the triangle comes from gl_VertexID.
+			Shader shader;				/// Shader that does the sampling.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_FILL_RATE_BENCHMARK_H_
@@ -0,0 +1,196 @@
+/**
+ * @file frame_capture.cpp
+ * @brief FrameCapture class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "frame_capture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	FrameCapture::FrameCapture() {
+
+	}
+
+	FrameCapture::FrameCapture(bool half, int latency) {
+
+		this->half = half;
+		this->latency = std::max(1, latency);
+
+	}
+
+	void FrameCapture::addConsumer(const std::function<void(CapturedFrame)> &consumer) {
+
+		this->consumers.push_back(consumer);
+
+	}
+
+	void FrameCapture::capture(GLuint framebuffer, int width, int height) {
+
+		// A minimised window has nothing to read.
+		if (width <= 0 || height <= 0)
+			return;
+
+		size_t size = (size_t) width * height * (this->half ? 8 : 4);
+
+		// Hand over what was read at the old size before remaking the buffers.
+		if (width != this->width || height != this->height) {
+
+			this->finish();
+
+			if (!this->readback.empty())
+				glDeleteBuffers((GLsizei) this->readback.size(), this->readback.data());
+
+			this->readback.assign(this->latency, 0);
+			this->fences.assign(this->latency, nullptr);
+			this->frames.assign(this->latency, 0);
+			this->first = 0;
+			this->width = width;
+			this->height = height;
+
+			glGenBuffers(this->latency, this->readback.data());
+
+			for (int i = 0; i < this->latency; i++) {
+
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readback[i]);
+				glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) size, NULL, GL_STREAM_READ);
+
+			}
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		}
+
+		// Make room for this frame.
+		if (this->count == this->latency)
+			this->collect();
+
+		GLint previous_framebuffer = 0;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glReadBuffer(framebuffer == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+
+		// Copy into the buffer without waiting, it is mapped when the ring comes back to it.
+		int index = (this->first + this->count) % this->latency;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readback[index]);
+		glReadPixels(0, 0, width, height, GL_RGBA, this->half ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		this->fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->frames[index] = this->next++;
+		this->count++;
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, previous_framebuffer);
+
+	}
+
+	void FrameCapture::finish() {
+
+		while (this->count > 0)
+			this->collect();
+
+	}
+
+	long FrameCapture::getCaptured() {
+
+		return this->captured;
+
+	}
+
+	long FrameCapture::getStalls() {
+
+		return this->stalls;
+
+	}
+
+	void FrameCapture::remove() {
+
+		for (size_t i = 0; i < this->fences.size(); i++)
+			if (this->fences[i] != nullptr)
+				glDeleteSync(this->fences[i]);
+
+		if (!this->readback.empty())
+			glDeleteBuffers((GLsizei) this->readback.size(), this->readback.data());
+
+		this->readback.clear();
+		this->fences.clear();
+		this->frames.clear();
+		this->first = 0;
+		this->count = 0;
+		this->width = 0;
+		this->height = 0;
+
+	}
+
+	void FrameCapture::collect() {
+
+		int index = this->first;
+		GLsync fence = this->fences[index];
+
+		// Flush on the first try so the fence is guaranteed to signal eventually.
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+		if (result == GL_TIMEOUT_EXPIRED) {
+
+			this->stalls++;
+
+			while (result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync(fence, 0, 1000000);
+
+		}
+
+		glDeleteSync(fence);
+		this->fences[index] = nullptr;
+
+		CapturedFrame frame;
+		frame.frame = this->frames[index];
+		frame.width = this->width;
+		frame.height = this->height;
+		frame.half = this->half;
+		frame.pixels.resize((size_t) this->width * this->height * (this->half ? 8 : 4));
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readback[index]);
+		const unsigned char* pixels = (const unsigned char*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frame.pixels.size(), GL_MAP_READ_BIT);
+
+		if (pixels != nullptr) {
+
+			memcpy(frame.pixels.data(), pixels, frame.pixels.size());
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		this->first = (this->first + 1) % this->latency;
+		this->count--;
+		this->captured++;
+
+		// Only the last consumer gets the pixels without a copy.
+		for (size_t i = 0; i + 1 < this->consumers.size(); i++)
+			this->consumers[i](frame);
+
+		if (!this->consumers.empty())
+			this->consumers.back()(std::move(frame));
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,154 @@
+/**
+ * @file frame_capture.h
+ * @brief FrameCapture class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_FRAME_CAPTURE_H_
+#define BGQ_OPENGL_CLASSES_FRAME_CAPTURE_H_
+
+/// Frames between reading one back and handing it to the consumers.
+#define FRAME_CAPTURE_LATENCY 3
+
+#include <functional>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/captured_frame/captured_frame.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a FrameCapture class.
+	 *
+	 * Reads frames back from a framebuffer without stalling. Every frame is read
+	 * into one of a ring of pixel buffers with a fence after it, and is only
+	 * mapped when the ring comes back around to it, some frames later, by when
+	 * the GPU has usually finished it. The frames are then handed to whatever
+	 * consumers were added, like a file writer or a diff.
+	 *
+	 * The buffers are made on the first capture and remade when the size
+	 * changes, so it can follow a window.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class FrameCapture {
+
+		public:
+
+			/**
+			 * @brief Construct the capture.
+			 *
+			 * Construct a capture of RGBA8 frames with the default latency.
+			 */
+			FrameCapture();
+
+			/**
+			 * @brief Construct the capture.
+			 *
+			 * Construct a capture with the given format and latency.
+			 *
+			 * @param half Whether the frames are read as half floats instead of RGBA8.
+			 * @param latency Frames between reading one back and handing it over.
+			 */
+			FrameCapture(bool half, int latency = FRAME_CAPTURE_LATENCY);
+
+			/**
+			 * @brief Adds a consumer.
+			 *
+			 * Adds a function the frames are handed to, in order, after the ones
+			 * added before it. Every consumer gets a frame of its own, and the
+			 * last one gets the one that was read, so it can move the pixels out.
+			 *
+			 * @param consumer The function.
+			 */
+			void addConsumer(const std::function<void(CapturedFrame)> &consumer);
+
+			/**
+			 * @brief Captures a frame.
+			 *
+			 * Starts reading the first color attachment of a framebuffer, or the
+			 * back buffer of the window for 0, and hands the oldest frame to the
+			 * consumers if the ring is full. Restores the read framebuffer
+			 * afterwards. Does nothing for an empty framebuffer, like the one of
+			 * a minimised window.
+			 *
+			 * @param framebuffer The framebuffer.
+			 * @param width Width of the framebuffer in pixels.
+			 * @param height Height of the framebuffer in pixels.
+			 */
+			void capture(GLuint framebuffer, int width, int height);
+
+			/**
+			 * @brief Finishes the frames in flight.
+			 *
+			 * Hands every frame still being read back to the consumers.
+			 */
+			void finish();
+
+			/**
+			 * @brief Get the captured frames.
+			 *
+			 * Get the number of frames handed to the consumers so far.
+			 *
+			 * @returns The number of frames.
+			 */
+			long getCaptured();
+
+			/**
+			 * @brief Get the stalls.
+			 *
+			 * Get the number of frames that were not finished by the GPU when
+			 * their turn came, so mapping them had to wait.
+			 *
+			 * @returns The number of stalls.
+			 */
+			long getStalls();
+
+			/**
+			 * @brief Removes the capture from OpenGL.
+			 *
+			 * Drops the frames in flight and removes the buffers and the fences
+			 * from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			/**
+			 * @brief Hands the oldest frame to the consumers.
+			 *
+			 * Waits for the fence of the oldest frame, copies it out of its
+			 * buffer and hands it to the consumers.
+			 */
+			void collect();
+
+			std::vector<std::function<void(CapturedFrame)>> consumers;			/// Functions the frames are handed to.
+			std::vector<GLuint> readback;						/// Buffers the frames are read into, in turns.
+			std::vector<GLsync> fences;							/// Fences of the reads.
+			std::vector<long> frames;							/// Number of the frame in every buffer.
+			int first = 0;										/// Buffer of the oldest frame in flight.
+			int count = 0;										/// Frames in flight.
+			int width = 0;										/// Width of the buffers in pixels.
+			int height = 0;										/// Height of the buffers in pixels.
+			int latency = FRAME_CAPTURE_LATENCY;				/// Buffers in the ring.
+			bool half = false;									/// Whether the frames are read as half floats.
+			long next = 0;										/// Number of the next frame read.
+			long captured = 0;									/// Frames handed over so far.
+			long stalls = 0;									/// Frames that had to be waited for.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_FRAME_CAPTURE_H_
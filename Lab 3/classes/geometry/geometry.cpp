@@ -15,109 +15,157 @@
 
 #include "geometry.h"
 
-#include <vector>
+#include <cmath>
+#include <memory>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/command_recorder/command_recorder.h"
 #include "classes/ebo/ebo.h"
 #include "classes/shader/shader.h"
+#include "classes/stream_buffer/stream_buffer.h"
 #include "classes/texture/texture.h"
 #include "classes/vao/vao.h"
+#include "structs/instance_data/instance_data.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
 
 namespace bgq_opengl {
 
-	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess) {
+	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, std::vector<Texture> textures, const float shininess) {
 
 		// Store a copy of these in the attributes.
 		this->vertices = vertices;
 		this->indices = indices;
-        this->textures = textures;
+        
+        // The textures can only be moved, into handles so they can be shared like the cached ones.
+        for (size_t i = 0; i < textures.size(); i++)
+            this->textures.push_back(std::make_shared<Texture>(std::move(textures[i])));
+        
         this->shininess = shininess;
 
 		// Generate a VAO and bind it, generate a VBO for the vertices and a EBO for the indices.
+		// Keep the buffers, so they can be freed along with the VAO.
 		this->vao.bind();
-		VBO vbo(vertices);
-		EBO ebo(indices);
+		this->vbo = VBO(vertices);
+		this->ebo = EBO(indices);
 
 		// Links VBO attributes such as coordinates and colors to VAO.
-		vao.link_attribute(vbo, 0, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)0);
-		vao.link_attribute(vbo, 1, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(3 * sizeof(float)));
-		vao.link_attribute(vbo, 2, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(6 * sizeof(float)));
-        vao.link_attribute(vbo, 3, 2, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(9 * sizeof(float)));
-        vao.link_attribute(vbo, 4, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(11 * sizeof(float)));
-        vao.link_attribute(vbo, 5, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(14 * sizeof(float)));
+		vao.link_attribute(this->vbo, 0, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)0);
+		vao.link_attribute(this->vbo, 1, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(3 * sizeof(float)));
+		vao.link_attribute(this->vbo, 2, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(6 * sizeof(float)));
+        vao.link_attribute(this->vbo, 3, 2, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(9 * sizeof(float)));
+        vao.link_attribute(this->vbo, 4, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(11 * sizeof(float)));
+        vao.link_attribute(this->vbo, 5, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(14 * sizeof(float)));
 
 		vao.unbind();
-		vbo.unbind();
-		ebo.unbind();
+		this->vbo.unbind();
+		this->ebo.unbind();
+
+	}
+
+	size_t Geometry::getMemorySize() {
+
+		return this->vertices.size() * sizeof(Vertex) + this->indices.size() * sizeof(GLuint);
+
+	}
+
+	float Geometry::getSurfaceArea() {
+
+		float area = 0.0f;
+
+		for (size_t i = 0; i + 2 < this->indices.size(); i += 3) {
+
+			glm::vec3 a = this->vertices[this->indices[i]].position;
+			glm::vec3 b = this->vertices[this->indices[i + 1]].position;
+			glm::vec3 c = this->vertices[this->indices[i + 2]].position;
+
+			area += glm::length(glm::cross(b - a, c - a)) * 0.5f;
+
+		}
+
+		return area;
+
+	}
+
+	float Geometry::getUVArea() {
+
+		float area = 0.0f;
+
+		for (size_t i = 0; i + 2 < this->indices.size(); i += 3) {
+
+			glm::vec2 a = this->vertices[this->indices[i]].uv;
+			glm::vec2 b = this->vertices[this->indices[i + 1]].uv;
+			glm::vec2 c = this->vertices[this->indices[i + 2]].uv;
+
+			glm::vec2 ab = b - a;
+			glm::vec2 ac = c - a;
+			area += std::abs(ab.x * ac.y - ab.y * ac.x) * 0.5f;
+
+		}
+
+		return area;
 
 	}
 
-	std::vector<GLuint> Geometry::getIndices() {
+	const std::vector<GLuint>& Geometry::getIndices() const {
 
 		return this->indices;
 
 	}
 
-	std::vector<Texture>  Geometry::getTextures() {
+	const std::vector<std::shared_ptr<Texture>>& Geometry::getTextures() {
 
 		return this->textures;
 
 	}
 
-	VAO Geometry::getVAO() {
+	const VAO& Geometry::getVAO() {
 
 		return this->vao;
 
 	}
 
-	std::vector<Vertex> Geometry::getVertices() {
+	const std::vector<Vertex>& Geometry::getVertices() const {
 
 		return this->vertices;
 
 	}
 
-    float Geometry::getShininess() {
-        
-        return this->shininess;
-        
-    }
+    void Geometry::remove() {
+
+        this->vao.remove();
+        this->vbo.remove();
+        this->ebo.remove();
 
-    void Geometry::setShininess(float shine) {
-        
-        this->shininess = shine;
-        
     }
 
-    glm::mat4 Geometry::getTransformMat() {
+    float Geometry::getShininess() const {
         
-        return this->transforms;
+        return this->shininess;
         
     }
 
-    void Geometry::setTransformMat(glm::mat4 transform) {
+    void Geometry::setShininess(float shine) {
         
-        this->transforms = transform;
+        this->shininess = shine;
         
     }
 
-    void Geometry::addTexture(const char* image, const char* name) {
-        
-        // Create the new texture from the parameters.
-        Texture new_tex(image, name, (int) this->textures.size() + 1);
+    void Geometry::addTexture(const std::shared_ptr<Texture> &texture) {
         
         // Add this texture to the texture vector.
-        this->textures.push_back(new_tex);
+        this->textures.push_back(texture);
         
     }
 
-	void Geometry::draw(Shader &shader, Camera &camera) {
+	void Geometry::draw(Shader &shader, Camera &camera, StreamBuffer &stream, const InstanceData &instance) {
 
 		// Activate the VAO and the shader to access the uniforms.
 		shader.activate();
@@ -125,11 +173,11 @@ namespace bgq_opengl {
 
 		for (size_t i = 0; i < textures.size(); i++) {
 
-			std::string name = textures[i].getName();
+			std::string name = textures[i]->getName();
 			std::string id = "";
 			
-            textures[i].bind();
-			shader.passTexture(textures[i]);
+            textures[i]->bind();
+			shader.passTexture(*textures[i]);
 
 		}
 
@@ -139,21 +187,12 @@ namespace bgq_opengl {
         // Pass the shininess to the shader.
         shader.passFloat("materialShininess", this->shininess);
         
-		// Get the model matrix and pass it.
-		glm::mat4 model = this->transforms;
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Model"), 1, GL_FALSE, glm::value_ptr(model));
-
-		// Get the View matrix and compute the modelView;
-		glm::mat4 view = camera.getView();
-		glm::mat4 model_view = view * model;
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "modelView"), 1, GL_FALSE, glm::value_ptr(model_view));
+		// Write the precomputed matrices into this frame's stream buffer and bind them to the transforms block.
+		GLintptr offset = stream.write(&instance, sizeof(InstanceData));
+		stream.bindRange(Shader::TRANSFORMS_BINDING, offset, sizeof(InstanceData));
 
-		// Get the normal matrix and pass it.
-		glm::mat4 normal_matrix = glm::transpose(glm::inverse(model_view));
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normal_matrix));
-
-		// Draw the actual Geometry
-		glDrawElements(GL_TRIANGLES, (GLsizei) indices.size(), GL_UNSIGNED_INT, 0);
+		// Draw the actual Geometry, through the recorder in case a frame is being recorded.
+		CommandRecorder::drawElements(GL_TRIANGLES, (GLsizei) indices.size(), GL_UNSIGNED_INT, 0);
 
 	}
 
@@ -193,43 +232,4 @@ namespace bgq_opengl {
 
 	}
 
-	void Geometry::resetTransforms() {
-
-		this->transforms = glm::mat4(1.0f);
-
-	}
-
-	void Geometry::rotate(float x, float y, float z, float angle) {
-
-		// Get the angle as radians.
-		float radians = glm::radians(angle);
-
-		// Create a rotation matrix.
-		glm::mat4 identity_matrix(1.0f);
-		glm::mat4 rotation_matrix = glm::rotate(identity_matrix, radians, glm::vec3(x, y, z));
-
-		this->transforms *= rotation_matrix;
-
-	}
-
-	void Geometry::scale(float x, float y, float z) {
-
-		// Create the scale matrix.
-		glm::mat4 identity_matrix(1.0f);
-		glm::mat4 scale_matrix = glm::scale(identity_matrix, glm::vec3(x, y, z));
-
-		this->transforms *= scale_matrix;
-
-	}
-
-	void Geometry::translate(float x, float y, float z) {
-
-		// Get the translation matrix.
-		glm::mat4 trans_matrix = glm::translate(glm::mat4(1.0), glm::vec3(x, y, z));
-
-		// Apply it to the transormations.
-		this->transforms *= trans_matrix;
-
-	}
-
 }  // namespace bgq_opengl
@@ -16,6 +16,7 @@
 #ifndef BGQ_OPENGL_CLASSES_GEOMETRY_H_
 #define BGQ_OPENGL_CLASSES_GEOMETRY_H_
 
+#include <memory>
 #include <vector>
 
 #include "GL/glew.h"
@@ -24,10 +25,12 @@
 
 #include "classes/camera/camera.h"
 #include "classes/shader/shader.h"
+#include "classes/stream_buffer/stream_buffer.h"
 #include "classes/texture/texture.h"
 #include "classes/ebo/ebo.h"
 #include "classes/vbo/vbo.h"
 #include "classes/vao/vao.h"
+#include "structs/instance_data/instance_data.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
 
@@ -52,44 +55,78 @@ namespace bgq_opengl {
 			 * 
 			 * @param vertices Vertices of the object.
 			 * @param indices Indices of the vertices.
-			 * @param textures Textures in connection with this geometry.
+			 * @param textures Textures in connection with this geometry, moved into it.
 			 */
-			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess);
+			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, std::vector<Texture> textures, const float shininess);
 
 			/**
 			 * @brief Get the indices of the geometry.
 			 *
 			 * Get the indices of the geometry.
 			 */
-			std::vector<GLuint> getIndices();
+			const std::vector<GLuint>& getIndices() const;
 			
 			/**
 			 * @brief Get the textures.
 			 *
 			 * Get the textures.
 			 */
-			std::vector<Texture> getTextures();
+			const std::vector<std::shared_ptr<Texture>>& getTextures();
 			
 			/**
 			 * @brief Get the VAO.
 			 *
 			 * Get the VAO.
 			 */
-			VAO getVAO();
+			const VAO& getVAO();
 			
+			/**
+			 * @brief Get the GPU memory of the geometry.
+			 *
+			 * Get the size of the vertex and index buffers in bytes.
+			 *
+			 * @returns The size in bytes.
+			 */
+			size_t getMemorySize();
+
+			/**
+			 * @brief Get the surface area.
+			 *
+			 * Get the area of all the triangles in model space.
+			 *
+			 * @returns The area.
+			 */
+			float getSurfaceArea();
+
+			/**
+			 * @brief Get the UV area.
+			 *
+			 * Get the area all the triangles cover in texture space.
+			 *
+			 * @returns The area, in UV units squared.
+			 */
+			float getUVArea();
+
+			/**
+			 * @brief Removes the geometry from OpenGL.
+			 *
+			 * Deletes the VAO and the vertex and index buffers.
+			 */
+			void remove();
+
 			/**
 			 * @brief Get the vertices of the geometry.
 			 *
 			 * Get the vertices of the geometry.
 			 */
-			std::vector<Vertex> getVertices();
+			const std::vector<Vertex>& getVertices() const;
         
             /**
              * @brief Get the object shininess.
              *
              * Get the object shininess.
              */
-            float getShininess();
+            float getShininess() const;
         
             /**
              * @brief Set the object shininess.
@@ -97,41 +134,28 @@ namespace bgq_opengl {
              * Set the object shininess.
              */
             void setShininess(float shine);
-        
-            /**
-             * @brief Get the current transform matrix.
-             *
-             * Get the current transform matrix.
-             *
-             * @returns The transform matrix.
-             */
-            glm::mat4 getTransformMat();
-        
-            /**
-             * @brief Set the transform matrix.
-             *
-             * Set the transform matrix.
-             *
-             * @param transform The transform matrix.
-             */
-            void setTransformMat(glm::mat4 transform);
-        
+
             /**
              * @brief Add a new texture to the geometry.
              *
-             * Add a new texture that will be passed to the shader.
+             * Add a new texture that will be passed to the shader. Several meshes can
+             * share the same texture, so an image is only uploaded once.
              *
-             * @param image Image containing the texture.
-             * @param name Texture type.
+             * @param texture The texture, shared with whoever else holds it.
              */
-            void addTexture(const char* image, const char* name);
+            void addTexture(const std::shared_ptr<Texture> &texture);
 
 			/**
 			 * @brief Draws the Geometry.
 			 *
 			 * Displays the Geometry in OpenGL.
+			 *
+			 * @param shader The shader used to draw.
+			 * @param camera The camera used to draw.
+			 * @param stream The buffer where the per-draw transforms are written.
+			 * @param instance The precomputed matrices of this draw.
 			 */
-			void draw(Shader &shader, Camera &camera);
+			void draw(Shader &shader, Camera &camera, StreamBuffer &stream, const InstanceData &instance);
 
 			/**
 			 * @brief Gets the bounding box.
@@ -142,61 +166,14 @@ namespace bgq_opengl {
 			 */
 			BoundingBox getBoundingBox();
 
-			/**
-			 * @brief Reset
-			 *
-			 * Add a translation matrix to the model.
-			 */
-			void resetTransforms();
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param x The x rotation.
-			 * @param y The y rotation.
-			 * @param z The z rotation.
-			 * @param angle The angle to rotate.
-			 */
-			void rotate(float x, float y, float z, float angle);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param x The x scale.
-			 * @param y The y scale.
-			 * @param z The z scale.
-			 */
-			void scale(float x, float y, float z);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param x The x translation.
-			 * @param y The y translation.
-			 * @param z The z translation.
-			 */
-			void translate(float x, float y, float z);
-
 		private:
 
-			/**
-			 * @brief Updates the normal matrix.
-			 * 
-			 * Updates the normal matrix so it can be passed to the shader.
-			 */
-			void updateNormalMatrix();
-
 			std::vector<GLuint> indices;				/// Indices of the vertices.
-			std::vector<Texture> textures;				/// Textures that will color this geometry.
+			std::vector<std::shared_ptr<Texture>> textures;	/// Textures that will color this geometry.
 			VAO vao;									/// VAO containing this object.
+			VBO vbo;									/// Buffer with the vertices.
+			EBO ebo;									/// Buffer with the indices.
 			std::vector<Vertex> vertices;				/// Geometry vertices.
-			glm::mat4 transforms = glm::mat4(1.0f);		/// Tranform matrixes that will be passed to the shader.
             float shininess = 1.0;
 
 	};
@@ -0,0 +1,232 @@
+/**
+ * @file golden_images.cpp
+ * @brief GoldenImages class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "golden_images.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stb/stb_image.h"
+
+#include "classes/image_writer/image_writer.h"
+#include "classes/job_runner/job_runner.h"
+
+namespace bgq_opengl {
+
+	GoldenImages::GoldenImages() {
+
+	}
+
+	GoldenImages::GoldenImages(const std::string &directory, bool record, int threads) {
+
+		this->directory = directory;
+		this->record = record;
+		this->threads = threads;
+
+		// The first recording starts from nothing.
+		if (record) {
+
+			std::error_code error;
+			std::filesystem::create_directories(directory, error);
+
+		}
+
+	}
+
+	GoldenResult GoldenImages::check(const std::string &name, const std::vector<unsigned char> &pixels, int width, int height) {
+
+		std::string path = this->directory + "/" + name + ".png";
+		std::vector<unsigned char> golden;
+		int golden_width, golden_height;
+		GoldenResult result;
+
+		bool found = GoldenImages::read(path, &golden, &golden_width, &golden_height);
+
+		if (!found && this->record) {
+
+			GoldenImages::write(path, pixels, width, height);
+			result.recorded = true;
+			return result;
+
+		}
+
+		if (!found || golden_width != width || golden_height != height) {
+
+			result.missing = !found;
+			result.passed = false;
+			result.largest_difference = 255;
+			result.different_pixels = 1.0;
+			result.ssim = 0.0;
+
+		} else {
+
+			result = GoldenImages::compare(pixels.data(), golden.data(), width, height, this->threads);
+
+		}
+
+		// Keep what came out next to the golden image, to look at them side by side.
+		if (!result.passed)
+			GoldenImages::write(this->directory + "/" + name + ".failed.png", pixels, width, height);
+
+		return result;
+
+	}
+
+	GoldenResult GoldenImages::compare(const unsigned char* image, const unsigned char* golden, int width, int height, int threads) {
+
+		int bands = (height + GOLDEN_BAND - 1) / GOLDEN_BAND;
+		size_t pixel_count = (size_t) width * height;
+
+		// The luma of both, which the structural similarity looks at.
+		std::vector<float> image_luma(pixel_count), golden_luma(pixel_count);
+		std::vector<int> largest(bands, 0);
+		std::vector<size_t> different(bands, 0);
+
+		JobRunner::run(bands, threads, [&](int band) {
+
+			size_t last = std::min(pixel_count, (size_t) (band + 1) * GOLDEN_BAND * width);
+
+			for (size_t i = (size_t) band * GOLDEN_BAND * width; i < last; i++) {
+
+				const unsigned char* a = image + i * 4;
+				const unsigned char* b = golden + i * 4;
+				int difference = std::max(std::abs(a[0] - b[0]), std::max(std::abs(a[1] - b[1]), std::abs(a[2] - b[2])));
+
+				largest[band] = std::max(largest[band], difference);
+				if (difference > GOLDEN_PIXEL_TOLERANCE)
+					different[band]++;
+
+				image_luma[i] = 0.299f * a[0] + 0.587f * a[1] + 0.114f * a[2];
+				golden_luma[i] = 0.299f * b[0] + 0.587f * b[1] + 0.114f * b[2];
+
+			}
+
+		});
+
+		// Mean structural similarity over square windows, every band taking the windows that start in it.
+		const double c1 = (0.01 * 255.0) * (0.01 * 255.0);
+		const double c2 = (0.03 * 255.0) * (0.03 * 255.0);
+		const double samples = GOLDEN_SSIM_WINDOW * GOLDEN_SSIM_WINDOW;
+		std::vector<double> similarity(bands, 0.0);
+		std::vector<size_t> windows(bands, 0);
+
+		JobRunner::run(bands, threads, [&](int band) {
+
+			int first = band * GOLDEN_BAND;
+			first = (first + GOLDEN_SSIM_STRIDE - 1) / GOLDEN_SSIM_STRIDE * GOLDEN_SSIM_STRIDE;
+
+			for (int y = first; y < (band + 1) * GOLDEN_BAND && y + GOLDEN_SSIM_WINDOW <= height; y += GOLDEN_SSIM_STRIDE) {
+
+				for (int x = 0; x + GOLDEN_SSIM_WINDOW <= width; x += GOLDEN_SSIM_STRIDE) {
+
+					double sum_a = 0.0, sum_b = 0.0, sum_aa = 0.0, sum_bb = 0.0, sum_ab = 0.0;
+
+					for (int j = 0; j < GOLDEN_SSIM_WINDOW; j++) {
+
+						const float* row_a = &image_luma[(size_t) (y + j) * width + x];
+						const float* row_b = &golden_luma[(size_t) (y + j) * width + x];
+
+						for (int i = 0; i < GOLDEN_SSIM_WINDOW; i++) {
+
+							sum_a += row_a[i];
+							sum_b += row_b[i];
+							sum_aa += row_a[i] * row_a[i];
+							sum_bb += row_b[i] * row_b[i];
+							sum_ab += row_a[i] * row_b[i];
+
+						}
+
+					}
+
+					double mean_a = sum_a / samples, mean_b = sum_b / samples;
+					double variance_a = sum_aa / samples - mean_a * mean_a;
+					double variance_b = sum_bb / samples - mean_b * mean_b;
+					double covariance = sum_ab / samples - mean_a * mean_b;
+
+					similarity[band] += (2.0 * mean_a * mean_b + c1) * (2.0 * covariance + c2) / ((mean_a * mean_a + mean_b * mean_b + c1) * (variance_a + variance_b + c2));
+					windows[band]++;
+
+				}
+
+			}
+
+		});
+
+		// Add the bands up in order, so the result does not depend on the threads.
+		GoldenResult result;
+		size_t different_count = 0, window_count = 0;
+		double similarity_sum = 0.0;
+
+		for (int band = 0; band < bands; band++) {
+
+			result.largest_difference = std::max(result.largest_difference, largest[band]);
+			different_count += different[band];
+			similarity_sum += similarity[band];
+			window_count += windows[band];
+
+		}
+
+		result.different_pixels = pixel_count > 0 ? (double) different_count / pixel_count : 0.0;
+		result.ssim = window_count > 0 ? similarity_sum / window_count : 1.0;
+		result.passed = result.different_pixels <= GOLDEN_DIFFERENT_PIXELS && result.ssim >= GOLDEN_MIN_SSIM;
+
+		return result;
+
+	}
+
+	bool GoldenImages::read(const std::string &path, std::vector<unsigned char>* pixels, int* width, int* height) {
+
+		// Flipped, so the bottom row comes first as in the rendered ones.
+		stbi_set_flip_vertically_on_load(true);
+
+		int channels;
+		unsigned char* image_bytes = stbi_load(path.c_str(), width, height, &channels, 4);
+
+		if (image_bytes == nullptr)
+			return false;
+
+		pixels->assign(image_bytes, image_bytes + (size_t) *width * *height * 4);
+		stbi_image_free(image_bytes);
+
+		return true;
+
+	}
+
+	void GoldenImages::write(const std::string &path, const std::vector<unsigned char> &pixels, int width, int height) {
+
+		FILE* file = fopen(path.c_str(), "wb");
+
+		if (file == nullptr) {
+
+			std::cerr << "GoldenImages error - Could not write " << path << "." << std::endl;
+			exit(1);
+
+		}
+
+		std::vector<unsigned char> png = ImageWriter::encodePNG(pixels, width, height);
+
+		if (fwrite(png.data(), 1, png.size(), file) != png.size())
+			std::cerr << "GoldenImages error - Could not write " << path << "." << std::endl;
+
+		fclose(file);
+
+	}
+
+}  // namespace bgq_opengl
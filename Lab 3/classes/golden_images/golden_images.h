@@ -0,0 +1,145 @@
+/**
+ * @file golden_images.h
+ * @brief GoldenImages class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GOLDEN_IMAGES_H_
+#define BGQ_OPENGL_CLASSES_GOLDEN_IMAGES_H_
+
+#define GOLDEN_PIXEL_TOLERANCE 8		/// Largest difference of a channel for a pixel to still count as the same.
+#define GOLDEN_DIFFERENT_PIXELS 0.001	/// Largest fraction of the pixels that may be different.
+#define GOLDEN_MIN_SSIM 0.99			/// Smallest mean structural similarity allowed.
+#define GOLDEN_SSIM_WINDOW 8			/// Pixels along each side of the structural similarity windows.
+#define GOLDEN_SSIM_STRIDE 4			/// Pixels between two structural similarity windows.
+#define GOLDEN_BAND 32					/// Rows of pixels every job compares.
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "structs/golden_result/golden_result.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a GoldenImages class.
+	 *
+	 * Keeps a directory of golden images and checks rendered images against
+	 * them, so changes to the shaders or the vertex formats can be told apart
+	 * from changes to what ends up on screen.
+	 *
+	 * An image passes if few enough of its pixels have a channel off by more
+	 * than a tolerance, which lets rounding and driver noise through, and if
+	 * the mean structural similarity of its luma over small windows stays
+	 * high, which catches the shifts and blurs a few bad pixels would not.
+	 * Both are worked out in bands of rows on every core.
+	 *
+	 * The images are kept as PNG, which stb_image reads back. An image
+	 * with no golden image fails, unless recording, when it becomes it. One
+	 * that fails is written next to where its golden image goes so the two can
+	 * be looked at.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GoldenImages {
+
+		public:
+
+			/**
+			 * @brief Construct the golden images.
+			 *
+			 * Construct an empty set of golden images.
+			 */
+			GoldenImages();
+
+			/**
+			 * @brief Construct the golden images.
+			 *
+			 * Construct the golden images kept in a directory, which has to exist
+			 * unless recording, which creates it.
+			 *
+			 * @param directory The directory.
+			 * @param record Whether the images with no golden image become it instead of failing.
+			 * @param threads Number of threads comparing, or 0 for one per core.
+			 */
+			GoldenImages(const std::string &directory, bool record = false, int threads = 0);
+
+			/**
+			 * @brief Checks an image.
+			 *
+			 * Compares an image with the golden image of the same name. If there
+			 * is none it fails, or becomes the golden image when recording.
+			 *
+			 * @param name The name of the image, without extension.
+			 * @param pixels The image, RGBA8 with the bottom row first as glReadPixels gives it.
+			 * @param width Width of the image in pixels.
+			 * @param height Height of the image in pixels.
+			 *
+			 * @returns How the image compares.
+			 */
+			GoldenResult check(const std::string &name, const std::vector<unsigned char> &pixels, int width, int height);
+
+			/**
+			 * @brief Compares two images.
+			 *
+			 * Compares two images of the same size and tells whether they are
+			 * within the tolerances.
+			 *
+			 * @param image The image, RGBA8.
+			 * @param golden The golden image, RGBA8.
+			 * @param width Width of the images in pixels.
+			 * @param height Height of the images in pixels.
+			 * @param threads Number of threads, or 0 for one per core.
+			 *
+			 * @returns How the image compares.
+			 */
+			static GoldenResult compare(const unsigned char* image, const unsigned char* golden, int width, int height, int threads = 0);
+
+		private:
+
+			/**
+			 * @brief Reads an image.
+			 *
+			 * Reads an image as RGBA8 with the bottom row first.
+			 *
+			 * @param path The file.
+			 * @param pixels Output for the pixels.
+			 * @param width Output for the width in pixels.
+			 * @param height Output for the height in pixels.
+			 *
+			 * @returns False if there is no such image.
+			 */
+			static bool read(const std::string &path, std::vector<unsigned char>* pixels, int* width, int* height);
+
+			/**
+			 * @brief Writes an image.
+			 *
+			 * Writes an RGBA8 image with the bottom row first as a PNG, without
+			 * the alpha.
+			 *
+			 * @param path The file.
+			 * @param pixels The pixels.
+			 * @param width Width of the image in pixels.
+			 * @param height Height of the image in pixels.
+			 */
+			static void write(const std::string &path, const std::vector<unsigned char> &pixels, int width, int height);
+
+			std::string directory;	/// Directory of the golden images.
+			bool record = false;	/// Whether the missing golden images are recorded.
+			int threads = 0;		/// Number of threads comparing, or 0 for one per core.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_GOLDEN_IMAGES_H_
@@ -0,0 +1,275 @@
+/**
+ * @file image_writer.cpp
+ * @brief ImageWriter class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+#include "image_writer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "stb/stb_image_write.h"
+
+#include "classes/job_runner/job_runner.h"
+
+namespace bgq_opengl {
+
+	ImageWriter::ImageWriter() {
+
+	}
+
+	ImageWriter::~ImageWriter() {
+
+		this->stop();
+
+	}
+
+	void ImageWriter::start(int threads) {
+
+		this->stop();
+
+		threads = JobRunner::getThreads(threads);
+		this->running = true;
+
+		// Every job of the runner takes images off the queue until it stops, so the pool lives in a thread of its own.
+		this->pool = std::thread([this, threads]() { JobRunner::run(threads, threads, [this](int) { this->run(); }); });
+
+	}
+
+	void ImageWriter::write(ImageJob job) {
+
+		if (!this->pool.joinable())
+			this->start();
+
+		{
+
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->idle.wait(lock, [this] { return this->pending.size() < IMAGE_WRITER_QUEUE; });
+			this->pending.push_back(std::move(job));
+
+		}
+
+		this->wake.notify_one();
+
+	}
+
+	void ImageWriter::wait() {
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->idle.wait(lock, [this] { return this->pending.empty() && this->busy == 0; });
+
+	}
+
+	void ImageWriter::stop() {
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->running = false;
+
+		}
+
+		this->wake.notify_all();
+
+		// The threads finish the queue before they leave.
+		if (this->pool.joinable())
+			this->pool.join();
+
+	}
+
+	std::vector<unsigned char> ImageWriter::encodePNG(const std::vector<unsigned char> &pixels, int width, int height) {
+
+		// Drop the alpha and put the top row first.
+		size_t stride = (size_t) width * 3;
+		std::vector<unsigned char> rgb(stride * height);
+
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				memcpy(&rgb[(height - 1 - y) * stride + (size_t) x * 3], &pixels[((size_t) y * width + x) * 4], 3);
+
+		// stb picks the filter of every row and deflates them.
+		std::vector<unsigned char> file;
+
+		auto append = [](void* context, void* data, int size) {
+
+			std::vector<unsigned char>* file = (std::vector<unsigned char>*) context;
+			file->insert(file->end(), (unsigned char*) data, (unsigned char*) data + size);
+
+		};
+
+		if (!stbi_write_png_to_func(append, &file, width, height, 3, rgb.data(), (int) stride)) {
+
+			std::cerr << "ImageWriter error - Could not encode a " << width << "x" << height << " image." << std::endl;
+			exit(1);
+
+		}
+
+		return file;
+
+	}
+
+	std::vector<unsigned char> ImageWriter::encodeEXR(const std::vector<unsigned char> &pixels, int width, int height) {
+
+		std::vector<unsigned char> file;
+
+		auto push32 = [&file](uint32_t value) {
+
+			for (int shift = 0; shift < 32; shift += 8)
+				file.push_back((unsigned char) (value >> shift));
+
+		};
+
+		auto pushFloat = [&push32](float value) {
+
+			uint32_t bits;
+			memcpy(&bits, &value, 4);
+			push32(bits);
+
+		};
+
+		auto attribute = [&](const char* name, const char* type, uint32_t size) {
+
+			file.insert(file.end(), name, name + strlen(name) + 1);
+			file.insert(file.end(), type, type + strlen(type) + 1);
+			push32(size);
+
+		};
+
+		// Magic number and version 2, single part scanlines.
+		push32(20000630);
+		push32(2);
+
+		// The channels go in alphabetical order, all half floats sampled once per pixel.
+		const char* channels[3] = { "B", "G", "R" };
+		attribute("channels", "chlist", 3 * 18 + 1);
+
+		for (int i = 0; i < 3; i++) {
+
+			file.insert(file.end(), channels[i], channels[i] + 2);
+			push32(1);
+			push32(0);
+			push32(1);
+			push32(1);
+
+		}
+
+		file.push_back(0);
+
+		attribute("compression", "compression", 1);
+		file.push_back(0);
+
+		for (const char* window : { "dataWindow", "displayWindow" }) {
+
+			attribute(window, "box2i", 16);
+			push32(0);
+			push32(0);
+			push32((uint32_t) (width - 1));
+			push32((uint32_t) (height - 1));
+
+		}
+
+		attribute("lineOrder", "lineOrder", 1);
+		file.push_back(0);
+
+		attribute("pixelAspectRatio", "float", 4);
+		pushFloat(1.0f);
+
+		attribute("screenWindowCenter", "v2f", 8);
+		pushFloat(0.0f);
+		pushFloat(0.0f);
+
+		attribute("screenWindowWidth", "float", 4);
+		pushFloat(1.0f);
+
+		file.push_back(0);
+
+		// Where every scanline starts, each one a block of its own.
+		size_t line_size = (size_t) width * 3 * 2;
+		size_t first_line = file.size() + (size_t) height * 8;
+
+		for (int y = 0; y < height; y++) {
+
+			uint64_t offset = first_line + (size_t) y * (line_size + 8);
+			push32((uint32_t) offset);
+			push32((uint32_t) (offset >> 32));
+
+		}
+
+		// The top row is y = 0, and every line holds all the blues, then greens, then reds.
+		const int sources[3] = { 2, 1, 0 };
+
+		for (int y = 0; y < height; y++) {
+
+			push32((uint32_t) y);
+			push32((uint32_t) line_size);
+
+			const unsigned char* row = &pixels[(size_t) (height - 1 - y) * width * 8];
+
+			for (int channel = 0; channel < 3; channel++)
+				for (int x = 0; x < width; x++)
+					file.insert(file.end(), row + (size_t) x * 8 + sources[channel] * 2, row + (size_t) x * 8 + sources[channel] * 2 + 2);
+
+		}
+
+		return file;
+
+	}
+
+	void ImageWriter::run() {
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		while (true) {
+
+			this->wake.wait(lock, [this] { return !this->running || !this->pending.empty(); });
+
+			if (this->pending.empty())
+				break;
+
+			ImageJob job = std::move(this->pending.front());
+			this->pending.pop_front();
+			this->busy++;
+
+			// Encode without holding the lock, so the others keep going.
+			lock.unlock();
+			this->idle.notify_all();
+
+			std::vector<unsigned char> file = job.format == IMAGE_FORMAT_EXR ? ImageWriter::encodeEXR(job.pixels, job.width, job.height) : ImageWriter::encodePNG(job.pixels, job.width, job.height);
+			FILE* out = fopen(job.path.c_str(), "wb");
+
+			if (out == nullptr || fwrite(file.data(), 1, file.size(), out) != file.size())
+				std::cerr << "ImageWriter error - Could not write " << job.path << "." << std::endl;
+
+			if (out != nullptr)
+				fclose(out);
+
+			lock.lock();
+			this->busy--;
+			this->idle.notify_all();
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
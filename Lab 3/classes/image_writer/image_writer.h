@@ -0,0 +1,147 @@
+/**
+ * @file image_writer.h
+ * @brief ImageWriter class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_IMAGE_WRITER_H_
+#define BGQ_OPENGL_CLASSES_IMAGE_WRITER_H_
+
+#define IMAGE_FORMAT_PNG 0			/// 8 bit RGB PNG, from RGBA8 pixels.
+#define IMAGE_FORMAT_EXR 1			/// Half float RGB OpenEXR, from RGBA16F pixels.
+
+#define IMAGE_WRITER_QUEUE 8		/// Images that can wait before write blocks.
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "structs/image_job/image_job.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of an ImageWriter class.
+	 *
+	 * Encodes and writes images on a pool of threads, so whoever renders them
+	 * only has to hand the pixels over. At most IMAGE_WRITER_QUEUE images wait
+	 * at once, and write blocks when there are more, so a renderer faster than
+	 * the disk does not use up the memory.
+	 *
+	 * PNGs are encoded by stb_image_write, and EXRs are written as
+	 * uncompressed half float scanlines.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ImageWriter {
+
+		public:
+
+			/**
+			 * @brief Construct the writer.
+			 *
+			 * Construct a writer that does nothing until started.
+			 */
+			ImageWriter();
+
+			/**
+			 * @brief Destroy the writer.
+			 *
+			 * Writes whatever is waiting and stops the threads.
+			 */
+			~ImageWriter();
+
+			/**
+			 * @brief Start writing.
+			 *
+			 * Starts the threads that encode and write the images.
+			 *
+			 * @param threads Number of threads, or 0 for one per core.
+			 */
+			void start(int threads = 0);
+
+			/**
+			 * @brief Queues an image.
+			 *
+			 * Queues an image to be encoded and written, waiting if too many are
+			 * waiting already.
+			 *
+			 * @param job The image.
+			 */
+			void write(ImageJob job);
+
+			/**
+			 * @brief Waits for the images.
+			 *
+			 * Waits until every queued image is written.
+			 */
+			void wait();
+
+			/**
+			 * @brief Stop writing.
+			 *
+			 * Writes whatever is waiting and stops the threads.
+			 */
+			void stop();
+
+			/**
+			 * @brief Encodes a PNG.
+			 *
+			 * Encodes an RGBA8 image as an RGB PNG, with the top row first.
+			 *
+			 * @param pixels The pixels, bottom row first.
+			 * @param width Width in pixels.
+			 * @param height Height in pixels.
+			 *
+			 * @returns The file.
+			 */
+			static std::vector<unsigned char> encodePNG(const std::vector<unsigned char> &pixels, int width, int height);
+
+			/**
+			 * @brief Encodes an EXR.
+			 *
+			 * Encodes an RGBA16F image as an uncompressed half float RGB EXR, with
+			 * the top row first.
+			 *
+			 * @param pixels The pixels, bottom row first.
+			 * @param width Width in pixels.
+			 * @param height Height in pixels.
+			 *
+			 * @returns The file.
+			 */
+			static std::vector<unsigned char> encodeEXR(const std::vector<unsigned char> &pixels, int width, int height);
+
+		private:
+
+			/**
+			 * @brief Body of the threads.
+			 *
+			 * Encodes and writes the queued images until stopped.
+			 */
+			void run();
+
+			std::deque<ImageJob> pending;		/// Images waiting to be written.
+			std::mutex mutex;					/// Guards the queue and the count of busy threads.
+			std::condition_variable wake;		/// Wakes the threads up when there is an image.
+			std::condition_variable idle;		/// Wakes up write and wait when an image is taken or written.
+			std::thread pool;					/// Runs the threads, and returns once they are all done.
+			int busy = 0;						/// Threads writing an image.
+			bool running = false;				/// Whether the threads should keep going.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_IMAGE_WRITER_H_
@@ -0,0 +1,251 @@
+/**
+ * @file instance_batch.cpp
+ * @brief InstanceBatch class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "instance_batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "structs/instance_data/instance_data.h"
+
+namespace bgq_opengl {
+
+	// Four floats processed as one register. The compiler maps it to SSE on x86 and NEON on arm64.
+	typedef float float4 __attribute__((vector_size(16)));
+
+	void InstanceBatch::clear() {
+
+		this->instances.clear();
+		this->uniform_scales.clear();
+
+	}
+
+	size_t InstanceBatch::add(const glm::mat4 &model, bool uniform_scale, int material) {
+
+		InstanceData instance;
+		instance.model = model;
+		instance.material = material;
+
+		this->instances.push_back(instance);
+		this->uniform_scales.push_back(uniform_scale);
+
+		return this->instances.size() - 1;
+
+	}
+
+	void InstanceBatch::compute(const glm::mat4 &view) {
+
+		this->general.clear();
+
+		for (size_t i = 0; i < this->instances.size(); i++) {
+
+			InstanceData &instance = this->instances[i];
+			instance.model_view = view * instance.model;
+
+			if (!this->uniform_scales[i]) {
+
+				// Leave it for the batched inverse.
+				this->general.push_back(i);
+				continue;
+
+			}
+
+			// With a uniform scale s the inverse transpose is just the matrix divided by s^2.
+			glm::vec3 x_axis = glm::vec3(instance.model_view[0]);
+			float inv_scale_sq = 1.0f / glm::dot(x_axis, x_axis);
+
+			glm::mat4 normal_matrix = glm::mat4(glm::mat3(instance.model_view) * inv_scale_sq);
+			instance.normal_matrix = normal_matrix;
+
+		}
+
+		InstanceBatch::computeNormalMatrices(this->instances.data(), this->general.data(), this->general.size());
+
+	}
+
+	const InstanceData& InstanceBatch::get(size_t index) const {
+
+		return this->instances[index];
+
+	}
+
+	size_t InstanceBatch::size() const {
+
+		return this->instances.size();
+
+	}
+
+	void InstanceBatch::computeNormalMatrices(InstanceData* instances, const size_t* indices, size_t count) {
+
+		size_t i = 0;
+
+		// Four matrices at a time, one per lane.
+		for (; i + 4 <= count; i += 4) {
+
+			const float* m0 = &instances[indices[i]].model_view[0][0];
+			const float* m1 = &instances[indices[i + 1]].model_view[0][0];
+			const float* m2 = &instances[indices[i + 2]].model_view[0][0];
+			const float* m3 = &instances[indices[i + 3]].model_view[0][0];
+
+			// Transpose the upper 3x3 of the four matrices into lanes.
+			float4 a00 = { m0[0], m1[0], m2[0], m3[0] };
+			float4 a01 = { m0[1], m1[1], m2[1], m3[1] };
+			float4 a02 = { m0[2], m1[2], m2[2], m3[2] };
+			float4 a10 = { m0[4], m1[4], m2[4], m3[4] };
+			float4 a11 = { m0[5], m1[5], m2[5], m3[5] };
+			float4 a12 = { m0[6], m1[6], m2[6], m3[6] };
+			float4 a20 = { m0[8], m1[8], m2[8], m3[8] };
+			float4 a21 = { m0[9], m1[9], m2[9], m3[9] };
+			float4 a22 = { m0[10], m1[10], m2[10], m3[10] };
+
+			// The inverse transpose is the cofactor matrix divided by the determinant.
+			float4 r00 = a11 * a22 - a12 * a21;
+			float4 r01 = a12 * a20 - a10 * a22;
+			float4 r02 = a10 * a21 - a11 * a20;
+			float4 r10 = a21 * a02 - a22 * a01;
+			float4 r11 = a22 * a00 - a20 * a02;
+			float4 r12 = a20 * a01 - a21 * a00;
+			float4 r20 = a01 * a12 - a02 * a11;
+			float4 r21 = a02 * a10 - a00 * a12;
+			float4 r22 = a00 * a11 - a01 * a10;
+
+			float4 inv_det = 1.0f / (a00 * r00 + a01 * r01 + a02 * r02);
+
+			r00 *= inv_det; r01 *= inv_det; r02 *= inv_det;
+			r10 *= inv_det; r11 *= inv_det; r12 *= inv_det;
+			r20 *= inv_det; r21 *= inv_det; r22 *= inv_det;
+
+			// Scatter the lanes back.
+			for (int lane = 0; lane < 4; lane++) {
+
+				float* n = &instances[indices[i + lane]].normal_matrix[0][0];
+
+				n[0] = r00[lane]; n[1] = r01[lane]; n[2] = r02[lane]; n[3] = 0.0f;
+				n[4] = r10[lane]; n[5] = r11[lane]; n[6] = r12[lane]; n[7] = 0.0f;
+				n[8] = r20[lane]; n[9] = r21[lane]; n[10] = r22[lane]; n[11] = 0.0f;
+				n[12] = 0.0f; n[13] = 0.0f; n[14] = 0.0f; n[15] = 1.0f;
+
+			}
+
+		}
+
+		// Whatever is left, one by one.
+		for (; i < count; i++) {
+
+			InstanceData &instance = instances[indices[i]];
+			instance.normal_matrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(instance.model_view))));
+
+		}
+
+	}
+
+	void InstanceBatch::benchmark(std::ostream &out) {
+
+		const size_t count = 1000000;
+
+		// Random affine models, with the same seed every time.
+		std::mt19937 generator(1);
+		std::uniform_real_distribution<float> random(0.2f, 2.0f);
+
+		std::vector<glm::mat4> models(count);
+
+		for (size_t i = 0; i < count; i++) {
+
+			glm::mat4 model = glm::mat4(1.0f);
+			model = glm::rotate(model, random(generator), glm::normalize(glm::vec3(random(generator), random(generator), random(generator))));
+			model = glm::scale(model, glm::vec3(random(generator), random(generator), random(generator)));
+			model = glm::translate(model, glm::vec3(random(generator)));
+			models[i] = model;
+
+		}
+
+		glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		out << "InstanceBatch benchmark, " << count << " instances, matrix computation only:" << std::endl;
+
+		const char* names[3] = { "per draw 4x4 inverse", "batched, general scale", "batched, uniform scale" };
+		std::vector<InstanceData> reference(count);
+		InstanceBatch batch;
+		float error = 0.0f;
+
+		for (int test = 0; test < 3; test++) {
+
+			// Fill the batch before starting the clock, so only the kernel is timed.
+			if (test > 0) {
+
+				batch.clear();
+
+				for (size_t i = 0; i < count; i++)
+					batch.add(models[i], test == 2);
+
+			}
+
+			double best = 0.0;
+
+			for (int run = 0; run < 5; run++) {
+
+				auto start = std::chrono::steady_clock::now();
+
+				if (test == 0) {
+
+					// What every draw call used to do on its own.
+					for (size_t i = 0; i < count; i++) {
+
+						reference[i].model_view = view * models[i];
+						reference[i].normal_matrix = glm::transpose(glm::inverse(reference[i].model_view));
+
+					}
+
+				} else {
+
+					batch.compute(view);
+
+				}
+
+				double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				if (run == 0 || ms < best)
+					best = ms;
+
+			}
+
+			out << "    " << names[test] << ": " << std::fixed << std::setprecision(3) << best << " ms" << std::endl;
+			out.unsetf(std::ios::floatfield);
+
+			// How far the batched general path is from the full inverse.
+			if (test == 1) {
+
+				for (size_t i = 0; i < count; i++)
+					for (int c = 0; c < 3; c++)
+						for (int r = 0; r < 3; r++)
+							error = std::max(error, std::fabs(batch.get(i).normal_matrix[c][r] - reference[i].normal_matrix[c][r]) / (1e-3f + std::fabs(reference[i].normal_matrix[c][r])));
+
+			}
+
+		}
+
+		out << "    largest relative error: " << error << std::endl;
+
+	}
+
+}  // namespace bgq_opengl
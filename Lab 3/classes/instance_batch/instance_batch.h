@@ -0,0 +1,125 @@
+/**
+ * @file instance_batch.h
+ * @brief InstanceBatch class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_INSTANCE_BATCH_H_
+#define BGQ_OPENGL_CLASSES_INSTANCE_BATCH_H_
+
+#include <ostream>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "structs/instance_data/instance_data.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of an InstanceBatch class.
+	 *
+	 * Collects the model matrices of everything that will be drawn in a frame and
+	 * computes their model view and normal matrices in bulk, so the draw calls
+	 * only have to upload them.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class InstanceBatch {
+
+		public:
+
+			/**
+			 * @brief Empties the batch.
+			 *
+			 * Removes all the instances from the batch.
+			 */
+			void clear();
+
+			/**
+			 * @brief Adds an instance to the batch.
+			 *
+			 * Adds an instance to the batch.
+			 *
+			 * @param model The model matrix of the instance.
+			 * @param uniform_scale Whether the model matrix scales all axes equally.
+			 * @param material The layer of the material in the texture arrays.
+			 *
+			 * @returns The index of the instance within the batch.
+			 */
+			size_t add(const glm::mat4 &model, bool uniform_scale = false, int material = 0);
+
+			/**
+			 * @brief Computes the instance matrices.
+			 *
+			 * Computes the model view and normal matrices of every instance.
+			 *
+			 * @param view The view matrix of the camera.
+			 */
+			void compute(const glm::mat4 &view);
+
+			/**
+			 * @brief Get the data of an instance.
+			 *
+			 * Get the data of an instance as of the last compute.
+			 *
+			 * @param index The index returned by add.
+			 *
+			 * @returns The instance data.
+			 */
+			const InstanceData& get(size_t index) const;
+
+			/**
+			 * @brief Get the number of instances.
+			 *
+			 * Get the number of instances in the batch.
+			 *
+			 * @returns The number of instances.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Computes normal matrices in bulk.
+			 *
+			 * Writes the inverse transpose of the upper 3x3 of every model view into
+			 * its normal matrix, four instances at a time.
+			 *
+			 * @param instances The instances, with their model view already set.
+			 * @param indices The indices of the instances to process.
+			 * @param count The number of indices.
+			 */
+			static void computeNormalMatrices(InstanceData* instances, const size_t* indices, size_t count);
+
+			/**
+			 * @brief Measures the batch.
+			 *
+			 * Computes the matrices of a million random instances the way the draw
+			 * calls used to, one full 4x4 inverse each, and through the batch with
+			 * general and uniform scales, and prints the best of several runs of
+			 * each. The batch is filled before the clock starts, so only the matrix
+			 * computation is timed.
+			 *
+			 * @param out The stream to print to.
+			 */
+			static void benchmark(std::ostream &out);
+
+		private:
+
+			std::vector<InstanceData> instances;		/// Data of every instance.
+			std::vector<unsigned char> uniform_scales;	/// Whether every instance scales uniformly.
+			std::vector<size_t> general;				/// Scratch list of instances that need a full inverse.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_INSTANCE_BATCH_H_
@@ -0,0 +1,102 @@
+/**
+ * @file job_runner.cpp
+ * @brief JobRunner class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "job_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace bgq_opengl {
+
+	void JobRunner::run(int jobs, int threads, const std::function<void(int)> &job) {
+
+		if (jobs <= 0)
+			return;
+
+		int workers = std::min(JobRunner::getThreads(threads), jobs);
+
+		if (workers == 1) {
+
+			for (int i = 0; i < jobs; i++)
+				job(i);
+
+			return;
+
+		}
+
+		// Every worker owns a range of jobs, packed as first << 32 | end so both ends move together.
+		std::unique_ptr<std::atomic<uint64_t>[]> ranges(new std::atomic<uint64_t>[workers]);
+
+		for (int i = 0; i < workers; i++) {
+
+			uint64_t first = (uint64_t) jobs * i / workers;
+			uint64_t end = (uint64_t) jobs * (i + 1) / workers;
+			ranges[i].store(first << 32 | end);
+
+		}
+
+		auto work = [&](int worker) {
+
+			// Take from the front of the own range.
+			uint64_t range = ranges[worker].load();
+
+			while ((range >> 32) < (range & 0xFFFFFFFF)) {
+
+				if (ranges[worker].compare_exchange_weak(range, range + ((uint64_t) 1 << 32)))
+					job((int) (range >> 32));
+
+			}
+
+			// Then steal from the back of the others.
+			for (int offset = 1; offset < workers; offset++) {
+
+				std::atomic<uint64_t> &victim = ranges[(worker + offset) % workers];
+				range = victim.load();
+
+				while ((range >> 32) < (range & 0xFFFFFFFF)) {
+
+					if (victim.compare_exchange_weak(range, range - 1))
+						job((int) (range & 0xFFFFFFFF) - 1);
+
+				}
+
+			}
+
+		};
+
+		std::vector<std::thread> pool;
+
+		for (int i = 1; i < workers; i++)
+			pool.push_back(std::thread(work, i));
+
+		work(0);
+
+		for (size_t i = 0; i < pool.size(); i++)
+			pool[i].join();
+
+	}
+
+	int JobRunner::getThreads(int threads) {
+
+		return threads > 0 ? threads : std::max(1, (int) std::thread::hardware_concurrency());
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,67 @@
+/**
+ * @file job_runner.h
+ * @brief JobRunner class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_JOB_RUNNER_H_
+#define BGQ_OPENGL_CLASSES_JOB_RUNNER_H_
+
+#include <functional>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a JobRunner class.
+	 *
+	 * Runs a number of independent jobs on several threads and returns once
+	 * all of them are done. The calling thread works too, so one thread runs
+	 * everything in place without starting any other.
+	 *
+	 * Every thread owns a contiguous range of the jobs and takes them from the
+	 * front. Once it runs out it steals from the back of the others, so
+	 * uneven jobs still keep every thread busy until the end.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class JobRunner {
+
+		public:
+
+			/**
+			 * @brief Runs some jobs.
+			 *
+			 * Runs every job once, each on whichever thread gets to it. Never uses
+			 * more threads than there are jobs.
+			 *
+			 * @param jobs The number of jobs.
+			 * @param threads Number of threads, or 0 for one per core.
+			 * @param job Runs a job given its index.
+			 */
+			static void run(int jobs, int threads, const std::function<void(int)> &job);
+
+			/**
+			 * @brief Get the number of threads.
+			 *
+			 * Get the number of threads a count of 0 stands for, one per core.
+			 *
+			 * @param threads Number of threads, or 0 for one per core.
+			 *
+			 * @returns The number of threads, at least one.
+			 */
+			static int getThreads(int threads);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_JOB_RUNNER_H_
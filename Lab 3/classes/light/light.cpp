@@ -36,13 +36,13 @@ namespace bgq_opengl {
 	}
 
 
-	glm::vec4 Light::getColor() {
+	glm::vec4 Light::getColor() const {
 
 		return this->color;
 
 	}
 
-	glm::vec3 Light::getPosition() {
+	glm::vec3 Light::getPosition() const {
 
 		return this->position;
 
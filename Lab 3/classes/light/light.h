@@ -55,14 +55,14 @@ namespace bgq_opengl {
 		 * 
 		 * Get the color of the light.
 		 */
-		glm::vec4 getColor();
+		glm::vec4 getColor() const;
 
 		/**
 		 * @brief Get the position of the light.
 		 * 
 		 * Get the position of the light.
 		 */
-		glm::vec3 getPosition();
+		glm::vec3 getPosition() const;
 
 	private:
 
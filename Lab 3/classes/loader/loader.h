@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "classes/geometry/geometry.h"
+#include "structs/mesh/mesh.h"
 
 namespace bgq_opengl {
 
@@ -51,13 +52,23 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the geometries from the loaded model.
 			 *
-			 * Get the geometries from the loaded model.
+			 * Moves the geometries out of the loaded model, which is left without them.
 			 *
 			 * @param geoms Outputs the geometries returned.
 			 * @param matrices Outputs the transformation matrices.
 			 */
 			virtual void getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) = 0;
 
+			/**
+			 * @brief Get the meshes from the loaded model.
+			 *
+			 * Moves the triangles out of the loaded model without creating any
+			 * OpenGL buffer, so they can be used without a context.
+			 *
+			 * @param meshes Outputs the meshes returned.
+			 */
+			virtual void getMeshes(std::vector<Mesh> *meshes) = 0;
+
 			/**
 			 * @brief Loads the data from the file.
 			 * 
@@ -78,7 +89,7 @@ namespace bgq_opengl {
 
 		protected:
 
-			std::vector<Geometry> geometries;			/// The Geometries loaded by the model loader.
+			std::vector<Mesh> meshes;					/// The meshes loaded by the model loader.
 			const char *filename;						/// Name of the file containing the model.
 			std::vector<glm::mat4> transform_matrixes;	/// Transform matrixes for each Geometry in the object.
 
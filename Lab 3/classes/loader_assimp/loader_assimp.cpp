@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <iostream>
+#include <utility>
 
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -25,6 +26,7 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "structs/mesh/mesh.h"
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
@@ -142,11 +144,12 @@ namespace bgq_opengl {
         
         }
 
-		// Obtain the textures.
-		std::vector<bgq_opengl::Texture> textures = getTextures();
-
-		// Create a Geometry object that contains all this data.
-		this->geometries.push_back(bgq_opengl::Geometry(vertices, indices, textures, shine));
+		// Keep the triangles in memory, the buffers are only made when the geometries are asked for.
+		bgq_opengl::Mesh loaded;
+		loaded.vertices = std::move(vertices);
+		loaded.indices = std::move(indices);
+		loaded.shininess = shine;
+		this->meshes.push_back(std::move(loaded));
 
 	}
 
@@ -171,9 +174,21 @@ namespace bgq_opengl {
 
 	void LoaderAssimp::getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) {
 
-		(*geoms) = this->geometries;
+		geoms->clear();
+
+		// Create a Geometry object for every mesh, with its textures.
+		for (size_t i = 0; i < this->meshes.size(); i++)
+			geoms->push_back(bgq_opengl::Geometry(this->meshes[i].vertices, this->meshes[i].indices, getTextures(), this->meshes[i].shininess));
+
+		this->meshes.clear();
 		(*matrices) = this->transform_matrixes;
 
 	}
 
+	void LoaderAssimp::getMeshes(std::vector<Mesh> *meshes) {
+
+		(*meshes) = std::move(this->meshes);
+
+	}
+
 }
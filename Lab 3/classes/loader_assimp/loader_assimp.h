@@ -48,13 +48,23 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the geometries from the loaded model.
 			 * 
-			 * Get the geometries from the loaded model.
+			 * Moves the geometries out of the loaded model, which is left without them.
 			 * 
 			 * @param geoms Outputs the geometries returned.
 			 * @param matrices Outputs the transformation matrices.
 			 */
 			void getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices);
 
+			/**
+			 * @brief Get the meshes from the loaded model.
+			 *
+			 * Moves the triangles out of the loaded model without creating any
+			 * OpenGL buffer, so they can be used without a context.
+			 *
+			 * @param meshes Outputs the meshes returned.
+			 */
+			void getMeshes(std::vector<Mesh> *meshes);
+
 			/**
 			 * @brief Loads the data from the file.
 		 	 *
@@ -0,0 +1,333 @@
+/**
+ * @file mip_chain.cpp
+ * @brief MipChain class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mip_chain.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stb/stb_image.h"
+
+#include "classes/block_compressor/block_compressor.h"
+
+namespace bgq_opengl {
+
+	MipChain::MipChain() {
+
+	}
+
+	MipChain::MipChain(const std::string &path) {
+
+		this->path = path;
+
+		std::ifstream file(path, std::ios::binary);
+
+		uint32_t header[2] = { 0, 0 };
+		int32_t sizes[5] = { 0, 0, 0, 0, 0 };
+		file.read((char*) header, sizeof(header));
+		file.read((char*) sizes, sizeof(sizes));
+
+		if (!file || header[0] != MIP_CHAIN_MAGIC || header[1] != MIP_CHAIN_VERSION) {
+
+			std::cerr << "MipChain error - " << path << " is not a mip chain." << std::endl;
+			exit(1);
+
+		}
+
+		this->width = sizes[0];
+		this->height = sizes[1];
+		this->layers = sizes[2];
+		this->format = sizes[4];
+
+		this->offsets.resize(sizes[3]);
+		file.read((char*) this->offsets.data(), this->offsets.size() * sizeof(uint64_t));
+
+		if (!file) {
+
+			std::cerr << "MipChain error - " << path << " is truncated." << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	int MipChain::getWidth(int level) const {
+
+		return std::max(1, this->width >> level);
+
+	}
+
+	int MipChain::getHeight(int level) const {
+
+		return std::max(1, this->height >> level);
+
+	}
+
+	int MipChain::getLayers() const {
+
+		return this->layers;
+
+	}
+
+	int MipChain::getLevels() const {
+
+		return (int) this->offsets.size();
+
+	}
+
+	int MipChain::getFormat() const {
+
+		return this->format;
+
+	}
+
+	size_t MipChain::getLevelSize(int level) const {
+
+		return BlockCompressor::getSize(this->getWidth(level), this->getHeight(level), this->format) * this->layers;
+
+	}
+
+	bool MipChain::readLevel(int level, std::vector<unsigned char>* data) const {
+
+		// Every read opens its own stream, so reads from different threads do not share a position.
+		std::ifstream file(this->path, std::ios::binary);
+		file.seekg((std::streamoff) this->offsets[level]);
+
+		data->resize(this->getLevelSize(level));
+		file.read((char*) data->data(), data->size());
+
+		return (bool) file;
+
+	}
+
+	void MipChain::bake(const std::vector<std::string> &images, int format, const std::string &path) {
+
+		int width = 0, height = 0;
+		int layers = (int) images.size();
+
+		// Same as the textures, flip them so they are not upside down.
+		stbi_set_flip_vertically_on_load(true);
+
+		// Load the finest level of every layer.
+		std::vector<unsigned char> level;
+
+		for (int layer = 0; layer < layers; layer++) {
+
+			int image_width, image_height, channels;
+			unsigned char* image_bytes = stbi_load(images[layer].c_str(), &image_width, &image_height, &channels, 4);
+
+			if (image_bytes == nullptr) {
+
+				std::cerr << "MipChain error - Could not load " << images[layer] << ": " << stbi_failure_reason() << std::endl;
+				exit(1);
+
+			}
+
+			if (layer == 0) {
+
+				width = image_width;
+				height = image_height;
+				level.resize((size_t) width * height * 4 * layers);
+
+			} else if (image_width != width || image_height != height) {
+
+				std::cerr << "MipChain error - " << images[layer] << " is " << image_width << "x" << image_height << " but the chain is " << width << "x" << height << "." << std::endl;
+				exit(1);
+
+			}
+
+			memcpy(level.data() + (size_t) width * height * 4 * layer, image_bytes, (size_t) width * height * 4);
+			stbi_image_free(image_bytes);
+
+		}
+
+		MipChain::bake(std::move(level), width, height, layers, format, path);
+
+	}
+
+	void MipChain::bake(std::vector<unsigned char> level, int width, int height, int layers, int format, const std::string &path) {
+
+		int levels = 1;
+		while ((width >> levels) > 0 || (height >> levels) > 0)
+			levels++;
+
+		// Write to a temporary file first, so a crash never leaves a half written chain behind.
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+		std::string temporary = path + ".tmp";
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+		uint32_t header[2] = { MIP_CHAIN_MAGIC, MIP_CHAIN_VERSION };
+		int32_t sizes[5] = { width, height, layers, levels, format };
+		file.write((const char*) header, sizeof(header));
+		file.write((const char*) sizes, sizeof(sizes));
+
+		// The levels go right after the offsets, one after another.
+		std::vector<uint64_t> offsets(levels);
+		uint64_t offset = sizeof(header) + sizeof(sizes) + levels * sizeof(uint64_t);
+
+		for (int i = 0; i < levels; i++) {
+
+			offsets[i] = offset;
+			offset += (uint64_t) BlockCompressor::getSize(std::max(1, width >> i), std::max(1, height >> i), format) * layers;
+
+		}
+
+		file.write((const char*) offsets.data(), offsets.size() * sizeof(uint64_t));
+
+		std::vector<unsigned char> next;
+		std::vector<unsigned char> compressed;
+
+		for (int i = 0; i < levels; i++) {
+
+			int level_width = std::max(1, width >> i);
+			int level_height = std::max(1, height >> i);
+			size_t layer_size = (size_t) level_width * level_height * 4;
+
+			// Every layer is compressed on its own, the next level is filtered from the uncompressed one.
+			size_t compressed_size = BlockCompressor::getSize(level_width, level_height, format);
+			compressed.resize(compressed_size * layers);
+
+			for (int layer = 0; layer < layers; layer++)
+				BlockCompressor::compress(level.data() + layer_size * layer, level_width, level_height, format, compressed.data() + compressed_size * layer);
+
+			file.write((const char*) compressed.data(), compressed.size());
+
+			if (i == levels - 1)
+				break;
+
+			// Filter every layer down on its own.
+			size_t next_layer_size = (size_t) std::max(1, level_width >> 1) * std::max(1, level_height >> 1) * 4;
+			next.resize(next_layer_size * layers);
+
+			for (int layer = 0; layer < layers; layer++)
+				MipChain::downsample(level.data() + layer_size * layer, level_width, level_height, next.data() + next_layer_size * layer);
+
+			level.swap(next);
+
+		}
+
+		file.close();
+
+		if (!file) {
+
+			std::cerr << "MipChain error - Could not write " << temporary << "." << std::endl;
+			exit(1);
+
+		}
+
+		std::filesystem::rename(temporary, path, error);
+
+		if (error) {
+
+			std::cerr << "MipChain error - Could not write " << path << ": " << error.message() << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	bool MipChain::isStale(const std::vector<std::string> &images, int format, const std::string &path) {
+
+		std::error_code error;
+		auto baked = std::filesystem::last_write_time(path, error);
+
+		if (error)
+			return true;
+
+		for (size_t i = 0; i < images.size(); i++) {
+
+			auto modified = std::filesystem::last_write_time(images[i], error);
+			if (error || modified > baked)
+				return true;
+
+		}
+
+		// Chains written by another version of the layout, or in another format, are baked again.
+		std::ifstream file(path, std::ios::binary);
+		uint32_t header[2] = { 0, 0 };
+		int32_t sizes[5] = { 0, 0, 0, 0, 0 };
+		file.read((char*) header, sizeof(header));
+		file.read((char*) sizes, sizeof(sizes));
+
+		return !file || header[0] != MIP_CHAIN_MAGIC || header[1] != MIP_CHAIN_VERSION || sizes[4] != format;
+
+	}
+
+	std::string MipChain::makeFilename(const std::vector<std::string> &images, int format, const std::string &tag) {
+
+		std::string filename;
+
+		for (size_t i = 0; i < images.size(); i++) {
+
+			if (i > 0)
+				filename += "+";
+
+			filename += std::filesystem::path(images[i]).stem().string();
+
+		}
+
+		std::string suffix = BlockCompressor::getName(format);
+		std::transform(suffix.begin(), suffix.end(), suffix.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+
+		if (!tag.empty())
+			filename += "." + tag;
+
+		return filename + "." + suffix + ".mips";
+
+	}
+
+	void MipChain::downsample(const unsigned char* source, int width, int height, unsigned char* destination) {
+
+		int next_width = std::max(1, width >> 1);
+		int next_height = std::max(1, height >> 1);
+
+		for (int y = 0; y < next_height; y++) {
+
+			// Odd sizes and 1 pixel wide levels reuse the last row or column.
+			int y0 = std::min(y * 2, height - 1);
+			int y1 = std::min(y * 2 + 1, height - 1);
+
+			for (int x = 0; x < next_width; x++) {
+
+				int x0 = std::min(x * 2, width - 1);
+				int x1 = std::min(x * 2 + 1, width - 1);
+
+				const unsigned char* a = source + ((size_t) y0 * width + x0) * 4;
+				const unsigned char* b = source + ((size_t) y0 * width + x1) * 4;
+				const unsigned char* c = source + ((size_t) y1 * width + x0) * 4;
+				const unsigned char* d = source + ((size_t) y1 * width + x1) * 4;
+				unsigned char* out = destination + ((size_t) y * next_width + x) * 4;
+
+				for (int channel = 0; channel < 4; channel++)
+					out[channel] = (unsigned char) ((a[channel] + b[channel] + c[channel] + d[channel] + 2) / 4);
+
+			}
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
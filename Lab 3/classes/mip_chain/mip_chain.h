@@ -0,0 +1,216 @@
+/**
+ * @file mip_chain.h
+ * @brief MipChain class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MIP_CHAIN_H_
+#define BGQ_OPENGL_CLASSES_MIP_CHAIN_H_
+
+#define MIP_CHAIN_MAGIC 0x4D514742	/// "BGQM" read as a little endian integer.
+#define MIP_CHAIN_VERSION 2			/// Bumped whenever the layout changes.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a MipChain class.
+	 *
+	 * Reads the mip levels of a set of images from a file laid out one level
+	 * after another, so any single level can be read without touching the
+	 * rest. Every level holds all the layers, finest level first, either
+	 * RGBA8 or compressed into blocks.
+	 *
+	 * The file starts with the magic, the version, the size, the number of
+	 * layers and of levels, the format, and the offset of every level.
+	 *
+	 * Reading a level only uses the values in the header, so several threads
+	 * can read levels of the same chain at once.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MipChain {
+
+		public:
+
+			/**
+			 * @brief Construct the chain.
+			 *
+			 * Construct an empty chain.
+			 */
+			MipChain();
+
+			/**
+			 * @brief Opens a chain.
+			 *
+			 * Reads the header of a chain file.
+			 *
+			 * @param path The chain file.
+			 */
+			MipChain(const std::string &path);
+
+			/**
+			 * @brief Get the width of a level.
+			 *
+			 * Get the width of a level in pixels.
+			 *
+			 * @param level The level.
+			 *
+			 * @returns The width in pixels.
+			 */
+			int getWidth(int level) const;
+
+			/**
+			 * @brief Get the height of a level.
+			 *
+			 * Get the height of a level in pixels.
+			 *
+			 * @param level The level.
+			 *
+			 * @returns The height in pixels.
+			 */
+			int getHeight(int level) const;
+
+			/**
+			 * @brief Get the number of layers.
+			 *
+			 * Get the number of layers, which is the number of images.
+			 *
+			 * @returns The number of layers.
+			 */
+			int getLayers() const;
+
+			/**
+			 * @brief Get the number of levels.
+			 *
+			 * Get the number of levels, down to 1x1.
+			 *
+			 * @returns The number of levels.
+			 */
+			int getLevels() const;
+
+			/**
+			 * @brief Get the format.
+			 *
+			 * Get the format the levels are stored in.
+			 *
+			 * @returns One of the TEXTURE_FORMAT_ values.
+			 */
+			int getFormat() const;
+
+			/**
+			 * @brief Get the size of a level.
+			 *
+			 * Get the size of a level as stored, all layers included.
+			 *
+			 * @param level The level.
+			 *
+			 * @returns The size in bytes.
+			 */
+			size_t getLevelSize(int level) const;
+
+			/**
+			 * @brief Reads a level.
+			 *
+			 * Reads every layer of a level from the file.
+			 *
+			 * @param level The level.
+			 * @param data Output variable for the pixels, layer after layer.
+			 *
+			 * @returns True if the level could be read.
+			 */
+			bool readLevel(int level, std::vector<unsigned char>* data) const;
+
+			/**
+			 * @brief Builds a chain file.
+			 *
+			 * Loads the images, filters them down to 1x1, compresses every level
+			 * and writes it. All the images must have the same size.
+			 *
+			 * @param images The images, one per layer.
+			 * @param format The format to store the levels in.
+			 * @param path The chain file to write.
+			 */
+			static void bake(const std::vector<std::string> &images, int format, const std::string &path);
+
+			/**
+			 * @brief Builds a chain file from pixels.
+			 *
+			 * Same as baking images, with the finest level already in memory.
+			 *
+			 * @param level The finest level of every layer, RGBA8, layer after layer.
+			 * @param width The width of the finest level.
+			 * @param height The height of the finest level.
+			 * @param layers The number of layers.
+			 * @param format The format to store the levels in.
+			 * @param path The chain file to write.
+			 */
+			static void bake(std::vector<unsigned char> level, int width, int height, int layers, int format, const std::string &path);
+
+			/**
+			 * @brief Check whether a chain file is out of date.
+			 *
+			 * Check whether a chain file is missing, from an older version, in
+			 * another format, or older than any of its images.
+			 *
+			 * @param images The images, one per layer.
+			 * @param format The format the levels should be in.
+			 * @param path The chain file.
+			 *
+			 * @returns True if the file has to be baked again.
+			 */
+			static bool isStale(const std::vector<std::string> &images, int format, const std::string &path);
+
+			/**
+			 * @brief Builds the filename of a chain.
+			 *
+			 * Builds the filename of the chain of some images from their names
+			 * and the format, so every format gets its own file.
+			 *
+			 * @param images The images, one per layer.
+			 * @param format The format of the levels.
+			 * @param tag What the images were turned into, if anything.
+			 *
+			 * @returns The filename, without a directory.
+			 */
+			static std::string makeFilename(const std::vector<std::string> &images, int format, const std::string &tag = "");
+
+			/**
+			 * @brief Halves a level.
+			 *
+			 * Builds the next level of an RGBA8 image with a box filter.
+			 *
+			 * @param source The pixels of the level.
+			 * @param width The width of the level.
+			 * @param height The height of the level.
+			 * @param destination Output for the pixels of the next level.
+			 */
+			static void downsample(const unsigned char* source, int width, int height, unsigned char* destination);
+
+		private:
+
+			std::string path = "";					/// The chain file.
+			int width = 0;							/// Width of the finest level.
+			int height = 0;							/// Height of the finest level.
+			int layers = 0;							/// Number of layers.
+			int format = 0;							/// Format of the levels.
+			std::vector<uint64_t> offsets;			/// Offset of every level in the file.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_MIP_CHAIN_H_
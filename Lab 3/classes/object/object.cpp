@@ -16,12 +16,16 @@
 #include "object.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <utility>
 
 #include "classes/loader/loader.h"
 #include "classes/loader_assimp/loader_assimp.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/instance_data/instance_data.h"
 
 namespace bgq_opengl {
 
@@ -52,43 +56,83 @@ namespace bgq_opengl {
 
 	Object::Object(std::vector<Geometry> geometries) {
 
-		// Copy the geometries.
-		this->geoms = geometries;
-
 		// Get an identity matrix for each.
 		this->matrices_geoms = std::vector<glm::mat4>(geometries.size(), glm::mat4(1.0f));
 
+		// Take the geometries, they can only be moved.
+		this->geoms = std::move(geometries);
+
 	}
 
-    void Object::addTexture(const char* image, const char* name) {
+    void Object::addTexture(const std::shared_ptr<Texture> &texture) {
         
         // Loop through the geometries contained in this object.
         for (int i = 0; i < this->geoms.size(); i++) {
             
             // Add this texture to the geometry.
-            this->geoms[i].addTexture(image, name);
+            this->geoms[i].addTexture(texture);
             
         }
         
     }
 
-    void Object::addTexture(int num, const char* image, const char* name) {
+    void Object::addTexture(int num, const std::shared_ptr<Texture> &texture) {
         
         // Add this texture to the geometry.
-        this->geoms[num].addTexture(image, name);
+        this->geoms[num].addTexture(texture);
         
     }
 
-	void Object::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera) {
+	void Object::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera, bgq_opengl::StreamBuffer& stream, const InstanceData& instance) {
         
 		// Go over all meshes and draw each one
 		for (unsigned int i = 0; i < this->geoms.size(); i++)
 		{
-			geoms[i].draw(shader, camera);
+			geoms[i].draw(shader, camera, stream, instance);
 		}
         
 	}
 
+	size_t Object::getMemorySize() {
+
+		size_t size = 0;
+
+		for (size_t i = 0; i < this->geoms.size(); i++)
+			size += this->geoms[i].getMemorySize();
+
+		return size;
+
+	}
+
+	float Object::getUVDensity() {
+
+		if (this->uv_density >= 0.0f)
+			return this->uv_density;
+
+		float surface_area = 0.0f;
+		float uv_area = 0.0f;
+
+		for (size_t i = 0; i < this->geoms.size(); i++) {
+
+			surface_area += this->geoms[i].getSurfaceArea();
+			uv_area += this->geoms[i].getUVArea();
+
+		}
+
+		// Areas grow with the square of the lengths.
+		this->uv_density = surface_area > 0.0f ? std::sqrt(uv_area / surface_area) : 0.0f;
+
+		return this->uv_density;
+
+	}
+
+	void Object::remove() {
+
+		for (size_t i = 0; i < this->geoms.size(); i++)
+			this->geoms[i].remove();
+
+	}
+
 	BoundingBox Object::getBoundingBox() {
 
 		// Create the bb.
@@ -124,7 +168,7 @@ namespace bgq_opengl {
 
 	}
 
-	std::vector<Geometry> Object::getGeometries() {
+	const std::vector<Geometry>& Object::getGeometries() {
 
 		return this->geoms;
 
@@ -144,84 +188,10 @@ namespace bgq_opengl {
         
     }
 
-    glm::mat4 Object::getTransformMat(int num) {
-        
-        return this->geoms[num].getTransformMat();
-        
-    }
-
-    void Object::setTransformMat(int num, glm::mat4 transform) {
-        
-        this->geoms[num].setTransformMat(transform);
-        
-    }
-
     size_t Object::getNumOfGeometries() {
         
         return this->geoms.size();
         
     }
 
-	void Object::resetTransforms() {
-
-		// Do the same for the subobjects.
-		for (size_t i = 0; i < geoms.size(); i++) {
-
-			geoms[i].resetTransforms();
-
-		}
-
-	}
-
-	void Object::rotate(float x, float y, float z, float angle) {
-
-		// Do the same for the subobjects.
-		for (size_t i = 0; i < geoms.size(); i++) {
-
-			geoms[i].rotate(x, y, z, angle);
-
-		}
-
-	}
-
-	void Object::rotate(int num, float x, float y, float z, float angle) {
-
-		geoms[num].rotate(x, y, z, angle);
-
-	}
-
-	void Object::scale(float x, float y, float z) {
-
-		// Do the same for the subobjects.
-		for (size_t i = 0; i < geoms.size(); i++) {
-
-			geoms[i].scale(x, y, z);
-
-		}
-
-	}
-
-	void Object::scale(int num, float x, float y, float z) {
-
-		geoms[num].scale(x, y, z);
-
-	}
-
-	void Object::translate(float x, float y, float z) {
-
-		// Do the same for the subobjects.
-		for (size_t i = 0; i < geoms.size(); i++) {
-
-			geoms[i].translate(x, y, z);
-
-		}
-
-	}
-
-	void Object::translate(int num, float x, float y, float z) {
-
-		geoms[num].translate(x, y, z);
-
-	}
-
 }
@@ -16,10 +16,13 @@
 #ifndef BGQ_OPENGL_CLASSES_OBJECT_H_
 #define BGQ_OPENGL_CLASSES_OBJECT_H_
 
+#include <memory>
 #include <vector>
 
 #include "classes/geometry/geometry.h"
+#include "classes/stream_buffer/stream_buffer.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/instance_data/instance_data.h"
 
 namespace bgq_opengl {
 
@@ -49,12 +52,12 @@ namespace bgq_opengl {
             /**
              * @brief Add a new texture to all geometries.
              *
-             * Add a new texture that will be passed to the shader.
+             * Add a new texture that will be passed to the shader. Every geometry
+             * shares the same texture.
              *
-             * @param image Image containing the texture.
-             * @param name Texture type.
+             * @param texture The texture.
              */
-            void addTexture(const char* image, const char* name);
+            void addTexture(const std::shared_ptr<Texture> &texture);
             
             /**
              * @brief Add a new texture to the specified geometry.
@@ -62,17 +65,21 @@ namespace bgq_opengl {
              * Add a new texture that will be passed to the shader.
              *
              * @param num The geometry index this will apply to.
-             * @param image Image containing the texture.
-             * @param name Texture type.
+             * @param texture The texture.
              */
-            void addTexture(int num, const char* image, const char* name);
+            void addTexture(int num, const std::shared_ptr<Texture> &texture);
 
 			/**
-			 * @brief Draws this object.
+			 * @brief Draws this object as an instance.
+			 *
+			 * Draws all the geometries of this object with matrices that were already computed.
 			 *
-			 * Draws this object.
+			 * @param shader The shader used to draw.
+			 * @param camera The camera used to draw.
+			 * @param stream The buffer where the per-draw transforms are written.
+			 * @param instance The precomputed matrices of the instance.
 			 */
-			void draw(Shader &shader, Camera &camera);
+			void draw(Shader &shader, Camera &camera, StreamBuffer &stream, const InstanceData &instance);
 
 			/**
 			 * @brief Gets the bounding box.
@@ -83,12 +90,38 @@ namespace bgq_opengl {
 			 */
 			BoundingBox getBoundingBox();
 
+			/**
+			 * @brief Get the GPU memory of the object.
+			 *
+			 * Get the size of the buffers of all the geometries in bytes.
+			 *
+			 * @returns The size in bytes.
+			 */
+			size_t getMemorySize();
+
+			/**
+			 * @brief Get the UV density.
+			 *
+			 * Get how many UV units there are per unit of model space, on average
+			 * over the surface. Computed the first time and kept.
+			 *
+			 * @returns The UV units per model space unit, along one axis.
+			 */
+			float getUVDensity();
+
+			/**
+			 * @brief Removes the object from OpenGL.
+			 *
+			 * Removes all the geometries from OpenGL.
+			 */
+			void remove();
+
 			/**
 			 * @brief Get the geometries of the object.
 			 * 
 			 * Get the geometries of the object.
 			 */
-			std::vector<Geometry> getGeometries();
+			const std::vector<Geometry>& getGeometries();
 
 			/**
 			 * @brief Get the matrices of the geometries.
@@ -103,28 +136,7 @@ namespace bgq_opengl {
              * Set the object shininess.
              */
             void setShininess(float shine);
-        
-            /**
-             * @brief Get the current transform matrix.
-             *
-             * Get the current transform matrix.
-             *
-             * @param num The geometry index this will apply to.
-             *
-             * @returns The transform matrix.
-             */
-            glm::mat4 getTransformMat(int num);
 
-            /**
-             * @brief Set the transform matrix.
-             *
-             * Set the transform matrix.
-             *
-             * @param num The geometry index this will apply to.
-             * @param transform The transform matrix.
-             */
-            void setTransformMat(int num, glm::mat4 transform);
-        
             /**
              * @brief Get the number of geometries.
              *
@@ -134,89 +146,12 @@ namespace bgq_opengl {
              */
             size_t getNumOfGeometries();
 
-			/**
-			 * @brief Reset 
-			 *
-			 * Add a translation matrix to the model.
-			 */
-			void resetTransforms();
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param x The x rotation.
-			 * @param y The y rotation.
-			 * @param z The z rotation.
-			 * @param angle The angle to rotate.
-			 */
-			void rotate(float x, float y, float z, float angle);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param num The geometry index this will apply to.
-			 * @param x The x rotation.
-			 * @param y The y rotation.
-			 * @param z The z rotation.
-			 * @param angle The angle to rotate.
-			 */
-			void rotate(int num, float x, float y, float z, float angle);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param x The x scale.
-			 * @param y The y scale.
-			 * @param z The z scale.
-			 */
-			void scale(float x, float y, float z);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 *
-			 * @param num The geometry index this will apply to.
-			 * @param x The x scale.
-			 * @param y The y scale.
-			 * @param z The z scale.
-			 */
-			void scale(int num, float x, float y, float z);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 * 
-			 * Add a translation matrix to the model.
-			 * 
-			 * @param x The x translation.
-			 * @param y The y translation.
-			 * @param z The z translation.
-			 */
-			void translate(float x, float y, float z);
-
-			/**
-			 * @brief Add a translation matrix to the model.
-			 *
-			 * Add a translation matrix to the model.
-			 * 
-			 * @param num The geometry index this will apply to.
-			 * @param x The x translation.
-			 * @param y The y translation.
-			 * @param z The z translation.
-			 */
-			void translate(int num, float x, float y, float z);
-
 		private:
 
 			// All the geometries and transformations
 			std::vector<Geometry> geoms;
 			std::vector<glm::mat4> matrices_geoms;
+			float uv_density = -1.0f;	/// UV units per model space unit, or -1 until computed.
 
 	};
 
@@ -0,0 +1,206 @@
+/**
+ * @file program_cache.cpp
+ * @brief ProgramCache class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "program_cache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	ProgramCache::ProgramCache() {
+
+	}
+
+	ProgramCache::ProgramCache(const char* directory) {
+
+		this->directory = directory;
+
+		// Program binaries are only useful if the driver has at least one format for them.
+		GLint num_formats = 0;
+		if (GLEW_ARB_get_program_binary)
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+
+		if (num_formats <= 0) {
+
+			std::cerr << "ProgramCache warning - The driver does not support program binaries, shaders will always be compiled." << std::endl;
+			return;
+
+		}
+
+		// Binaries are only valid for the driver that produced them.
+		this->driver.append((const char*) glGetString(GL_VENDOR));
+		this->driver.append("\n");
+		this->driver.append((const char*) glGetString(GL_RENDERER));
+		this->driver.append("\n");
+		this->driver.append((const char*) glGetString(GL_VERSION));
+
+		// Make sure the directory exists.
+		std::error_code error;
+		std::filesystem::create_directories(this->directory, error);
+
+		if (error) {
+
+			std::cerr << "ProgramCache warning - Could not create the cache directory: " << error.message() << std::endl;
+			return;
+
+		}
+
+		this->enabled = true;
+
+	}
+
+	bool ProgramCache::isEnabled() const {
+
+		return this->enabled;
+
+	}
+
+	std::string ProgramCache::makeKey(const std::string &vertex_source, const std::string &fragment_source, const std::string &defines) const {
+
+		// 64 bit FNV-1a over every input, with a separator so the boundaries matter.
+		uint64_t hash = 14695981039346656037ULL;
+
+		const std::string* parts[] = { &this->driver, &defines, &vertex_source, &fragment_source };
+
+		for (const std::string* part : parts) {
+
+			for (unsigned char c : *part) {
+
+				hash ^= c;
+				hash *= 1099511628211ULL;
+
+			}
+
+			hash ^= 0xff;
+			hash *= 1099511628211ULL;
+
+		}
+
+		char key[17];
+		snprintf(key, sizeof(key), "%016llx", (unsigned long long) hash);
+
+		return std::string(key);
+
+	}
+
+	bool ProgramCache::load(GLuint program, const std::string &key) const {
+
+		if (!this->enabled)
+			return false;
+
+		std::ifstream file(this->getPath(key), std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+			return false;
+
+		// The file holds the binary format followed by the binary itself.
+		std::streamsize file_size = file.tellg();
+
+		if (file_size <= (std::streamsize) sizeof(GLenum))
+			return false;
+
+		file.seekg(0);
+
+		GLenum format = 0;
+		std::vector<char> binary(file_size - sizeof(GLenum));
+		file.read((char*) &format, sizeof(GLenum));
+		file.read(binary.data(), binary.size());
+
+		if (!file)
+			return false;
+
+		glProgramBinary(program, format, binary.data(), (GLsizei) binary.size());
+
+		// The driver may reject binaries from an older version of itself.
+		GLint success = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+		if (!success) {
+
+			std::error_code error;
+			std::filesystem::remove(this->getPath(key), error);
+
+			return false;
+
+		}
+
+		return true;
+
+	}
+
+	void ProgramCache::prepare(GLuint program) const {
+
+		if (this->enabled)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+	}
+
+	void ProgramCache::store(GLuint program, const std::string &key) const {
+
+		if (!this->enabled)
+			return;
+
+		// Copies of a shader may all try to store it, but a key always holds the same binary.
+		std::string path = this->getPath(key);
+		if (std::filesystem::exists(path))
+			return;
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		if (length <= 0)
+			return;
+
+		GLenum format = 0;
+		std::vector<char> binary(length);
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+
+		// Write to a temporary file and rename it, so a crash never leaves half a binary behind.
+		std::string temp_path = path + ".tmp";
+
+		std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+		file.write((const char*) &format, sizeof(GLenum));
+		file.write(binary.data(), length);
+		file.close();
+
+		std::error_code error;
+
+		if (!file) {
+
+			std::cerr << "ProgramCache warning - Could not write the program binary " << path << std::endl;
+			std::filesystem::remove(temp_path, error);
+			return;
+
+		}
+
+		std::filesystem::rename(temp_path, path, error);
+
+	}
+
+	std::string ProgramCache::getPath(const std::string &key) const {
+
+		return (std::filesystem::path(this->directory) / (key + ".bin")).string();
+
+	}
+
+}  // namespace bgq_opengl
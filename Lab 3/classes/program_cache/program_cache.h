@@ -0,0 +1,135 @@
+/**
+ * @file program_cache.h
+ * @brief ProgramCache class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_PROGRAM_CACHE_H_
+#define BGQ_OPENGL_CLASSES_PROGRAM_CACHE_H_
+
+#include <string>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ProgramCache class.
+	 *
+	 * Keeps linked shader program binaries on disk so they can be loaded with
+	 * glProgramBinary instead of being compiled again. Every binary is keyed on
+	 * a hash of the sources, the defines and the driver strings, so a change in
+	 * any of them simply misses the cache.
+	 *
+	 * If the driver exposes no binary formats the cache stays disabled and every
+	 * program is compiled as usual.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ProgramCache {
+
+		public:
+
+			/**
+			 * @brief Construct the cache.
+			 *
+			 * Construct a disabled cache.
+			 */
+			ProgramCache();
+
+			/**
+			 * @brief Construct the cache.
+			 *
+			 * Construct the cache on a directory, creating it if needed. Needs a
+			 * current OpenGL context.
+			 *
+			 * @param directory The directory where the binaries will be stored.
+			 */
+			ProgramCache(const char* directory);
+
+			/**
+			 * @brief Whether the cache can be used.
+			 *
+			 * Whether the driver supports program binaries and the directory exists.
+			 *
+			 * @returns True if the cache is enabled.
+			 */
+			bool isEnabled() const;
+
+			/**
+			 * @brief Builds the key of a program.
+			 *
+			 * Hashes everything that affects the binary of a program into a key.
+			 *
+			 * @param vertex_source The vertex shader source.
+			 * @param fragment_source The fragment shader source.
+			 * @param defines The defines prepended to the sources.
+			 *
+			 * @returns The key, as a hexadecimal string.
+			 */
+			std::string makeKey(const std::string &vertex_source, const std::string &fragment_source, const std::string &defines) const;
+
+			/**
+			 * @brief Loads a program from the cache.
+			 *
+			 * Loads the binary stored under a key into a program. A binary that the
+			 * driver rejects is removed from the cache.
+			 *
+			 * @param program The program that will receive the binary.
+			 * @param key The key of the program.
+			 *
+			 * @returns True if the program was loaded and linked successfully.
+			 */
+			bool load(GLuint program, const std::string &key) const;
+
+			/**
+			 * @brief Prepares a program to be stored.
+			 *
+			 * Asks the driver to keep the binary of a program around. Must be called
+			 * before linking it.
+			 *
+			 * @param program The program.
+			 */
+			void prepare(GLuint program) const;
+
+			/**
+			 * @brief Stores a program in the cache.
+			 *
+			 * Stores the binary of a linked program under a key.
+			 *
+			 * @param program The linked program.
+			 * @param key The key of the program.
+			 */
+			void store(GLuint program, const std::string &key) const;
+
+		private:
+
+			/**
+			 * @brief Get the path of a key.
+			 *
+			 * Get the path of the file that holds the binary of a key.
+			 *
+			 * @param key The key.
+			 *
+			 * @returns The path.
+			 */
+			std::string getPath(const std::string &key) const;
+
+			std::string directory = "";		/// Directory where the binaries live.
+			std::string driver = "";		/// Vendor, renderer and version strings of the driver.
+			bool enabled = false;			/// Whether the cache can be used.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_PROGRAM_CACHE_H_
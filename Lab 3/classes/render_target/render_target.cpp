@@ -0,0 +1,164 @@
+/**
+ * @file render_target.cpp
+ * @brief RenderTarget class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "render_target.h"
+
+#include <iostream>
+#include <utility>
+
+#include "GL/glew.h"
+
+#include "classes/deletion_queue/deletion_queue.h"
+
+namespace bgq_opengl {
+
+	RenderTarget::RenderTarget() {
+
+	}
+
+	RenderTarget::RenderTarget(int width, int height, GLenum color_format, bool depth) {
+
+		this->width = width;
+		this->height = height;
+
+		// Nothing is uploaded, the format and type only have to match the internal format.
+		GLenum pixel_format = color_format == GL_RGBA8UI ? GL_RGBA_INTEGER : GL_RGBA;
+		GLenum pixel_type = color_format == GL_RGBA16F ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+
+		glGenTextures(1, &this->color);
+		glBindTexture(GL_TEXTURE_2D, this->color);
+		glTexImage2D(GL_TEXTURE_2D, 0, color_format, width, height, 0, pixel_format, pixel_type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		if (depth) {
+
+			glGenTextures(1, &this->depth);
+			glBindTexture(GL_TEXTURE_2D, this->depth);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		}
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		GLint previous_framebuffer = 0;
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+		glGenFramebuffers(1, &this->framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, this->framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->color, 0);
+
+		if (depth)
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, this->depth, 0);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+
+			std::cerr << "RenderTarget error - The offscreen framebuffer is incomplete." << std::endl;
+			exit(1);
+
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+
+	}
+
+	RenderTarget::RenderTarget(RenderTarget &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->framebuffer = other.framebuffer;
+		this->color = other.color;
+		this->depth = other.depth;
+		this->width = other.width;
+		this->height = other.height;
+		other.framebuffer = 0;
+		other.color = 0;
+		other.depth = 0;
+
+	}
+
+	RenderTarget& RenderTarget::operator=(RenderTarget &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->framebuffer = other.framebuffer;
+		this->color = other.color;
+		this->depth = other.depth;
+		this->width = other.width;
+		this->height = other.height;
+		other.framebuffer = 0;
+		other.color = 0;
+		other.depth = 0;
+
+		return *this;
+
+	}
+
+	RenderTarget::~RenderTarget() {
+
+		this->remove();
+
+	}
+
+	void RenderTarget::bind() {
+
+		glBindFramebuffer(GL_FRAMEBUFFER, this->framebuffer);
+		glViewport(0, 0, this->width, this->height);
+
+	}
+
+	GLuint RenderTarget::getFramebuffer() const {
+
+		return this->framebuffer;
+
+	}
+
+	GLuint RenderTarget::getColor() const {
+
+		return this->color;
+
+	}
+
+	int RenderTarget::getWidth() const {
+
+		return this->width;
+
+	}
+
+	int RenderTarget::getHeight() const {
+
+		return this->height;
+
+	}
+
+	void RenderTarget::remove() {
+
+		// Deleted once the GPU is done with the frames that may still use them. Zero names are ignored.
+		DeletionQueue::push(DELETE_FRAMEBUFFER, this->framebuffer);
+		DeletionQueue::push(DELETE_TEXTURE, this->color);
+		DeletionQueue::push(DELETE_TEXTURE, this->depth);
+
+		this->framebuffer = 0;
+		this->color = 0;
+		this->depth = 0;
+
+	}
+
+}  // namespace bgq_opengl
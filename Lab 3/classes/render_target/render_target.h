@@ -0,0 +1,149 @@
+/**
+ * @file render_target.h
+ * @brief RenderTarget class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RENDER_TARGET_H_
+#define BGQ_OPENGL_CLASSES_RENDER_TARGET_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a RenderTarget class.
+	 *
+	 * Owns an offscreen framebuffer with a color texture and, optionally, a
+	 * depth texture of the same size. Everything is queued for deletion when
+	 * the target goes away, like the other OpenGL wrappers.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RenderTarget {
+
+		public:
+
+			/**
+			 * @brief Construct the target.
+			 *
+			 * Construct an empty target.
+			 */
+			RenderTarget();
+
+			/**
+			 * @brief Construct the target.
+			 *
+			 * Creates the attachments and the framebuffer. Exits if the framebuffer
+			 * is incomplete. The texture bound to the active unit is left unbound.
+			 *
+			 * @param width The width in pixels.
+			 * @param height The height in pixels.
+			 * @param color_format The internal format of the color, GL_RGBA8, GL_RGBA16F or GL_RGBA8UI.
+			 * @param depth Whether to add a 24 bit depth attachment.
+			 */
+			RenderTarget(int width, int height, GLenum color_format = GL_RGBA8, bool depth = true);
+
+			/**
+			 * @brief Moves a target.
+			 *
+			 * Takes over the OpenGL objects of another one, which is left empty.
+			 *
+			 * @param other The target to move from.
+			 */
+			RenderTarget(RenderTarget &&other) noexcept;
+
+			/**
+			 * @brief Moves a target.
+			 *
+			 * Releases the current OpenGL objects and takes over the ones of another.
+			 *
+			 * @param other The target to move from.
+			 *
+			 * @returns This target.
+			 */
+			RenderTarget& operator=(RenderTarget &&other) noexcept;
+
+			/**
+			 * @brief Destroys the target.
+			 *
+			 * Queues the OpenGL objects for deletion.
+			 */
+			~RenderTarget();
+
+			// Only one object owns each OpenGL name, so there are no copies.
+			RenderTarget(const RenderTarget&) = delete;
+			RenderTarget& operator=(const RenderTarget&) = delete;
+
+			/**
+			 * @brief Binds the target.
+			 *
+			 * Binds the framebuffer and sets the viewport to cover all of it.
+			 */
+			void bind();
+
+			/**
+			 * @brief Get the framebuffer.
+			 *
+			 * Get the OpenGL ID of the framebuffer.
+			 *
+			 * @returns The framebuffer ID.
+			 */
+			GLuint getFramebuffer() const;
+
+			/**
+			 * @brief Get the color texture.
+			 *
+			 * Get the OpenGL ID of the color attachment.
+			 *
+			 * @returns The texture ID.
+			 */
+			GLuint getColor() const;
+
+			/**
+			 * @brief Get the width.
+			 *
+			 * Get the width of the target in pixels.
+			 *
+			 * @returns The width in pixels.
+			 */
+			int getWidth() const;
+
+			/**
+			 * @brief Get the height.
+			 *
+			 * Get the height of the target in pixels.
+			 *
+			 * @returns The height in pixels.
+			 */
+			int getHeight() const;
+
+			/**
+			 * @brief Removes the target from OpenGL.
+			 *
+			 * Queues the framebuffer and its attachments for deletion.
+			 */
+			void remove();
+
+		private:
+
+			GLuint framebuffer = 0;		/// Framebuffer OpenGL ID.
+			GLuint color = 0;			/// Color attachment OpenGL ID.
+			GLuint depth = 0;			/// Depth attachment OpenGL ID, 0 if there is none.
+			int width = 0;				/// Width in pixels.
+			int height = 0;				/// Height in pixels.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_RENDER_TARGET_H_
@@ -0,0 +1,213 @@
+/**
+ * @file resource_cache.cpp
+ * @brief ResourceCache class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "resource_cache.h"
+
+#include <filesystem>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/cubemap/cubemap.h"
+#include "classes/object/object.h"
+#include "classes/program_cache/program_cache.h"
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	std::shared_ptr<Cubemap> ResourceCache::getCubemap(const std::vector<std::string> &faces, const char* name, GLuint slot) {
+
+		std::string key;
+		for (size_t i = 0; i < faces.size(); i++)
+			key += ResourceCache::makeFileKey(faces[i]) + "|";
+		key += std::string(name) + "|" + std::to_string(slot);
+
+		std::shared_ptr<Cubemap> cubemap = this->cubemaps[key].lock();
+		if (cubemap)
+			return cubemap;
+
+		// Six faces, each with its own mip chain.
+		Cubemap* resource = new Cubemap(faces, name, slot);
+		size_t bytes = ResourceCache::getTextureSize(resource->getWidth(), resource->getHeight()) * 6;
+
+		return this->track(resource, RESOURCE_CUBEMAPS, bytes, &this->cubemaps, key);
+
+	}
+
+	std::shared_ptr<Object> ResourceCache::getObject(const char* filename, const char* filetype) {
+
+		std::string key = ResourceCache::makeFileKey(filename) + "|" + filetype;
+
+		std::shared_ptr<Object> object = this->objects[key].lock();
+		if (object)
+			return object;
+
+		Object* resource = new Object(filename, filetype);
+		size_t bytes = resource->getMemorySize();
+
+		return this->track(resource, RESOURCE_OBJECTS, bytes, &this->objects, key);
+
+	}
+
+	std::shared_ptr<Shader> ResourceCache::getShader(const char* vertex_filename, const char* fragment_filename, const std::string &defines, const ProgramCache* cache) {
+
+		std::string key = ResourceCache::makeFileKey(vertex_filename) + "|" + ResourceCache::makeFileKey(fragment_filename) + "|" + defines;
+
+		std::shared_ptr<Shader> shader = this->shaders[key].lock();
+		if (shader)
+			return shader;
+
+		// The size is only known once the program is linked, getMemory() asks for it then.
+		Shader* resource = new Shader(vertex_filename, fragment_filename, defines, cache);
+
+		return this->track(resource, RESOURCE_SHADERS, 0, &this->shaders, key);
+
+	}
+
+	size_t ResourceCache::getCount(int type) const {
+
+		return this->counts[type];
+
+	}
+
+	size_t ResourceCache::getMemory(int type) const {
+
+		if (type != RESOURCE_SHADERS)
+			return this->memory[type];
+
+		// Only the programs that finished linking, so this never waits on the compiler.
+		size_t bytes = 0;
+
+		if (!GLEW_ARB_get_program_binary)
+			return bytes;
+
+		for (auto it = this->shaders.begin(); it != this->shaders.end(); it++) {
+
+			std::shared_ptr<Shader> shader = it->second.lock();
+			if (!shader || !shader->isReady())
+				continue;
+
+			GLint length = 0;
+			glGetProgramiv(shader->getProgramID(), GL_PROGRAM_BINARY_LENGTH, &length);
+			bytes += length;
+
+		}
+
+		return bytes;
+
+	}
+
+	void ResourceCache::report(std::ostream &out) const {
+
+		out << "Live GPU resources:" << std::endl;
+
+		size_t total = 0;
+
+		for (int i = 0; i < RESOURCE_TYPES; i++) {
+
+			size_t bytes = this->getMemory(i);
+			total += bytes;
+
+			out << "  " << std::left << std::setw(16) << ResourceCache::getTypeName(i) << std::right
+				<< std::setw(4) << this->counts[i] << "  "
+				<< std::fixed << std::setprecision(2) << std::setw(9) << bytes / (1024.0 * 1024.0) << " MB" << std::endl;
+
+		}
+
+		out << "  " << std::left << std::setw(22) << "Total" << std::right
+			<< std::fixed << std::setprecision(2) << std::setw(9) << total / (1024.0 * 1024.0) << " MB" << std::endl;
+
+	}
+
+	const char* ResourceCache::getTypeName(int type) {
+
+		switch (type) {
+
+			case RESOURCE_CUBEMAPS: return "Cubemaps";
+			case RESOURCE_OBJECTS: return "Meshes";
+			case RESOURCE_SHADERS: return "Shaders";
+			default: return "Unknown";
+
+		}
+
+	}
+
+	template <class T>
+	std::shared_ptr<T> ResourceCache::track(T* resource, int type, size_t bytes, std::map<std::string, std::weak_ptr<T>>* entries, const std::string &key) {
+
+		this->counts[type]++;
+		this->memory[type] += bytes;
+
+		// Runs when the last handle goes away. The destructor queues the OpenGL objects for deletion.
+		std::shared_ptr<T> handle(resource, [this, type, bytes, entries, key](T* resource) {
+
+			delete resource;
+
+			this->counts[type]--;
+			this->memory[type] -= bytes;
+
+			// Forget the entry, unless it was already replaced by a newer load.
+			auto it = entries->find(key);
+			if (it != entries->end() && it->second.expired())
+				entries->erase(it);
+
+		});
+
+		(*entries)[key] = handle;
+
+		return handle;
+
+	}
+
+	std::string ResourceCache::makeFileKey(const std::string &filename) {
+
+		// Falls back to the path as given if the file cannot be resolved.
+		std::error_code error;
+		std::filesystem::path path = std::filesystem::weakly_canonical(filename, error);
+
+		if (error)
+			return filename;
+
+		return path.string();
+
+	}
+
+	size_t ResourceCache::getTextureSize(int width, int height) {
+
+		size_t bytes = 0;
+
+		// Add up every level of the mip chain.
+		while (true) {
+
+			bytes += (size_t) width * height * 4;
+
+			if (width == 1 && height == 1)
+				break;
+
+			width = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+
+		}
+
+		return bytes;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,195 @@
+/**
+ * @file resource_cache.h
+ * @brief ResourceCache class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RESOURCE_CACHE_H_
+#define BGQ_OPENGL_CLASSES_RESOURCE_CACHE_H_
+
+#define RESOURCE_CUBEMAPS 0			/// Cubemaps.
+#define RESOURCE_OBJECTS 1			/// Meshes loaded from files.
+#define RESOURCE_SHADERS 2			/// Linked shader programs.
+#define RESOURCE_TYPES 3			/// Number of resource types.
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "classes/cubemap/cubemap.h"
+#include "classes/object/object.h"
+#include "classes/program_cache/program_cache.h"
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ResourceCache class.
+	 *
+	 * Hands out reference counted handles to GPU resources. Asking twice for the
+	 * same file with the same parameters returns the same resource, and the
+	 * resource is removed from OpenGL as soon as the last handle goes away.
+	 *
+	 * The cache only keeps weak references, so it never holds anything alive on
+	 * its own. It must outlive every handle it gave out.
+	 *
+	 * The material texture arrays are not cached here. TextureStreamer owns them
+	 * and changes their resident levels every frame, so it reports their memory
+	 * itself.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ResourceCache {
+
+		public:
+
+			/**
+			 * @brief Get a cubemap.
+			 *
+			 * Get the cubemap of six faces, loading it if nobody holds it.
+			 *
+			 * @param faces The images of the faces.
+			 * @param name Name of the sampler in the shaders.
+			 * @param slot Texture slot.
+			 *
+			 * @returns A handle to the cubemap.
+			 */
+			std::shared_ptr<Cubemap> getCubemap(const std::vector<std::string> &faces, const char* name, GLuint slot);
+
+			/**
+			 * @brief Get an object.
+			 *
+			 * Get the object of a file, loading it if nobody holds it. Every holder
+			 * shares the same object, transforms and shininess included.
+			 *
+			 * @param filename The model filename.
+			 * @param filetype The loader to use.
+			 *
+			 * @returns A handle to the object.
+			 */
+			std::shared_ptr<Object> getObject(const char* filename, const char* filetype);
+
+			/**
+			 * @brief Get a shader.
+			 *
+			 * Get the shader of some sources and defines, compiling it if nobody
+			 * holds it.
+			 *
+			 * @param vertex_filename Vertex shader filename.
+			 * @param fragment_filename Fragment shader filename.
+			 * @param defines Lines to insert after the #version directive.
+			 * @param cache The program binary cache, or nullptr to always compile.
+			 *
+			 * @returns A handle to the shader.
+			 */
+			std::shared_ptr<Shader> getShader(const char* vertex_filename, const char* fragment_filename, const std::string &defines = "", const ProgramCache* cache = nullptr);
+
+			/**
+			 * @brief Get the number of live resources.
+			 *
+			 * Get the number of resources of a type that are still held.
+			 *
+			 * @param type One of the RESOURCE_* types.
+			 *
+			 * @returns The number of live resources.
+			 */
+			size_t getCount(int type) const;
+
+			/**
+			 * @brief Get the GPU memory of the live resources.
+			 *
+			 * Get an estimate of the GPU memory used by the resources of a type
+			 * that are still held, mipmaps included.
+			 *
+			 * @param type One of the RESOURCE_* types.
+			 *
+			 * @returns The memory in bytes.
+			 */
+			size_t getMemory(int type) const;
+
+			/**
+			 * @brief Prints the live resources.
+			 *
+			 * Prints the number and GPU memory of the live resources of every type.
+			 *
+			 * @param out The stream to print to.
+			 */
+			void report(std::ostream &out) const;
+
+			/**
+			 * @brief Get the name of a resource type.
+			 *
+			 * Get a human readable name of a resource type.
+			 *
+			 * @param type One of the RESOURCE_* types.
+			 *
+			 * @returns The name of the type.
+			 */
+			static const char* getTypeName(int type);
+
+		private:
+
+			/**
+			 * @brief Tracks a new resource.
+			 *
+			 * Wraps a resource in a handle that removes it and forgets it when the
+			 * last copy goes away.
+			 *
+			 * @param resource The resource, owned by the handle from now on.
+			 * @param type One of the RESOURCE_* types.
+			 * @param bytes The GPU memory of the resource.
+			 * @param entries The entries of the type.
+			 * @param key The key of the resource.
+			 *
+			 * @returns The handle.
+			 */
+			template <class T>
+			std::shared_ptr<T> track(T* resource, int type, size_t bytes, std::map<std::string, std::weak_ptr<T>>* entries, const std::string &key);
+
+			/**
+			 * @brief Builds the key of a file.
+			 *
+			 * Builds the part of a key that identifies a file, so different paths
+			 * to the same file share the resource.
+			 *
+			 * @param filename The filename.
+			 *
+			 * @returns The canonical path of the file.
+			 */
+			static std::string makeFileKey(const std::string &filename);
+
+			/**
+			 * @brief Estimates the size of a mipmapped texture.
+			 *
+			 * Estimates the size of an RGBA8 texture with a full mip chain.
+			 *
+			 * @param width The width of the base level.
+			 * @param height The height of the base level.
+			 *
+			 * @returns The size in bytes.
+			 */
+			static size_t getTextureSize(int width, int height);
+
+			std::map<std::string, std::weak_ptr<Cubemap>> cubemaps;				/// Live cubemaps by key.
+			std::map<std::string, std::weak_ptr<Object>> objects;				/// Live objects by key.
+			std::map<std::string, std::weak_ptr<Shader>> shaders;				/// Live shaders by key.
+
+			size_t counts[RESOURCE_TYPES] = {};		/// Live resources of every type.
+			size_t memory[RESOURCE_TYPES] = {};		/// GPU memory of the live resources of every type.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_RESOURCE_CACHE_H_
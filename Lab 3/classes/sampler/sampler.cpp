@@ -0,0 +1,169 @@
+/**
+ * @file sampler.cpp
+ * @brief Sampler class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "sampler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <utility>
+
+#include "GL/glew.h"
+
+#include "classes/deletion_queue/deletion_queue.h"
+
+namespace bgq_opengl {
+
+	Sampler::Sampler() {
+
+	}
+
+	Sampler::Sampler(int preset) {
+
+		assert(preset >= 0 && preset < SAMPLER_PRESETS);
+
+		this->preset = preset;
+
+		glGenSamplers(1, &this->ID);
+
+		// Every preset repeats.
+		glSamplerParameteri(this->ID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glSamplerParameteri(this->ID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		if (preset == SAMPLER_NEAREST) {
+
+			glSamplerParameteri(this->ID, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+			glSamplerParameteri(this->ID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			return;
+
+		}
+
+		// The rest build on trilinear.
+		glSamplerParameteri(this->ID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glSamplerParameteri(this->ID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		if (preset == SAMPLER_ANISOTROPIC) {
+
+			if (GLEW_EXT_texture_filter_anisotropic) {
+
+				GLfloat max_anisotropy = 1.0f;
+				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &max_anisotropy);
+				glSamplerParameterf(this->ID, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(max_anisotropy, SAMPLER_MAX_ANISOTROPY));
+
+			} else {
+
+				std::cerr << "Sampler warning - Anisotropic filtering is not supported, falling back to trilinear." << std::endl;
+
+			}
+
+		} else if (preset == SAMPLER_SHARP) {
+
+			glSamplerParameterf(this->ID, GL_TEXTURE_LOD_BIAS, SAMPLER_SHARP_LOD_BIAS);
+
+		}
+
+	}
+
+	Sampler::Sampler(Sampler &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->ID = other.ID;
+		this->preset = other.preset;
+		other.ID = 0;
+
+	}
+
+	Sampler& Sampler::operator=(Sampler &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->ID = other.ID;
+		this->preset = other.preset;
+		other.ID = 0;
+
+		return *this;
+
+	}
+
+	Sampler::~Sampler() {
+
+		this->remove();
+
+	}
+
+	void Sampler::bind(GLuint slot) {
+
+		glBindSampler(slot, this->ID);
+
+	}
+
+	GLuint Sampler::getID() {
+
+		return this->ID;
+
+	}
+
+	int Sampler::getPreset() {
+
+		return this->preset;
+
+	}
+
+	void Sampler::remove() {
+
+		// Nothing to delete if it was never created or was moved away.
+		if (this->ID == 0)
+			return;
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_SAMPLER, this->ID);
+		this->ID = 0;
+
+	}
+
+	void Sampler::unbind(GLuint slot) {
+
+		glBindSampler(slot, 0);
+
+	}
+
+	const char* Sampler::getPresetName(int preset) {
+
+		switch (preset) {
+
+			case SAMPLER_NEAREST:
+				return "Nearest";
+
+			case SAMPLER_TRILINEAR:
+				return "Trilinear";
+
+			case SAMPLER_ANISOTROPIC:
+				return "Anisotropic";
+
+			case SAMPLER_SHARP:
+				return "Sharp";
+
+			default:
+				return "Unknown";
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,157 @@
+/**
+ * @file sampler.h
+ * @brief Sampler class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SAMPLER_H_
+#define BGQ_OPENGL_CLASSES_SAMPLER_H_
+
+#define SAMPLER_NEAREST 0		/// Nearest texel, linear between mips. What textures used to hardcode.
+#define SAMPLER_TRILINEAR 1		/// Linear within and between mips.
+#define SAMPLER_ANISOTROPIC 2	/// Trilinear plus anisotropic filtering.
+#define SAMPLER_SHARP 3			/// Trilinear with a negative LOD bias.
+#define SAMPLER_PRESETS 4		/// Number of presets.
+
+#define SAMPLER_MAX_ANISOTROPY 16.0f	/// Anisotropy used by the anisotropic preset, if the driver allows it.
+#define SAMPLER_SHARP_LOD_BIAS -0.5f	/// LOD bias of the sharp preset.
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a Sampler class.
+	 *
+	 * Wraps an OpenGL sampler object, which holds the filtering and wrapping
+	 * state apart from the textures. A single sampler can be bound to as many
+	 * texture units as needed, and overrides the state of the textures bound
+	 * to them.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Sampler {
+
+		public:
+
+			/**
+			 * @brief Construct the sampler.
+			 *
+			 * Construct an empty sampler.
+			 */
+			Sampler();
+
+			/**
+			 * @brief Construct the sampler.
+			 *
+			 * Construct a sampler with the state of one of the presets.
+			 *
+			 * @param preset One of the SAMPLER_* presets.
+			 */
+			Sampler(int preset);
+
+			/**
+			 * @brief Moves a sampler.
+			 *
+			 * Takes over the OpenGL sampler of another one, which is left empty.
+			 *
+			 * @param other The sampler to move from.
+			 */
+			Sampler(Sampler &&other) noexcept;
+
+			/**
+			 * @brief Moves a sampler.
+			 *
+			 * Releases the current OpenGL sampler and takes over the one of another.
+			 *
+			 * @param other The sampler to move from.
+			 *
+			 * @returns This sampler.
+			 */
+			Sampler& operator=(Sampler &&other) noexcept;
+
+			/**
+			 * @brief Destroys the sampler.
+			 *
+			 * Queues the OpenGL sampler for deletion.
+			 */
+			~Sampler();
+
+			// Only one object owns each OpenGL name, so there are no copies.
+			Sampler(const Sampler&) = delete;
+			Sampler& operator=(const Sampler&) = delete;
+
+			/**
+			 * @brief Binds the sampler.
+			 *
+			 * Binds the sampler to a texture unit.
+			 *
+			 * @param slot The texture unit.
+			 */
+			void bind(GLuint slot);
+
+			/**
+			 * @brief Get the ID of the sampler.
+			 *
+			 * Get the ID of the sampler.
+			 *
+			 * @returns The ID of the sampler.
+			 */
+			GLuint getID();
+
+			/**
+			 * @brief Get the preset of the sampler.
+			 *
+			 * Get the preset the sampler was built with.
+			 *
+			 * @returns The preset.
+			 */
+			int getPreset();
+
+			/**
+			 * @brief Removes the sampler from OpenGL.
+			 *
+			 * Removes the sampler from OpenGL.
+			 */
+			void remove();
+
+			/**
+			 * @brief Unbinds the sampler.
+			 *
+			 * Unbinds whatever sampler is bound to a texture unit, so the unit goes
+			 * back to the state of its texture.
+			 *
+			 * @param slot The texture unit.
+			 */
+			static void unbind(GLuint slot);
+
+			/**
+			 * @brief Get the name of a preset.
+			 *
+			 * Get a readable name of a preset.
+			 *
+			 * @param preset One of the SAMPLER_* presets.
+			 *
+			 * @returns The name of the preset.
+			 */
+			static const char* getPresetName(int preset);
+
+		private:
+
+			GLuint ID = 0;		/// Sampler OpenGL ID.
+			int preset = 0;		/// Preset the sampler was built with.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_SAMPLER_H_
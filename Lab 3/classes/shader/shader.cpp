@@ -16,6 +16,8 @@
 #include "shader.h"
 
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -26,8 +28,12 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/deletion_queue/deletion_queue.h"
 #include "classes/light/light.h"
+#include "classes/program_cache/program_cache.h"
 #include "classes/texture/texture.h"
+#include "classes/texture_array/texture_array.h"
+#include "classes/virtual_texture/virtual_texture.h"
 
 namespace bgq_opengl {
 
@@ -39,10 +45,16 @@ namespace bgq_opengl {
     
     }
     
-    Shader::Shader(const char* vertex_filename, const char* fragment_filename) {
+    Shader::Shader(const char* vertex_filename, const char* fragment_filename, const std::string &defines, const ProgramCache* cache) {
 
         this->light = new Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
 
+        // Remember where it came from, so it can be reloaded.
+        this->vertex_filename = vertex_filename;
+        this->fragment_filename = fragment_filename;
+        this->defines = defines;
+        this->cache = cache;
+
         // Init the strings to store the source code in.
         std::string vertex_source_code = "";
         std::string fragment_source_code = "";
@@ -69,69 +81,121 @@ namespace bgq_opengl {
 
         }
 
+        // Add the feature switches.
+        if (!defines.empty()) {
+
+            Shader::insertDefines(&vertex_source_code, defines);
+            Shader::insertDefines(&fragment_source_code, defines);
+
+        }
+
+        // Try the binary cache first, it skips compiling and linking altogether.
+        std::string cache_key = "";
+        this->programID = glCreateProgram();
+
+        if (cache != nullptr && cache->isEnabled()) {
+
+            cache_key = cache->makeKey(vertex_source_code, fragment_source_code, defines);
+
+            if (cache->load(this->programID, cache_key)) {
+
+                this->bindBlocks();
+                return;
+
+            }
+
+            // A rejected binary can leave the program in a failed state, so start from a clean one.
+            glDeleteProgram(this->programID);
+            this->programID = glCreateProgram();
+
+        }
+
         // Convert it to char.
         const char* vertex_code_char = vertex_source_code.c_str();
         const char* fragment_code_char = fragment_source_code.c_str();
 
-        // Create and compile the vertex shader.
+        // Submit both stages and the link without asking for their status.
+        // Any status query makes the driver finish the job, so they are left for the first use
+        // and the compilation overlaps with loading the textures and meshes.
         GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex, 1, &vertex_code_char, NULL);
         glCompileShader(vertex);
 
-        // Check for errors.
-        std::string error_msg = "";
-        if (!Shader::checkShader(vertex, "VERTEX", &error_msg)) {
-
-            std::cerr << "Vertex shader error - Could not compile the shader: " << error_msg << std::endl;
-            exit(1);
-
-        }
-
-        // Create and compile the fragment shader.
         GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragment, 1, &fragment_code_char, NULL);
         glCompileShader(fragment);
 
-        // Check for errors.
-        error_msg = "";
-        if (!Shader::checkShader(fragment, "FRAGMENT", &error_msg)) {
-
-            std::cerr << "Fragment shader error - Could not compile the shader: " << error_msg << std::endl;
-            exit(1);
-
-        }
-
-        // Create the program and add the vertex and fragment shaders.
-        this->programID = glCreateProgram();
+        // Add the vertex and fragment shaders to the program.
         glAttachShader(this->programID, vertex);
         glAttachShader(this->programID, fragment);
 
-        // Link this program and check for program errors.
-        glLinkProgram(this->programID);
-        error_msg = "";
-        if (!Shader::checkShader(this->programID, "PROGRAM", &error_msg)) {
-
-            std::cerr << "Shader program error - Could not link the shaders: " << error_msg << std::endl;
-            exit(1);
+        // Link this program.
+        if (cache != nullptr)
+            cache->prepare(this->programID);
 
-        }
+        glLinkProgram(this->programID);
 
-        // Clean the shaders.
-        // They are in the compiled program now, so clean them.
+        // Flag the shaders for deletion.
+        // They live on while attached, so their logs can still be read when the status is checked.
         glDeleteShader(vertex);
         glDeleteShader(fragment);
 
-        /*
-        // Validate the program.
-        glValidateProgram(this->programID);
-        error_msg = "";
-        if (!Shader::checkShader(this->programID, "VALIDATE", &error_msg)) {
+        // Remember what is left to do.
+        this->cache_key = cache_key;
+        this->ready = false;
 
-            std::cerr << "Shader program error - Could not validate the program: " << error_msg << std::endl;
-            exit(1);
+    }
 
-        }
-         */
+    Shader::Shader(Shader &&other) noexcept {
+
+        // Take over the other one, then leave it empty.
+        this->light = other.light;
+        this->programID = other.programID;
+        this->ready = other.ready;
+        this->cache = other.cache;
+        this->cache_key = std::move(other.cache_key);
+        this->vertex_filename = std::move(other.vertex_filename);
+        this->fragment_filename = std::move(other.fragment_filename);
+        this->defines = std::move(other.defines);
+        this->uniform_locations = std::move(other.uniform_locations);
+
+        other.light = nullptr;
+        other.programID = -1;
+        other.ready = true;
+
+    }
+
+    Shader& Shader::operator=(Shader &&other) noexcept {
+
+        if (this == &other)
+            return *this;
+
+        // Let go of the current one, then leave the other empty.
+        this->remove();
+        delete this->light;
+
+        this->light = other.light;
+        this->programID = other.programID;
+        this->ready = other.ready;
+        this->cache = other.cache;
+        this->cache_key = std::move(other.cache_key);
+        this->vertex_filename = std::move(other.vertex_filename);
+        this->fragment_filename = std::move(other.fragment_filename);
+        this->defines = std::move(other.defines);
+        this->uniform_locations = std::move(other.uniform_locations);
+
+        other.light = nullptr;
+        other.programID = -1;
+        other.ready = true;
+
+        return *this;
+
+    }
+
+    Shader::~Shader() {
+
+        this->remove();
+        delete this->light;
 
     }
 
@@ -141,31 +205,56 @@ namespace bgq_opengl {
 
     }
 
+    bool Shader::isReady() {
+
+        if (this->ready)
+            return true;
+
+        // Without the extension there is no way to ask without blocking, so it is left to activate().
+        if (!GLEW_KHR_parallel_shader_compile && !GLEW_ARB_parallel_shader_compile)
+            return true;
+
+        GLint completed = GL_FALSE;
+        glGetProgramiv(this->programID, GL_COMPLETION_STATUS_KHR, &completed);
+
+        if (!completed)
+            return false;
+
+        // The link is done, so checking it will not stall anymore.
+        this->finish();
+
+        return true;
+
+    }
+
     void Shader::activate() {
 
         if (this->programID == -1)
             throw std::runtime_error("Shader was not initialized.");
 
+        // Make sure the program compiled and linked before using it.
+        this->finish();
+
         glUseProgram(this->programID);
 
     }
 
     void Shader::passBool(const std::string& name, bool value) {
 
-        glUniform1i(glGetUniformLocation(this->programID, name.c_str()), (int)value);
+        glUniform1i(this->getUniformLocation(name), (int)value);
 
     }
 
-    void Shader::passCamera(Camera camera) {
+    void Shader::passCamera(const Camera &camera) {
 
         // Pass the View matrix to the shader.
-        glm::mat4 view_matrix = camera.getView();
-        GLint location = glGetUniformLocation(this->programID, "View");
+        const glm::mat4 &view_matrix = camera.getView();
+        GLint location = this->getUniformLocation("View");
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(view_matrix));
 
         // Pass the Projection matrix to the shader.
-        glm::mat4 projection_matrix = camera.getProjection();
-        location = glGetUniformLocation(this->programID, "Projection");
+        const glm::mat4 &projection_matrix = camera.getProjection();
+        location = this->getUniformLocation("Projection");
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(projection_matrix));
 
         // Get the camera info and pass it to the shader.
@@ -178,16 +267,16 @@ namespace bgq_opengl {
         glm::vec3 camPos = glm::vec3(view_matrix * glm::vec4(camera.getPosition(), 1.0f));
 
         // Pass it to the shader.
-        glUniform4f(glGetUniformLocation(this->programID, "lightColor"), color.x, color.y, color.z, color.w);
-        glUniform3f(glGetUniformLocation(this->programID, "lightPos"), position.x, position.y, position.z);
-        glUniform3f(glGetUniformLocation(this->programID, "cameraPos"), camPos.x, camPos.y, camPos.z);
+        glUniform4f(this->getUniformLocation("lightColor"), color.x, color.y, color.z, color.w);
+        glUniform3f(this->getUniformLocation("lightPos"), position.x, position.y, position.z);
+        glUniform3f(this->getUniformLocation("cameraPos"), camPos.x, camPos.y, camPos.z);
 
     }
 
-    void Shader::passCubemap(Cubemap cubemap) {
+    void Shader::passCubemap(Cubemap &cubemap) {
         
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, cubemap.getName().c_str());
+        GLuint location = this->getUniformLocation(cubemap.getName());
 
         // Activate the shader.
         this->activate();
@@ -209,26 +298,27 @@ namespace bgq_opengl {
     void Shader::passLight(Light lightParam) {
 
         // Store the light.
+        delete this->light;
         this->light = new Light(lightParam.getPosition(), lightParam.getColor());
 
     }
 
     void Shader::passInt(const std::string& name, int value) {
 
-        glUniform1i(glGetUniformLocation(this->programID, name.c_str()), value);
+        glUniform1i(this->getUniformLocation(name), value);
 
     }
 
     void Shader::passFloat(const std::string& name, float value) {
 
-        glUniform1f(glGetUniformLocation(this->programID, name.c_str()), value);
+        glUniform1f(this->getUniformLocation(name), value);
 
     }
 
-    void Shader::passTexture(Texture texture) {
+    void Shader::passTexture(Texture &texture) {
 
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, texture.getName().c_str());
+        GLuint location = this->getUniformLocation(texture.getName());
 
         // Activate the shader.
         this->activate();
@@ -247,10 +337,30 @@ namespace bgq_opengl {
 
     }
 
+    void Shader::passTexture(const TextureArray &texture_array) {
+
+        glUniform1i(this->getUniformLocation(texture_array.getName()), texture_array.getSlot());
+
+    }
+
+    void Shader::passVirtualTexture(const VirtualTexture &virtual_texture, float bias) {
+
+        glUniform1i(this->getUniformLocation("virtualAtlas"), virtual_texture.getSlot());
+        glUniform1i(this->getUniformLocation("virtualPages"), virtual_texture.getSlot() + 1);
+        glUniform1f(this->getUniformLocation("virtualSize"), (float) virtual_texture.getSize());
+        glUniform2f(this->getUniformLocation("virtualGrid"), (float) virtual_texture.getColumns(), (float) virtual_texture.getRows());
+        glUniform1f(this->getUniformLocation("virtualPageSize"), (float) virtual_texture.getPageSize());
+        glUniform1f(this->getUniformLocation("virtualBorder"), (float) virtual_texture.getBorder());
+        glUniform1f(this->getUniformLocation("virtualAtlasSize"), (float) virtual_texture.getAtlasSize());
+        glUniform1i(this->getUniformLocation("virtualLevels"), virtual_texture.getLevels());
+        glUniform1f(this->getUniformLocation("virtualBias"), bias);
+
+    }
+
     void Shader::passVec(const std::string& name, glm::vec2 value) {
         
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        GLuint location = this->getUniformLocation(name);
 
         // Sets the value of the texture uniform.
         glUniform2f(location, value.x, value.y);
@@ -260,7 +370,7 @@ namespace bgq_opengl {
     void Shader::passVec(const std::string& name, glm::vec3 value) {
         
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        GLuint location = this->getUniformLocation(name);
 
         // Sets the value of the texture uniform.
         glUniform3f(location, value.x, value.y, value.z);
@@ -270,7 +380,7 @@ namespace bgq_opengl {
     void Shader::passVec(const std::string& name, glm::vec4 value) {
         
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        GLuint location = this->getUniformLocation(name);
 
         // Sets the value of the texture uniform.
         glUniform4f(location, value.x, value.y, value.z, value.w);
@@ -280,7 +390,7 @@ namespace bgq_opengl {
     void Shader::passMat(const std::string& name, glm::mat2 value) {
 
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        GLuint location = this->getUniformLocation(name);
 
         glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
 
@@ -289,7 +399,7 @@ namespace bgq_opengl {
     void Shader::passMat(const std::string& name, glm::mat3 value) {
 
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        GLuint location = this->getUniformLocation(name);
 
         glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
 
@@ -298,15 +408,191 @@ namespace bgq_opengl {
     void Shader::passMat(const std::string& name, glm::mat4 value) {
 
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        GLuint location = this->getUniformLocation(name);
 
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
 
     }
 
+    GLint Shader::getUniformLocation(const std::string& name) {
+
+        // Looking a name up in the driver is slow, so every location is only asked for once.
+        auto found = this->uniform_locations.find(name);
+        if (found != this->uniform_locations.end())
+            return found->second;
+
+        GLint location = glGetUniformLocation(this->programID, name.c_str());
+        this->uniform_locations[name] = location;
+
+        return location;
+
+    }
+
+    bool Shader::reload(const std::string& filename, const std::string& contents) {
+
+        if (filename != this->vertex_filename && filename != this->fragment_filename)
+            return false;
+
+        // Use the new contents for the stage that changed and read the other one.
+        std::string vertex_source_code = contents;
+        std::string fragment_source_code = contents;
+
+        try {
+
+            if (filename != this->vertex_filename)
+                readFileContents(this->vertex_filename.c_str(), &vertex_source_code);
+
+            if (filename != this->fragment_filename)
+                readFileContents(this->fragment_filename.c_str(), &fragment_source_code);
+
+        } catch (std::ifstream::failure& e) {
+
+            std::cerr << "Shader warning - Could not read the shaders to reload them, keeping the old program: " << e.what() << std::endl;
+            return false;
+
+        }
+
+        if (!this->defines.empty()) {
+
+            Shader::insertDefines(&vertex_source_code, this->defines);
+            Shader::insertDefines(&fragment_source_code, this->defines);
+
+        }
+
+        const char* vertex_code_char = vertex_source_code.c_str();
+        const char* fragment_code_char = fragment_source_code.c_str();
+
+        // Build the new program next to the old one, which keeps being used until this one links.
+        GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertex, 1, &vertex_code_char, NULL);
+        glCompileShader(vertex);
+
+        GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragment, 1, &fragment_code_char, NULL);
+        glCompileShader(fragment);
+
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+
+        if (this->cache != nullptr)
+            this->cache->prepare(program);
+
+        glLinkProgram(program);
+
+        // Check every step, and report the first one that failed.
+        std::string error_msg = "";
+        bool success = Shader::checkShader(vertex, "VERTEX", &error_msg) &&
+            Shader::checkShader(fragment, "FRAGMENT", &error_msg) &&
+            Shader::checkShader(program, "PROGRAM", &error_msg);
+
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+
+        if (!success) {
+
+            std::cerr << "Shader warning - Could not reload " << filename << ", keeping the old program: " << error_msg << std::endl;
+            glDeleteProgram(program);
+
+            return false;
+
+        }
+
+        // Swap the programs. The locations of the old one mean nothing to the new one.
+        // Frames still in flight may use the old one, so it goes through the queue.
+        DeletionQueue::push(DELETE_PROGRAM, this->programID);
+
+        this->programID = program;
+        this->ready = true;
+        this->uniform_locations.clear();
+        this->bindBlocks();
+
+        if (this->cache != nullptr && this->cache->isEnabled())
+            this->cache->store(program, this->cache->makeKey(vertex_source_code, fragment_source_code, this->defines));
+
+        return true;
+
+    }
+
     void Shader::remove() {
 
-        glDeleteProgram(this->programID);
+        // Deleted once the GPU is done with the frames that may still use it.
+        if (this->programID != -1)
+            DeletionQueue::push(DELETE_PROGRAM, this->programID);
+
+        this->programID = -1;
+        this->ready = true;
+        this->uniform_locations.clear();
+
+    }
+
+    void Shader::bindBlocks() {
+
+        // Attach the per-draw transforms block to its binding point, if the program uses it.
+        GLuint transforms_block = glGetUniformBlockIndex(this->programID, "Transforms");
+        if (transforms_block != GL_INVALID_INDEX)
+            glUniformBlockBinding(this->programID, transforms_block, Shader::TRANSFORMS_BINDING);
+
+    }
+
+    void Shader::finish() {
+
+        if (this->ready)
+            return;
+
+        this->ready = true;
+
+        // Get the shaders that are still attached.
+        GLuint attached[2];
+        GLsizei num_attached = 0;
+        glGetAttachedShaders(this->programID, 2, &num_attached, attached);
+
+        // Check for program errors.
+        std::string error_msg = "";
+        if (!Shader::checkShader(this->programID, "PROGRAM", &error_msg)) {
+
+            // Point at the stage that failed, if any of them did.
+            for (int i = 0; i < num_attached; i++) {
+
+                std::string stage_msg = "";
+                if (Shader::checkShader(attached[i], "SHADER", &stage_msg))
+                    continue;
+
+                GLint type = 0;
+                glGetShaderiv(attached[i], GL_SHADER_TYPE, &type);
+
+                std::cerr << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment") << " shader error - Could not compile the shader: " << stage_msg << std::endl;
+                exit(1);
+
+            }
+
+            std::cerr << "Shader program error - Could not link the shaders: " << error_msg << std::endl;
+            exit(1);
+
+        }
+
+        // Keep the binary for the next run.
+        if (this->cache != nullptr)
+            this->cache->store(this->programID, this->cache_key);
+
+        this->bindBlocks();
+
+        // Clean the shaders.
+        // They are in the compiled program now, so detaching them frees them.
+        for (int i = 0; i < num_attached; i++)
+            glDetachShader(this->programID, attached[i]);
+
+        /*
+        // Validate the program.
+        glValidateProgram(this->programID);
+        error_msg = "";
+        if (!Shader::checkShader(this->programID, "VALIDATE", &error_msg)) {
+
+            std::cerr << "Shader program error - Could not validate the program: " << error_msg << std::endl;
+            exit(1);
+
+        }
+         */
 
     }
 
@@ -346,6 +632,32 @@ namespace bgq_opengl {
 
     }
 
+    void Shader::insertDefines(std::string* source, const std::string &defines) {
+
+        // Find the end of the version line, if there is one.
+        size_t position = 0;
+        size_t version = source->find("#version");
+
+        if (version != std::string::npos) {
+
+            position = source->find('\n', version);
+            position = position == std::string::npos ? source->size() : position + 1;
+
+        }
+
+        // Make sure the defines end in a new line.
+        std::string lines = defines;
+        if (lines.back() != '\n')
+            lines.push_back('\n');
+
+        // Keep the error messages pointing at the right line of the file.
+        if (version != std::string::npos)
+            lines.append("#line 2\n");
+
+        source->insert(position, lines);
+
+    }
+
     void Shader::readFileContents(const char* filename, std::string *file_contents) {
 
         try {
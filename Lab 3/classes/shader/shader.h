@@ -17,13 +17,18 @@
 #define BGQ_OPENGL_SHADER_H_
 
 #include <string>
+#include <unordered_map>
 
+#include "GL/glew.h"
 #include "glm/glm.hpp"
 
 #include "classes/camera/camera.h"
 #include "classes/cubemap/cubemap.h"
 #include "classes/light/light.h"
+#include "classes/program_cache/program_cache.h"
 #include "classes/texture/texture.h"
+#include "classes/texture_array/texture_array.h"
+#include "classes/virtual_texture/virtual_texture.h"
 
 namespace bgq_opengl {
     
@@ -39,6 +44,8 @@ namespace bgq_opengl {
 
     public:
 
+        static const unsigned int TRANSFORMS_BINDING = 0; /// Binding point of the Transforms uniform block.
+
         /**
          * @brief Construct the shader instance.
          *
@@ -49,12 +56,51 @@ namespace bgq_opengl {
         /**
          * @brief Construct the shader instance.
          *
-         * Construct the shader instance by passing the shaders' files.
+         * Construct the shader instance by passing the shaders' files. The defines
+         * are inserted right after the version line of both sources. If a program
+         * cache is given, the linked binary is loaded from it when possible and
+         * stored in it otherwise.
+         *
+         * Compilation and linking are only submitted here. Their status is checked
+         * on the first activation, so the driver can work on them in the background.
          *
          * @param vertex_filename Vertex shader filename.
          * @param fragment_filename Fragment shader filename.
+         * @param defines Preprocessor lines to prepend to both sources.
+         * @param cache The program binary cache, or nullptr to always compile.
+         */
+        Shader(const char* vertex_filename, const char* fragment_filename, const std::string &defines = "", const ProgramCache* cache = nullptr);
+
+        /**
+         * @brief Moves a shader.
+         *
+         * Takes over the OpenGL program of another one, which is left empty.
+         *
+         * @param other The shader to move from.
+         */
+        Shader(Shader &&other) noexcept;
+
+        /**
+         * @brief Moves a shader.
+         *
+         * Releases the current OpenGL program and takes over the one of another.
+         *
+         * @param other The shader to move from.
+         *
+         * @returns This shader.
+         */
+        Shader& operator=(Shader &&other) noexcept;
+
+        /**
+         * @brief Destroys the shader.
+         *
+         * Queues the OpenGL program for deletion.
          */
-        Shader(const char* vertex_filename, const char* fragment_filename);
+        ~Shader();
+
+        // Only one object owns each OpenGL name, so there are no copies.
+        Shader(const Shader&) = delete;
+        Shader& operator=(const Shader&) = delete;
 
         /**
          *@brief Returns the program ID.
@@ -65,10 +111,22 @@ namespace bgq_opengl {
          */
         unsigned int getProgramID();
 
+        /**
+         * @brief Whether the program finished compiling.
+         *
+         * Polls the compilation without blocking when KHR_parallel_shader_compile
+         * is supported. Without it there is no way to ask without stalling, so it
+         * always returns true and the check happens on activation.
+         *
+         * @returns True if the program can be used without waiting.
+         */
+        bool isReady();
+
         /**
          * @brief Activate this shader program.
          * 
-         * Activate this shader program and start using it.
+         * Activate this shader program and start using it. Waits for the
+         * compilation to finish the first time.
          */
         void activate();
 
@@ -89,7 +147,7 @@ namespace bgq_opengl {
          *
          * @param camera The camera.
          */
-        void passCamera(Camera camera);
+        void passCamera(const Camera &camera);
         
         /**
          * @brief Pass a cubemap to the shader.
@@ -98,7 +156,7 @@ namespace bgq_opengl {
          *
          * @param cubemap The cubemap that will be passed.
          */
-        void passCubemap(Cubemap cubemap);
+        void passCubemap(Cubemap &cubemap);
 
         /**
          * @brief Pass a light to the shader.
@@ -136,7 +194,29 @@ namespace bgq_opengl {
          * 
          * @param texture The texture itself.
          */
-        void passTexture(Texture texture);
+        void passTexture(Texture &texture);
+
+        /**
+         * @brief Pass a texture array to the shader.
+         *
+         * Points the sampler of the texture array to its slot. Unlike textures,
+         * arrays are not bound here: they stay bound to their slot, and the
+         * shader picks the layer.
+         *
+         * @param texture_array The texture array.
+         */
+        void passTexture(const TextureArray &texture_array);
+
+        /**
+         * @brief Pass a virtual texture to the shader.
+         *
+         * Points the atlas and page table samplers to their slots and passes
+         * the layout of the pages. Like arrays, they stay bound to their slots.
+         *
+         * @param virtual_texture The virtual texture.
+         * @param bias Levels added to the level every pixel asks for.
+         */
+        void passVirtualTexture(const VirtualTexture &virtual_texture, float bias);
         
         /**
          * @brief Pass a vector of size 2 to the shader.
@@ -198,6 +278,31 @@ namespace bgq_opengl {
          */
         void passMat(const std::string& name, glm::mat4 value);
 
+        /**
+         * @brief Get the location of a uniform.
+         *
+         * Get the location of a uniform, asking the driver only the first time.
+         *
+         * @param name Name of the variable in the shader.
+         *
+         * @returns The location, or -1 if the program does not use it.
+         */
+        GLint getUniformLocation(const std::string& name);
+
+        /**
+         * @brief Reload the program after a file changed.
+         *
+         * Rebuilds the program with the new contents of one of its files. The new
+         * program only replaces the old one if it compiles and links, otherwise
+         * the old one is kept and the error is reported.
+         *
+         * @param filename The file that changed, as it was given to the constructor.
+         * @param contents The new contents of the file.
+         *
+         * @returns True if the program was replaced.
+         */
+        bool reload(const std::string& filename, const std::string& contents);
+
         /**
          * @brief Remove the shader from OpenGL.
          * 
@@ -207,6 +312,24 @@ namespace bgq_opengl {
 
     private:
 
+        /**
+         * @brief Bind the uniform blocks.
+         *
+         * Attach the uniform blocks used by the program to their binding points.
+         * Block bindings are not part of the program binary, so this runs after
+         * loading from the cache too.
+         */
+        void bindBlocks();
+
+        /**
+         * @brief Finish the compilation.
+         *
+         * Checks the outcome of the compilation and linking submitted by the
+         * constructor, and does whatever needed a linked program. Only does
+         * anything the first time it is called.
+         */
+        void finish();
+
         /**
          * @brief Check for errors in the program or shader.
          * 
@@ -220,6 +343,17 @@ namespace bgq_opengl {
          */
         static bool checkShader(unsigned int shader, std::string type, std::string* log_str);
 
+        /**
+         * @brief Inserts defines into a source.
+         *
+         * Inserts the defines right after the version line of a shader source,
+         * since nothing but comments may come before it.
+         *
+         * @param source The shader source, modified in place.
+         * @param defines The preprocessor lines to insert.
+         */
+        static void insertDefines(std::string* source, const std::string &defines);
+
         /**
          * @brief Gets the content of a file as a string.
          *
@@ -232,8 +366,15 @@ namespace bgq_opengl {
          */
         static void readFileContents(const char* filename, std::string *file_contents);
 
-        Light* light; /// The light that will be used in the shader.
+        Light* light = nullptr; /// The light that will be used in the shader.
         unsigned int programID = -1; /// OpenGL ID for this shader program.
+        bool ready = true; /// Whether the compilation has been checked.
+        const ProgramCache* cache = nullptr; /// Cache where the binary goes once linked.
+        std::string cache_key = ""; /// Key of the binary in the cache.
+        std::string vertex_filename = ""; /// Vertex shader filename.
+        std::string fragment_filename = ""; /// Fragment shader filename.
+        std::string defines = ""; /// Defines prepended to both sources.
+        std::unordered_map<std::string, GLint> uniform_locations; /// Locations already asked for.
 
     };
 
@@ -0,0 +1,129 @@
+/**
+ * @file shader_library.cpp
+ * @brief ShaderLibrary class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "shader_library.h"
+
+#include <cassert>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "classes/bump_baker/bump_baker.h"
+#include "classes/program_cache/program_cache.h"
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	ShaderLibrary::ShaderLibrary() {
+
+	}
+
+	ShaderLibrary::ShaderLibrary(const char* vertex_filename, const char* fragment_filename, const ProgramCache* cache) {
+
+		this->vertex_filename = vertex_filename;
+		this->fragment_filename = fragment_filename;
+		this->cache = cache;
+
+	}
+
+	Shader& ShaderLibrary::get(unsigned int features, int num_lights) {
+
+		// Features live in the low bits, so they must not spill into the light count.
+		assert(features < (1 << SHADER_LIGHTS_SHIFT));
+		assert(num_lights > 0);
+
+		unsigned int key = features | (num_lights << SHADER_LIGHTS_SHIFT);
+
+		// Compile it only the first time.
+		auto found = this->shaders.find(key);
+		if (found != this->shaders.end())
+			return found->second;
+
+		Shader shader(this->vertex_filename.c_str(), this->fragment_filename.c_str(), ShaderLibrary::makeDefines(features, num_lights), this->cache);
+
+		return this->shaders.emplace(key, std::move(shader)).first->second;
+
+	}
+
+	size_t ShaderLibrary::size() const {
+
+		return this->shaders.size();
+
+	}
+
+	size_t ShaderLibrary::reload(const std::string &filename, const std::string &contents) {
+
+		size_t reloaded = 0;
+
+		for (auto &entry : this->shaders)
+			if (entry.second.reload(filename, contents))
+				reloaded++;
+
+		return reloaded;
+
+	}
+
+	void ShaderLibrary::remove() {
+
+		for (auto &entry : this->shaders)
+			entry.second.remove();
+
+		this->shaders.clear();
+
+	}
+
+	std::string ShaderLibrary::makeDefines(unsigned int features, int num_lights) {
+
+		std::string defines = "";
+
+		if (features & SHADER_NORMAL_MAP)
+			defines.append("#define NORMAL_MAP\n");
+
+		// The parallax also needs the tangents and the bump map.
+		if (features & (SHADER_BUMP_MAP | SHADER_PARALLAX))
+			defines.append("#define BUMP_MAP\n");
+
+		if (features & SHADER_FRESNEL)
+			defines.append("#define FRESNEL\n");
+
+		if (features & SHADER_GAMMA)
+			defines.append("#define GAMMA\n");
+
+		if (features & SHADER_VIRTUAL)
+			defines.append("#define VIRTUAL_TEXTURE\n");
+
+		if (features & SHADER_FEEDBACK)
+			defines.append("#define FEEDBACK\n");
+
+		// The range has to match the one the derivatives were baked with.
+		if (features & SHADER_DERIVATIVE_MAP)
+			defines.append("#define DERIVATIVE_MAP\n#define DERIVATIVE_RANGE " + std::to_string(BUMP_DERIVATIVE_RANGE) + "\n");
+
+		if (features & SHADER_BUMP_SCREEN)
+			defines.append("#define BUMP_SCREEN\n");
+
+		if (features & SHADER_BUMP_FIXED)
+			defines.append("#define BUMP_FIXED\n");
+
+		if (features & SHADER_PARALLAX)
+			defines.append("#define PARALLAX\n");
+
+		defines.append("#define NUM_LIGHTS " + std::to_string(num_lights) + "\n");
+
+		return defines;
+
+	}
+
+}  // namespace bgq_opengl
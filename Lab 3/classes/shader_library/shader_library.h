@@ -0,0 +1,137 @@
+/**
+ * @file shader_library.h
+ * @brief ShaderLibrary class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SHADER_LIBRARY_H_
+#define BGQ_OPENGL_CLASSES_SHADER_LIBRARY_H_
+
+#define SHADER_NORMAL_MAP 0x01	/// Take the normal from the normal map.
+#define SHADER_BUMP_MAP 0x02	/// Derive the normal from the bump map.
+#define SHADER_FRESNEL 0x04		/// Mix in the skybox reflection and refraction.
+#define SHADER_GAMMA 0x08		/// Gamma correct the output.
+#define SHADER_VIRTUAL 0x10		/// Sample the bump and normal maps through the virtual texture.
+#define SHADER_FEEDBACK 0x20	/// Output the virtual texture pages asked for instead of a color.
+#define SHADER_DERIVATIVE_MAP 0x40	/// Take the slopes of the bump map from its baked derivative map.
+#define SHADER_BUMP_SCREEN 0x80	/// Take the slopes of the bump map from screen space derivatives.
+#define SHADER_BUMP_FIXED 0x100	/// Take the slopes of the bump map from taps a fixed distance apart.
+#define SHADER_PARALLAX 0x200	/// Parallax occlusion mapping with the bump map, which it turns on.
+#define SHADER_LIGHTS_SHIFT 12	/// First bit of the light count within a permutation key.
+
+#include <map>
+#include <string>
+
+#include "classes/program_cache/program_cache.h"
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a ShaderLibrary class.
+	 *
+	 * Builds permutations of a single über-shader by prepending #defines to its
+	 * sources. Only the permutations that are requested get compiled, and each
+	 * one is kept by its feature bitmask so asking again is free. Since the
+	 * features are compile time constants, the driver can strip everything a
+	 * permutation does not use.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ShaderLibrary {
+
+		public:
+
+			/**
+			 * @brief Construct the library.
+			 *
+			 * Construct an empty library.
+			 */
+			ShaderLibrary();
+
+			/**
+			 * @brief Construct the library.
+			 *
+			 * Construct the library for an über-shader.
+			 *
+			 * @param vertex_filename Vertex shader filename.
+			 * @param fragment_filename Fragment shader filename.
+			 * @param cache The program binary cache, or nullptr to always compile.
+			 */
+			ShaderLibrary(const char* vertex_filename, const char* fragment_filename, const ProgramCache* cache = nullptr);
+
+			/**
+			 * @brief Get a permutation.
+			 *
+			 * Get the permutation with the given features, compiling it the first
+			 * time it is requested.
+			 *
+			 * @param features A combination of the SHADER_* feature bits.
+			 * @param num_lights The number of lights the permutation will shade with.
+			 *
+			 * @returns The shader of the permutation.
+			 */
+			Shader& get(unsigned int features, int num_lights = 1);
+
+			/**
+			 * @brief Get the number of permutations.
+			 *
+			 * Get the number of permutations compiled so far.
+			 *
+			 * @returns The number of permutations.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Reload the permutations after a file changed.
+			 *
+			 * Rebuilds every permutation with the new contents of the über-shader.
+			 * Permutations that fail keep their old program.
+			 *
+			 * @param filename The file that changed.
+			 * @param contents The new contents of the file.
+			 *
+			 * @returns The number of permutations that were replaced.
+			 */
+			size_t reload(const std::string &filename, const std::string &contents);
+
+			/**
+			 * @brief Remove every permutation from OpenGL.
+			 *
+			 * Remove every permutation from OpenGL.
+			 */
+			void remove();
+
+			/**
+			 * @brief Builds the defines of a permutation.
+			 *
+			 * Builds the preprocessor lines that enable the given features.
+			 *
+			 * @param features A combination of the SHADER_* feature bits.
+			 * @param num_lights The number of lights.
+			 *
+			 * @returns The defines, one per line.
+			 */
+			static std::string makeDefines(unsigned int features, int num_lights);
+
+		private:
+
+			std::string vertex_filename = "";			/// Vertex shader filename.
+			std::string fragment_filename = "";			/// Fragment shader filename.
+			const ProgramCache* cache = nullptr;		/// Program binary cache.
+			std::map<unsigned int, Shader> shaders;		/// Compiled permutations by key.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_SHADER_LIBRARY_H_
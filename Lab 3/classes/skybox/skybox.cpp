@@ -15,20 +15,25 @@
 
 #include "skybox.h"
 
-#include <vector>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/command_recorder/command_recorder.h"
 #include "classes/shader/shader.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/ebo/ebo.h"
+#include "classes/vao/vao.h"
+#include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
 
-    Skybox::Skybox(Cubemap cubemap) {
+    Skybox::Skybox(std::shared_ptr<Cubemap> cubemap) {
         
         // Store the cubemap.
         this->cubemap = cubemap;
@@ -44,7 +49,7 @@ namespace bgq_opengl {
             -1.0f,  1.0f, -1.0f
         };
 
-        unsigned int indices[] = {
+        std::vector<GLuint> indices = {
             1, 2, 6,
             6, 5, 1,
             0, 4, 7,
@@ -59,40 +64,27 @@ namespace bgq_opengl {
             6, 2, 3
         };
         
-        // Create VAO, VBO, and EBO for the skybox.
-        glGenVertexArrays(1, &this->vao);
-        glGenBuffers(1, &this->vbo);
-        glGenBuffers(1, &this->ebo);
-        
-        // Bind them.
-        glBindVertexArray(this->vao);
-        
-        // Fill the VBo with the vertices.
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
-        
-        // Fill the indices into the EBO.
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), &indices, GL_STATIC_DRAW);
+        // Create the VAO, and the VBO and EBO for the skybox while it is bound.
+        this->vao.bind();
+        this->vbo = VBO(vertices, sizeof(vertices));
+        this->ebo = EBO(indices);
         
         // Pass the data to the layout.
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        this->vao.link_attribute(this->vbo, 0, 3, GL_FLOAT, 3 * sizeof(float), (void*)0);
         
         // Unbind everything.
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        this->vao.unbind();
+        this->ebo.unbind();
 
     }
 
-    Cubemap Skybox::getCubemap() {
+    std::shared_ptr<Cubemap> Skybox::getCubemap() {
         
         return this->cubemap;
         
     }
 
-    void Skybox::setCubemap(Cubemap cubemap) {
+    void Skybox::setCubemap(std::shared_ptr<Cubemap> cubemap) {
         
         this->cubemap = cubemap;
         
@@ -111,16 +103,16 @@ namespace bgq_opengl {
         glm::mat4 projection = camera.getProjection();
 
         // Pass these matrices to the shaders.
-        glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "View"), 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        glUniformMatrix4fv(shader.getUniformLocation("View"), 1, GL_FALSE, glm::value_ptr(view));
+        glUniformMatrix4fv(shader.getUniformLocation("Projection"), 1, GL_FALSE, glm::value_ptr(projection));
 
         // Draws the cubemap as the last object so we can save a bit of performance by discarding all fragments
         // where an object is present (a depth of 1.0f will always fail against any object's depth value)
-        glBindVertexArray(this->vao);
+        this->vao.bind();
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.getID());
-        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, this->cubemap->getID());
+        CommandRecorder::drawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        this->vao.unbind();
 
         // Switch back to the normal depth function
         glDepthFunc(GL_LESS);
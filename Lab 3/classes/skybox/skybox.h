@@ -16,6 +16,7 @@
 #ifndef BGQ_OPENGL_CLASSES_SKYBOX_H_
 #define BGQ_OPENGL_CLASSES_SKYBOX_H_
 
+#include <memory>
 #include <vector>
 
 #include "GL/glew.h"
@@ -49,9 +50,9 @@ namespace bgq_opengl {
 			 * 
 			 * Initializes the geometry and stores it.
 			 *
-			 * @param cubemap Textures in connection with this geometry.
+			 * @param cubemap Textures in connection with this geometry, shared with whoever else holds it.
 			 */
-            Skybox(Cubemap cubemap);
+            Skybox(std::shared_ptr<Cubemap> cubemap);
 			
 			/**
 			 * @brief Get the textures.
@@ -60,7 +61,7 @@ namespace bgq_opengl {
              *
              * @returns The cubemap.
 			 */
-			Cubemap getCubemap();
+			std::shared_ptr<Cubemap> getCubemap();
         
             /**
              * @brief Get the textures.
@@ -69,7 +70,7 @@ namespace bgq_opengl {
              *
              * @param cubemap The cubemap that will be set as the current cubemap.
              */
-            void setCubemap(Cubemap cubemap);
+            void setCubemap(std::shared_ptr<Cubemap> cubemap);
 
 			/**
 			 * @brief Draws the Geometry.
@@ -80,8 +81,10 @@ namespace bgq_opengl {
 
 		private:
 
-            Cubemap cubemap = Cubemap(0, "", 0);    /// The cubemap texture that will color this skybox.
-            unsigned int vao, vbo, ebo;             /// The IDs of the buffers of OpenGL.
+            std::shared_ptr<Cubemap> cubemap;       /// The cubemap texture that will color this skybox.
+            VAO vao;                                /// The vertex array of the cube.
+            VBO vbo;                                /// The vertices of the cube.
+            EBO ebo;                                /// The indices of the cube.
 
 	};
 
@@ -0,0 +1,1139 @@
+/**
+ * @file software_renderer.cpp
+ * @brief SoftwareRenderer class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "software_renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "stb/stb_image.h"
+
+#include "classes/block_compressor/block_compressor.h"
+#include "classes/camera/camera.h"
+#include "classes/job_runner/job_runner.h"
+#include "classes/light/light.h"
+#include "classes/mip_chain/mip_chain.h"
+#include "classes/object/object.h"
+#include "classes/shader_library/shader_library.h"
+#include "structs/lanes/lanes.h"
+
+namespace bgq_opengl {
+
+	SoftwareRenderer::SoftwareRenderer() {
+
+	}
+
+	SoftwareRenderer::SoftwareRenderer(int width, int height, int threads, bool vectorized) {
+
+		this->width = width;
+		this->height = height;
+		this->tiles_x = (width + SOFTWARE_TILE - 1) / SOFTWARE_TILE;
+		this->tiles_y = (height + SOFTWARE_TILE - 1) / SOFTWARE_TILE;
+		this->threads = JobRunner::getThreads(threads);
+		this->vectorized = vectorized;
+
+		this->color.resize((size_t) width * height * 4);
+		this->depth.resize((size_t) width * height);
+		this->fragment_counts.resize((size_t) this->tiles_x * this->tiles_y);
+
+		this->clear(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+	}
+
+	void SoftwareRenderer::clear(const glm::vec4 &color) {
+
+		unsigned char texel[4];
+		for (int channel = 0; channel < 4; channel++)
+			texel[channel] = (unsigned char) (glm::clamp(color[channel], 0.0f, 1.0f) * 255.0f + 0.5f);
+
+		for (size_t i = 0; i < this->depth.size(); i++)
+			memcpy(&this->color[i * 4], texel, 4);
+
+		std::fill(this->depth.begin(), this->depth.end(), 1.0f);
+		std::fill(this->fragment_counts.begin(), this->fragment_counts.end(), 0);
+		this->triangle_count = 0;
+
+	}
+
+	void SoftwareRenderer::setCamera(const Camera &camera) {
+
+		this->projection = camera.getProjection();
+		this->view = camera.getView();
+
+	}
+
+	void SoftwareRenderer::setLight(Light light) {
+
+		this->light = light;
+
+	}
+
+	void SoftwareRenderer::setMultipliers(float coord_mult, float bump_mult) {
+
+		this->coord_mult = coord_mult;
+		this->bump_mult = bump_mult;
+
+	}
+
+	void SoftwareRenderer::draw(Object &object, const InstanceData &instance, const SoftwareMaterial &material, unsigned int features) {
+
+		const std::vector<Geometry> &geometries = object.getGeometries();
+
+		for (size_t i = 0; i < geometries.size(); i++)
+			this->draw(geometries[i].getVertices(), geometries[i].getIndices(), instance, material, features, geometries[i].getShininess());
+
+	}
+
+	void SoftwareRenderer::draw(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const InstanceData &instance, const SoftwareMaterial &material, unsigned int features, float shininess) {
+
+		if (this->width == 0 || indices.size() < 3)
+			return;
+
+		// Vertex stage, the same as uber.vert.
+		this->shaded.resize(vertices.size());
+
+		glm::mat4 model_view_projection = this->projection * instance.model_view;
+		glm::mat3 model_view = glm::mat3(instance.model_view);
+		glm::mat3 normal_matrix = glm::mat3(instance.normal_matrix);
+		glm::vec3 translation = glm::vec3(instance.model_view[3]);
+
+		JobRunner::run((int) ((vertices.size() + SOFTWARE_VERTEX_BATCH - 1) / SOFTWARE_VERTEX_BATCH), this->threads, [&](int job) {
+
+			size_t last = std::min(vertices.size(), (size_t) (job + 1) * SOFTWARE_VERTEX_BATCH);
+
+			for (size_t i = (size_t) job * SOFTWARE_VERTEX_BATCH; i < last; i++) {
+
+				const Vertex &vertex = vertices[i];
+				ShadedVertex &out = this->shaded[i];
+
+				glm::vec3 position = model_view * vertex.position + translation;
+				glm::vec3 normal = normal_matrix * vertex.normal;
+				glm::vec3 tangent = normal_matrix * vertex.tangent;
+				glm::vec3 bitangent = normal_matrix * vertex.bitangent;
+
+				out.clip = model_view_projection * glm::vec4(vertex.position, 1.0f);
+
+				// The UVs are turned a quarter, as the vertex shader does.
+				float varyings[SOFTWARE_VARYINGS] = {
+					position.x, position.y, position.z,
+					normal.x, normal.y, normal.z,
+					vertex.uv.y, -vertex.uv.x,
+					tangent.x, tangent.y, tangent.z,
+					bitangent.x, bitangent.y, bitangent.z
+				};
+
+				memcpy(out.varyings, varyings, sizeof(varyings));
+
+			}
+
+		});
+
+		// Set the triangles up and bin them. Every job keeps its own bins, so no locks are needed,
+		// and the tiles read them job after job, which keeps the triangles in order.
+		size_t triangle_total = indices.size() / 3;
+		int jobs = (int) ((triangle_total + SOFTWARE_TRIANGLE_BATCH - 1) / SOFTWARE_TRIANGLE_BATCH);
+		int tiles = this->tiles_x * this->tiles_y;
+
+		if ((int) this->triangles.size() < jobs)
+			this->triangles.resize(jobs);
+
+		if ((int) this->bins.size() < jobs * tiles)
+			this->bins.resize((size_t) jobs * tiles);
+
+		JobRunner::run(jobs, this->threads, [&](int job) {
+
+			this->triangles[job].clear();
+			for (int tile = 0; tile < tiles; tile++)
+				this->bins[(size_t) job * tiles + tile].clear();
+
+			size_t last = std::min(triangle_total, (size_t) (job + 1) * SOFTWARE_TRIANGLE_BATCH);
+
+			for (size_t i = (size_t) job * SOFTWARE_TRIANGLE_BATCH; i < last; i++) {
+
+				const ShadedVertex* corners[3] = { &this->shaded[indices[i * 3]], &this->shaded[indices[i * 3 + 1]], &this->shaded[indices[i * 3 + 2]] };
+				this->clipTriangle(corners, job);
+
+			}
+
+		});
+
+		for (int job = 0; job < jobs; job++)
+			this->triangle_count += this->triangles[job].size();
+
+		// Rasterize and shade every tile.
+		glm::vec3 light_position = glm::vec3(this->view * glm::vec4(this->light.getPosition(), 1.0f));
+
+		JobRunner::run(tiles, this->threads, [&](int tile) {
+
+			this->rasterizeTile(tile, jobs, material, features, shininess, light_position);
+
+		});
+
+	}
+
+	const std::vector<unsigned char>& SoftwareRenderer::getPixels() const {
+
+		return this->color;
+
+	}
+
+	int SoftwareRenderer::getWidth() const {
+
+		return this->width;
+
+	}
+
+	int SoftwareRenderer::getHeight() const {
+
+		return this->height;
+
+	}
+
+	int SoftwareRenderer::getThreads() const {
+
+		return this->threads;
+
+	}
+
+	size_t SoftwareRenderer::getTriangles() const {
+
+		return this->triangle_count;
+
+	}
+
+	size_t SoftwareRenderer::getFragments() const {
+
+		size_t fragments = 0;
+
+		for (size_t i = 0; i < this->fragment_counts.size(); i++)
+			fragments += this->fragment_counts[i];
+
+		return fragments;
+
+	}
+
+	SoftwareTexture SoftwareRenderer::loadTexture(const std::string &image, int usage) {
+
+		// Same as the textures, flip them so they are not upside down.
+		stbi_set_flip_vertically_on_load(true);
+
+		SoftwareTexture texture;
+		int channels;
+		unsigned char* image_bytes = stbi_load(image.c_str(), &texture.width, &texture.height, &channels, 4);
+
+		if (image_bytes == nullptr) {
+
+			std::cerr << "SoftwareRenderer error - Could not load " << image << ": " << stbi_failure_reason() << std::endl;
+			exit(1);
+
+		}
+
+		texture.srgb = usage == TEXTURE_USAGE_COLOR;
+		texture.levels.push_back(std::vector<unsigned char>(image_bytes, image_bytes + (size_t) texture.width * texture.height * 4));
+		stbi_image_free(image_bytes);
+
+		SoftwareRenderer::buildLevels(&texture);
+
+		return texture;
+
+	}
+
+	void SoftwareRenderer::benchmark(std::ostream &out) {
+
+		const int size = 512;
+		const int batches = 2000;
+		const char* names[3] = { "Blinn-Phong", "Bump map", "Normal map" };
+		const unsigned int features[3] = { SHADER_GAMMA, SHADER_BUMP_MAP | SHADER_GAMMA, SHADER_NORMAL_MAP | SHADER_GAMMA };
+
+		// Checks for the colors, rolling hills for the bumps and the normals they would bake to.
+		SoftwareMaterial material;
+		material.color.width = material.bump.width = material.normal.width = size;
+		material.color.height = material.bump.height = material.normal.height = size;
+		material.color.srgb = true;
+
+		std::vector<unsigned char> color_pixels((size_t) size * size * 4), bump_pixels((size_t) size * size * 4), normal_pixels((size_t) size * size * 4);
+
+		for (int y = 0; y < size; y++) {
+
+			for (int x = 0; x < size; x++) {
+
+				size_t i = ((size_t) y * size + x) * 4;
+				float slope_x = std::cos(x * 0.05f) * std::cos(y * 0.07f);
+				float slope_y = -std::sin(x * 0.05f) * std::sin(y * 0.07f);
+				float length = std::sqrt(slope_x * slope_x + slope_y * slope_y + 1.0f);
+				bool check = ((x / 32) + (y / 32)) % 2 == 0;
+
+				unsigned char texel_color[4] = { (unsigned char) (check ? 200 : 60), (unsigned char) (check ? 120 : 90), (unsigned char) (check ? 40 : 160), 255 };
+				unsigned char texel_bump[4] = { (unsigned char) (127.5f + 127.5f * std::sin(x * 0.05f) * std::cos(y * 0.07f)), 0, 0, 255 };
+				unsigned char texel_normal[4] = { (unsigned char) (127.5f - 127.5f * slope_x / length), (unsigned char) (127.5f - 127.5f * slope_y / length), (unsigned char) (127.5f + 127.5f / length), 255 };
+
+				memcpy(&color_pixels[i], texel_color, 4);
+				memcpy(&bump_pixels[i], texel_bump, 4);
+				memcpy(&normal_pixels[i], texel_normal, 4);
+
+			}
+
+		}
+
+		material.color.levels.push_back(std::move(color_pixels));
+		material.bump.levels.push_back(std::move(bump_pixels));
+		material.normal.levels.push_back(std::move(normal_pixels));
+		SoftwareRenderer::buildLevels(&material.color);
+		SoftwareRenderer::buildLevels(&material.bump);
+		SoftwareRenderer::buildLevels(&material.normal);
+
+		// A lit patch of a sphere in front of the camera, about one texel per pixel.
+		SoftwareRenderer renderer(SOFTWARE_TILE, SOFTWARE_TILE, 1);
+		renderer.setLight(Light(glm::vec3(1.0f, 2.0f, 1.0f), glm::vec4(1.0f)));
+		renderer.setMultipliers(1.0f, 1.0f);
+
+		std::unique_ptr<Fragments> fragments(new Fragments());
+		fragments->count = SOFTWARE_FRAGMENT_BATCH;
+
+		for (int i = 0; i < SOFTWARE_FRAGMENT_BATCH; i++) {
+
+			float x = (i % 16) / 16.0f - 0.5f;
+			float y = (i / 16) / 16.0f - 0.5f;
+			glm::vec3 normal = glm::normalize(glm::vec3(x, y, 1.0f));
+			glm::vec3 tangent = glm::normalize(glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), normal));
+			glm::vec3 bitangent = glm::cross(normal, tangent);
+			float varyings[SOFTWARE_VARYINGS] = {
+				x, y, -3.0f,
+				normal.x, normal.y, normal.z,
+				0.25f + (i % 16) / (float) size, 0.25f + (i / 16) / (float) size,
+				tangent.x, tangent.y, tangent.z,
+				bitangent.x, bitangent.y, bitangent.z
+			};
+
+			fragments->pixels[i] = (size_t) i;
+			for (int k = 0; k < SOFTWARE_VARYINGS; k++)
+				fragments->varyings[k][i] = varyings[k];
+
+			fragments->derivatives[0][i] = 1.0f / size;
+			fragments->derivatives[1][i] = 0.0f;
+			fragments->derivatives[2][i] = 0.0f;
+			fragments->derivatives[3][i] = 1.0f / size;
+
+		}
+
+		glm::vec3 light_position = renderer.light.getPosition();
+		double fragment_count = (double) batches * SOFTWARE_FRAGMENT_BATCH;
+
+		out << "SoftwareRenderer shading benchmark, " << LANES_NAME << " with " << LANES_WIDTH << " lanes, one core:" << std::endl;
+
+		for (int model = 0; model < 3; model++) {
+
+			double rates[2];
+			float colors[2][3][SOFTWARE_FRAGMENT_BATCH];
+
+			for (int run = 0; run < 2; run++) {
+
+				renderer.vectorized = run == 1;
+
+				auto start = std::chrono::steady_clock::now();
+
+				for (int batch = 0; batch < batches; batch++)
+					renderer.shadeFragments(*fragments, material, features[model], 200.0f, light_position);
+
+				double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				rates[run] = fragment_count / seconds / 1e6;
+				memcpy(colors[run], fragments->colors, sizeof(fragments->colors));
+
+			}
+
+			// How far apart the two would be once written out.
+			int difference = 0;
+
+			for (int channel = 0; channel < 3; channel++)
+				for (int i = 0; i < SOFTWARE_FRAGMENT_BATCH; i++)
+					difference = std::max(difference, std::abs((int) (glm::clamp(colors[0][channel][i], 0.0f, 1.0f) * 255.0f + 0.5f) - (int) (glm::clamp(colors[1][channel][i], 0.0f, 1.0f) * 255.0f + 0.5f)));
+
+			out << "    " << std::left << std::setw(12) << names[model] << std::right << std::fixed << std::setprecision(1)
+				<< " scalar " << rates[0] << " Mfragment/s, vector " << rates[1] << " Mfragment/s (" << std::setprecision(2) << rates[1] / rates[0]
+				<< "x), largest difference " << difference << "/255" << std::endl;
+
+		}
+
+	}
+
+	void SoftwareRenderer::clipTriangle(const ShadedVertex* corners[3], int job) {
+
+		// Near, far and the four sides of the guard band, as planes in clip space.
+		static const glm::vec4 planes[6] = {
+			glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+			glm::vec4(0.0f, 0.0f, -1.0f, 1.0f),
+			glm::vec4(1.0f, 0.0f, 0.0f, SOFTWARE_GUARD_BAND),
+			glm::vec4(-1.0f, 0.0f, 0.0f, SOFTWARE_GUARD_BAND),
+			glm::vec4(0.0f, 1.0f, 0.0f, SOFTWARE_GUARD_BAND),
+			glm::vec4(0.0f, -1.0f, 0.0f, SOFTWARE_GUARD_BAND)
+		};
+
+		// Most triangles need no clipping at all, and the ones fully outside a plane are dropped.
+		bool inside = true;
+
+		for (int plane = 0; plane < 6; plane++) {
+
+			float d0 = glm::dot(planes[plane], corners[0]->clip);
+			float d1 = glm::dot(planes[plane], corners[1]->clip);
+			float d2 = glm::dot(planes[plane], corners[2]->clip);
+
+			if (d0 < 0.0f && d1 < 0.0f && d2 < 0.0f)
+				return;
+
+			if (d0 < 0.0f || d1 < 0.0f || d2 < 0.0f)
+				inside = false;
+
+		}
+
+		if (inside) {
+
+			this->setupTriangle(*corners[0], *corners[1], *corners[2], job);
+			return;
+
+		}
+
+		// Every plane adds one vertex at most.
+		ShadedVertex buffers[2][9];
+		ShadedVertex* polygon = buffers[0];
+		int count = 3;
+
+		for (int i = 0; i < 3; i++)
+			polygon[i] = *corners[i];
+
+		for (int plane = 0; plane < 6 && count >= 3; plane++) {
+
+			const ShadedVertex* in = polygon;
+			ShadedVertex* out = polygon == buffers[0] ? buffers[1] : buffers[0];
+			int out_count = 0;
+
+			for (int i = 0; i < count; i++) {
+
+				const ShadedVertex &current = in[i];
+				const ShadedVertex &next = in[(i + 1) % count];
+				float current_distance = glm::dot(planes[plane], current.clip);
+				float next_distance = glm::dot(planes[plane], next.clip);
+
+				if (current_distance >= 0.0f)
+					out[out_count++] = current;
+
+				// The edge crosses the plane, so it gets a vertex where it does.
+				if ((current_distance >= 0.0f) != (next_distance >= 0.0f)) {
+
+					float t = current_distance / (current_distance - next_distance);
+					ShadedVertex &crossing = out[out_count++];
+
+					crossing.clip = glm::mix(current.clip, next.clip, t);
+					for (int k = 0; k < SOFTWARE_VARYINGS; k++)
+						crossing.varyings[k] = current.varyings[k] + (next.varyings[k] - current.varyings[k]) * t;
+
+				}
+
+			}
+
+			polygon = out;
+			count = out_count;
+
+		}
+
+		// The clipped polygon is convex, so a fan covers it.
+		for (int i = 1; i + 1 < count; i++)
+			this->setupTriangle(polygon[0], polygon[i], polygon[i + 1], job);
+
+	}
+
+	void SoftwareRenderer::setupTriangle(const ShadedVertex &v0, const ShadedVertex &v1, const ShadedVertex &v2, int job) {
+
+		const ShadedVertex* corners[3] = { &v0, &v1, &v2 };
+		int64_t x[3], y[3];
+		Triangle triangle;
+
+		// Snap to fixed point, in window coordinates with the bottom row first.
+		for (int i = 0; i < 3; i++) {
+
+			float inverse_w = 1.0f / corners[i]->clip.w;
+			float window_x = (corners[i]->clip.x * inverse_w * 0.5f + 0.5f) * this->width;
+			float window_y = (corners[i]->clip.y * inverse_w * 0.5f + 0.5f) * this->height;
+
+			x[i] = (int64_t) std::lround(window_x * (1 << SOFTWARE_SUBPIXEL_BITS));
+			y[i] = (int64_t) std::lround(window_y * (1 << SOFTWARE_SUBPIXEL_BITS));
+
+			triangle.depth[i] = corners[i]->clip.z * inverse_w * 0.5f + 0.5f;
+			triangle.inverse_w[i] = inverse_w;
+			for (int k = 0; k < SOFTWARE_VARYINGS; k++)
+				triangle.varyings[i][k] = corners[i]->varyings[k] * inverse_w;
+
+		}
+
+		// Twice the signed area. Nothing is culled, so the ones going clockwise are turned around.
+		int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+
+		if (area == 0)
+			return;
+
+		if (area < 0) {
+
+			std::swap(x[1], x[2]);
+			std::swap(y[1], y[2]);
+			std::swap(triangle.depth[1], triangle.depth[2]);
+			std::swap(triangle.inverse_w[1], triangle.inverse_w[2]);
+			std::swap(triangle.varyings[1], triangle.varyings[2]);
+			area = -area;
+
+		}
+
+		// The edge facing every vertex, which is its barycentric weight times the area.
+		for (int i = 0; i < 3; i++) {
+
+			int from = (i + 1) % 3, to = (i + 2) % 3;
+
+			triangle.a[i] = y[from] - y[to];
+			triangle.b[i] = x[to] - x[from];
+			triangle.c[i] = x[from] * y[to] - y[from] * x[to];
+
+			// A pixel right on an edge goes to only one of the two triangles sharing it.
+			bool owned = triangle.a[i] > 0 || (triangle.a[i] == 0 && triangle.b[i] > 0);
+			triangle.bias[i] = owned ? 0 : -1;
+
+		}
+
+		triangle.inverse_area = 1.0 / (double) area;
+
+		// The pixels whose centres may be inside.
+		int64_t half = 1 << (SOFTWARE_SUBPIXEL_BITS - 1);
+		int64_t min_x = std::min(x[0], std::min(x[1], x[2])), max_x = std::max(x[0], std::max(x[1], x[2]));
+		int64_t min_y = std::min(y[0], std::min(y[1], y[2])), max_y = std::max(y[0], std::max(y[1], y[2]));
+
+		triangle.min_x = (int) std::max<int64_t>(0, (min_x - half + (1 << SOFTWARE_SUBPIXEL_BITS) - 1) >> SOFTWARE_SUBPIXEL_BITS);
+		triangle.min_y = (int) std::max<int64_t>(0, (min_y - half + (1 << SOFTWARE_SUBPIXEL_BITS) - 1) >> SOFTWARE_SUBPIXEL_BITS);
+		triangle.max_x = (int) std::min<int64_t>(this->width - 1, (max_x - half) >> SOFTWARE_SUBPIXEL_BITS);
+		triangle.max_y = (int) std::min<int64_t>(this->height - 1, (max_y - half) >> SOFTWARE_SUBPIXEL_BITS);
+
+		if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y)
+			return;
+
+		// Bin it in every tile its box touches.
+		std::vector<Triangle> &set_up = this->triangles[job];
+		int index = (int) set_up.size();
+		int tiles = this->tiles_x * this->tiles_y;
+
+		set_up.push_back(triangle);
+
+		for (int tile_y = triangle.min_y / SOFTWARE_TILE; tile_y <= triangle.max_y / SOFTWARE_TILE; tile_y++)
+			for (int tile_x = triangle.min_x / SOFTWARE_TILE; tile_x <= triangle.max_x / SOFTWARE_TILE; tile_x++)
+				this->bins[(size_t) job * tiles + tile_y * this->tiles_x + tile_x].push_back(index);
+
+	}
+
+	void SoftwareRenderer::rasterizeTile(int tile, int jobs, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) {
+
+		int tiles = this->tiles_x * this->tiles_y;
+		int tile_min_x = (tile % this->tiles_x) * SOFTWARE_TILE;
+		int tile_min_y = (tile / this->tiles_x) * SOFTWARE_TILE;
+		int tile_max_x = std::min(tile_min_x + SOFTWARE_TILE, this->width) - 1;
+		int tile_max_y = std::min(tile_min_y + SOFTWARE_TILE, this->height) - 1;
+		int64_t one = 1 << SOFTWARE_SUBPIXEL_BITS;
+		int64_t half = one >> 1;
+		size_t fragment_count = 0;
+
+		// The fragments are shaded a batch at a time and written in the order they were queued,
+		// so a later one on the same pixel still wins.
+		Fragments fragments;
+
+		auto flush = [&]() {
+
+			this->shadeFragments(fragments, material, features, shininess, light_position);
+
+			for (int i = 0; i < fragments.count; i++) {
+
+				unsigned char* out = &this->color[fragments.pixels[i] * 4];
+				out[0] = (unsigned char) (glm::clamp(fragments.colors[0][i], 0.0f, 1.0f) * 255.0f + 0.5f);
+				out[1] = (unsigned char) (glm::clamp(fragments.colors[1][i], 0.0f, 1.0f) * 255.0f + 0.5f);
+				out[2] = (unsigned char) (glm::clamp(fragments.colors[2][i], 0.0f, 1.0f) * 255.0f + 0.5f);
+				out[3] = 255;
+
+			}
+
+			fragment_count += fragments.count;
+			fragments.count = 0;
+
+		};
+
+		for (int job = 0; job < jobs; job++) {
+
+			const std::vector<int> &bin = this->bins[(size_t) job * tiles + tile];
+
+			for (size_t n = 0; n < bin.size(); n++) {
+
+				const Triangle &triangle = this->triangles[job][bin[n]];
+
+				int min_x = std::max(triangle.min_x, tile_min_x), max_x = std::min(triangle.max_x, tile_max_x);
+				int min_y = std::max(triangle.min_y, tile_min_y), max_y = std::min(triangle.max_y, tile_max_y);
+
+				// Perspective correct UVs for some barycentric weights.
+				auto interpolateUV = [&triangle](const double* weights) {
+
+					float inverse_w = 0.0f, u = 0.0f, v = 0.0f;
+
+					for (int i = 0; i < 3; i++) {
+
+						inverse_w += (float) weights[i] * triangle.inverse_w[i];
+						u += (float) weights[i] * triangle.varyings[i][6];
+						v += (float) weights[i] * triangle.varyings[i][7];
+
+					}
+
+					return glm::vec2(u, v) / inverse_w;
+
+				};
+
+				for (int y = min_y; y <= max_y; y++) {
+
+					// The edges at the centre of the first pixel of the row, then stepped along it.
+					int64_t sample_x = (int64_t) min_x * one + half;
+					int64_t sample_y = (int64_t) y * one + half;
+					int64_t edges[3];
+
+					for (int i = 0; i < 3; i++)
+						edges[i] = triangle.a[i] * sample_x + triangle.b[i] * sample_y + triangle.c[i];
+
+					for (int x = min_x; x <= max_x; x++) {
+
+						if (edges[0] + triangle.bias[0] >= 0 && edges[1] + triangle.bias[1] >= 0 && edges[2] + triangle.bias[2] >= 0) {
+
+							double weights[3] = { edges[0] * triangle.inverse_area, edges[1] * triangle.inverse_area, edges[2] * triangle.inverse_area };
+							float depth = (float) (weights[0] * triangle.depth[0] + weights[1] * triangle.depth[1] + weights[2] * triangle.depth[2]);
+							size_t pixel = (size_t) y * this->width + x;
+
+							if (depth < this->depth[pixel]) {
+
+								this->depth[pixel] = depth;
+
+								float inverse_w = (float) (weights[0] * triangle.inverse_w[0] + weights[1] * triangle.inverse_w[1] + weights[2] * triangle.inverse_w[2]);
+								int slot = fragments.count++;
+
+								for (int k = 0; k < SOFTWARE_VARYINGS; k++)
+									fragments.varyings[k][slot] = (float) (weights[0] * triangle.varyings[0][k] + weights[1] * triangle.varyings[1][k] + weights[2] * triangle.varyings[2][k]) / inverse_w;
+
+								// The UVs of the pixels to the right and above, as a 2x2 quad on the GPU would give.
+								double right[3], above[3];
+
+								for (int i = 0; i < 3; i++) {
+
+									right[i] = (edges[i] + triangle.a[i] * one) * triangle.inverse_area;
+									above[i] = (edges[i] + triangle.b[i] * one) * triangle.inverse_area;
+
+								}
+
+								glm::vec2 uv(fragments.varyings[6][slot], fragments.varyings[7][slot]);
+								glm::vec2 uv_x = (interpolateUV(right) - uv) * this->coord_mult;
+								glm::vec2 uv_y = (interpolateUV(above) - uv) * this->coord_mult;
+
+								fragments.pixels[slot] = pixel;
+								fragments.derivatives[0][slot] = uv_x.x;
+								fragments.derivatives[1][slot] = uv_x.y;
+								fragments.derivatives[2][slot] = uv_y.x;
+								fragments.derivatives[3][slot] = uv_y.y;
+
+								if (fragments.count == SOFTWARE_FRAGMENT_BATCH)
+									flush();
+
+							}
+
+						}
+
+						for (int i = 0; i < 3; i++)
+							edges[i] += triangle.a[i] * one;
+
+					}
+
+				}
+
+			}
+
+		}
+
+		if (fragments.count > 0)
+			flush();
+
+		this->fragment_counts[tile] += fragment_count;
+
+	}
+
+	glm::vec3 SoftwareRenderer::shade(const float* varyings, const glm::vec2 &uv_x, const glm::vec2 &uv_y, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) const {
+
+		glm::vec3 position(varyings[0], varyings[1], varyings[2]);
+		glm::vec2 uv = glm::vec2(varyings[6], varyings[7]) * this->coord_mult;
+
+		// Get the normal ready to use.
+		glm::vec3 normal = glm::normalize(glm::vec3(varyings[3], varyings[4], varyings[5]));
+
+		if (features & (SHADER_NORMAL_MAP | SHADER_BUMP_MAP | SHADER_PARALLAX)) {
+
+			glm::vec3 tangent = glm::normalize(glm::vec3(varyings[8], varyings[9], varyings[10]));
+			glm::vec3 bitangent = glm::normalize(glm::vec3(varyings[11], varyings[12], varyings[13]));
+			glm::mat3 to_tangent_space(tangent, bitangent, normal);
+
+			if (features & SHADER_NORMAL_MAP) {
+
+				// The blue is rebuilt from the red and green, as the compressed maps do not keep it.
+				glm::vec4 mapped = SoftwareRenderer::sample(material.normal, uv, SoftwareRenderer::computeLevel(material.normal, uv_x, uv_y));
+				glm::vec2 xy = glm::vec2(mapped.x, mapped.y) * 2.0f - 1.0f;
+
+				normal = glm::normalize(to_tangent_space * glm::vec3(xy, std::sqrt(std::max(1.0f - glm::dot(xy, xy), 0.0f))));
+
+			} else {
+
+				// Taps one texel of the sampled level apart, and bumps as tall as on a 1024 pixel texture.
+				glm::vec2 size((float) material.bump.width, (float) material.bump.height);
+				float level = glm::clamp(SoftwareRenderer::computeLevel(material.bump, uv_x, uv_y), 0.0f, std::log2(std::max(size.x, size.y)));
+				glm::vec2 offset = glm::vec2(std::exp2(level)) / size;
+
+				float x_difference = SoftwareRenderer::sample(material.bump, glm::vec2(uv.x + offset.x, uv.y), level).x - SoftwareRenderer::sample(material.bump, glm::vec2(uv.x - offset.x, uv.y), level).x;
+				float y_difference = SoftwareRenderer::sample(material.bump, glm::vec2(uv.x, uv.y + offset.y), level).x - SoftwareRenderer::sample(material.bump, glm::vec2(uv.x, uv.y - offset.y), level).x;
+				glm::vec2 height_gradient = glm::vec2(x_difference, y_difference) / (2.0f * offset) * 2.0f * SOFTWARE_BUMP_DEFINITION;
+
+				normal = glm::normalize(to_tangent_space * glm::normalize(glm::vec3(0.0f, 0.0f, 1.0f) - glm::vec3(height_gradient, 0.0f) * this->bump_mult));
+
+			}
+
+		}
+
+		// Get the base color, which comes back linear.
+		glm::vec3 surface_color = glm::vec3(SoftwareRenderer::sample(material.color, uv, SoftwareRenderer::computeLevel(material.color, uv_x, uv_y)));
+
+		// Blinn-Phong with the one light, as in the shader.
+		float fragment_shininess = SOFTWARE_SHININESS * shininess;
+		glm::vec3 view_direction = glm::normalize(-position);
+		glm::vec3 fragment_color = surface_color * SOFTWARE_MIN_AMBIENT_LIGHT;
+
+		glm::vec3 light_direction = light_position - position;
+		float distance = glm::dot(light_direction, light_direction);
+		light_direction = glm::normalize(light_direction);
+
+		float lambertian = std::max(glm::dot(light_direction, normal), 0.0f);
+		float specular = 0.0f;
+
+		if (lambertian > 0.0f) {
+
+			glm::vec3 half_angle = glm::normalize(light_direction + view_direction);
+			specular = std::pow(std::max(glm::dot(half_angle, normal), 0.0f), fragment_shininess);
+
+		}
+
+		fragment_color += surface_color * (lambertian + specular) * glm::vec3(this->light.getColor()) * SOFTWARE_LIGHT_POWER / distance;
+
+		if (features & SHADER_GAMMA)
+			fragment_color = glm::pow(fragment_color, glm::vec3(1.0f / SOFTWARE_SCREEN_GAMMA));
+
+		return fragment_color;
+
+	}
+
+	void SoftwareRenderer::shadeFragments(Fragments &fragments, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) const {
+
+		if (this->vectorized) {
+
+			// Fill the rest of the last lanes with copies of the last fragment.
+			int padded = (fragments.count + LANES_WIDTH - 1) / LANES_WIDTH * LANES_WIDTH;
+
+			for (int i = fragments.count; i < padded; i++) {
+
+				for (int k = 0; k < SOFTWARE_VARYINGS; k++)
+					fragments.varyings[k][i] = fragments.varyings[k][fragments.count - 1];
+
+				for (int k = 0; k < 4; k++)
+					fragments.derivatives[k][i] = fragments.derivatives[k][fragments.count - 1];
+
+			}
+
+			for (int first = 0; first < padded; first += LANES_WIDTH)
+				this->shadeLanes(fragments, first, material, features, shininess, light_position);
+
+			return;
+
+		}
+
+		for (int i = 0; i < fragments.count; i++) {
+
+			float varyings[SOFTWARE_VARYINGS];
+			for (int k = 0; k < SOFTWARE_VARYINGS; k++)
+				varyings[k] = fragments.varyings[k][i];
+
+			glm::vec2 uv_x(fragments.derivatives[0][i], fragments.derivatives[1][i]);
+			glm::vec2 uv_y(fragments.derivatives[2][i], fragments.derivatives[3][i]);
+			glm::vec3 color = this->shade(varyings, uv_x, uv_y, material, features, shininess, light_position);
+
+			fragments.colors[0][i] = color.x;
+			fragments.colors[1][i] = color.y;
+			fragments.colors[2][i] = color.z;
+
+		}
+
+	}
+
+	void SoftwareRenderer::shadeLanes(Fragments &fragments, int first, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) const {
+
+		auto varying = [&](int k) { return Lanes::load(fragments.varyings[k] + first); };
+		auto normalize = [](Lanes* x, Lanes* y, Lanes* z) {
+
+			Lanes length = Lanes::sqrt(*x * *x + *y * *y + *z * *z);
+			*x = *x / length;
+			*y = *y / length;
+			*z = *z / length;
+
+		};
+
+		Lanes zero = Lanes::fill(0.0f);
+		Lanes one = Lanes::fill(1.0f);
+
+		Lanes position_x = varying(0), position_y = varying(1), position_z = varying(2);
+		Lanes normal_x = varying(3), normal_y = varying(4), normal_z = varying(5);
+		float u[LANES_WIDTH], v[LANES_WIDTH];
+		(varying(6) * Lanes::fill(this->coord_mult)).store(u);
+		(varying(7) * Lanes::fill(this->coord_mult)).store(v);
+
+		Lanes uv_x_u = Lanes::load(fragments.derivatives[0] + first), uv_x_v = Lanes::load(fragments.derivatives[1] + first);
+		Lanes uv_y_u = Lanes::load(fragments.derivatives[2] + first), uv_y_v = Lanes::load(fragments.derivatives[3] + first);
+
+		// The same level as computeLevel, for a texture of the given size.
+		auto computeLevels = [&](const SoftwareTexture &texture) {
+
+			Lanes width = Lanes::fill((float) texture.width), height = Lanes::fill((float) texture.height);
+			Lanes x_u = uv_x_u * width, x_v = uv_x_v * height;
+			Lanes y_u = uv_y_u * width, y_v = uv_y_v * height;
+
+			return Lanes::fill(0.5f) * Lanes::log2(Lanes::max(Lanes::max(x_u * x_u + x_v * x_v, y_u * y_u + y_v * y_v), Lanes::fill(1e-20f)));
+
+		};
+
+		float texels[4][LANES_WIDTH];
+		float levels[LANES_WIDTH];
+
+		// Get the normal ready to use.
+		normalize(&normal_x, &normal_y, &normal_z);
+
+		if (features & (SHADER_NORMAL_MAP | SHADER_BUMP_MAP | SHADER_PARALLAX)) {
+
+			Lanes tangent_x = varying(8), tangent_y = varying(9), tangent_z = varying(10);
+			Lanes bitangent_x = varying(11), bitangent_y = varying(12), bitangent_z = varying(13);
+			normalize(&tangent_x, &tangent_y, &tangent_z);
+			normalize(&bitangent_x, &bitangent_y, &bitangent_z);
+
+			Lanes x, y, z;
+
+			if (features & SHADER_NORMAL_MAP) {
+
+				// The blue is rebuilt from the red and green, as the compressed maps do not keep it.
+				computeLevels(material.normal).store(levels);
+				SoftwareRenderer::sampleLanes(material.normal, u, v, levels, 2, texels);
+
+				Lanes two = Lanes::fill(2.0f);
+				x = Lanes::load(texels[0]) * two - one;
+				y = Lanes::load(texels[1]) * two - one;
+				z = Lanes::sqrt(Lanes::max(one - x * x - y * y, zero));
+
+			} else {
+
+				// Taps one texel of the sampled level apart, and bumps as tall as on a 1024 pixel texture.
+				Lanes width = Lanes::fill((float) material.bump.width), height = Lanes::fill((float) material.bump.height);
+				Lanes level = Lanes::min(Lanes::max(computeLevels(material.bump), zero), Lanes::fill(std::log2((float) std::max(material.bump.width, material.bump.height))));
+				Lanes scale = Lanes::exp2(level);
+				Lanes offset_u = scale / width, offset_v = scale / height;
+				level.store(levels);
+
+				float shifted[LANES_WIDTH];
+				Lanes taps[4];
+
+				for (int tap = 0; tap < 4; tap++) {
+
+					Lanes offset = tap < 2 ? offset_u : offset_v;
+					Lanes shift = tap % 2 == 0 ? offset : zero - offset;
+					(Lanes::load(tap < 2 ? u : v) + shift).store(shifted);
+
+					SoftwareRenderer::sampleLanes(material.bump, tap < 2 ? shifted : u, tap < 2 ? v : shifted, levels, 1, texels);
+					taps[tap] = Lanes::load(texels[0]);
+
+				}
+
+				Lanes factor = Lanes::fill(SOFTWARE_BUMP_DEFINITION * this->bump_mult);
+				x = zero - (taps[0] - taps[1]) / offset_u * factor;
+				y = zero - (taps[2] - taps[3]) / offset_v * factor;
+				z = one;
+				normalize(&x, &y, &z);
+
+			}
+
+			// Into view space with the tangent frame.
+			Lanes mapped_x = tangent_x * x + bitangent_x * y + normal_x * z;
+			Lanes mapped_y = tangent_y * x + bitangent_y * y + normal_y * z;
+			Lanes mapped_z = tangent_z * x + bitangent_z * y + normal_z * z;
+			normalize(&mapped_x, &mapped_y, &mapped_z);
+
+			normal_x = mapped_x;
+			normal_y = mapped_y;
+			normal_z = mapped_z;
+
+		}
+
+		// Get the base color, which comes back linear.
+		computeLevels(material.color).store(levels);
+		SoftwareRenderer::sampleLanes(material.color, u, v, levels, 3, texels);
+
+		// Blinn-Phong with the one light, as in the shader.
+		Lanes view_x = zero - position_x, view_y = zero - position_y, view_z = zero - position_z;
+		normalize(&view_x, &view_y, &view_z);
+
+		Lanes light_x = Lanes::fill(light_position.x) - position_x;
+		Lanes light_y = Lanes::fill(light_position.y) - position_y;
+		Lanes light_z = Lanes::fill(light_position.z) - position_z;
+		Lanes distance = light_x * light_x + light_y * light_y + light_z * light_z;
+		normalize(&light_x, &light_y, &light_z);
+
+		Lanes lambertian = Lanes::max(light_x * normal_x + light_y * normal_y + light_z * normal_z, zero);
+
+		Lanes half_x = light_x + view_x, half_y = light_y + view_y, half_z = light_z + view_z;
+		normalize(&half_x, &half_y, &half_z);
+
+		// The power as 2^(n log2(x)), and none at all where the light is behind.
+		Lanes specular = Lanes::max(half_x * normal_x + half_y * normal_y + half_z * normal_z, zero);
+		specular = Lanes::exp2(Lanes::fill(SOFTWARE_SHININESS * shininess) * Lanes::log2(specular));
+		specular = Lanes::select(Lanes::greater(lambertian, zero), specular, zero);
+
+		Lanes lit = (lambertian + specular) * Lanes::fill(SOFTWARE_LIGHT_POWER) / distance;
+		glm::vec4 light_color = this->light.getColor();
+		float channel_colors[3] = { light_color.x, light_color.y, light_color.z };
+
+		for (int channel = 0; channel < 3; channel++) {
+
+			Lanes surface = Lanes::load(texels[channel]);
+			Lanes color = surface * Lanes::fill(SOFTWARE_MIN_AMBIENT_LIGHT) + surface * lit * Lanes::fill(channel_colors[channel]);
+
+			if (features & SHADER_GAMMA)
+				color = Lanes::exp2(Lanes::log2(color) * Lanes::fill(1.0f / SOFTWARE_SCREEN_GAMMA));
+
+			color.store(fragments.colors[channel] + first);
+
+		}
+
+	}
+
+	float SoftwareRenderer::computeLevel(const SoftwareTexture &texture, const glm::vec2 &uv_x, const glm::vec2 &uv_y) {
+
+		glm::vec2 size((float) texture.width, (float) texture.height);
+		glm::vec2 texels_x = uv_x * size;
+		glm::vec2 texels_y = uv_y * size;
+
+		return 0.5f * std::log2(std::max(std::max(glm::dot(texels_x, texels_x), glm::dot(texels_y, texels_y)), 1e-20f));
+
+	}
+
+	glm::vec4 SoftwareRenderer::sample(const SoftwareTexture &texture, const glm::vec2 &uv, float level) {
+
+		level = glm::clamp(level, 0.0f, (float) texture.levels.size() - 1.0f);
+
+		int finer = (int) level;
+		float blend = level - finer;
+
+		if (blend == 0.0f || finer + 1 >= (int) texture.levels.size())
+			return SoftwareRenderer::sampleLevel(texture, finer, uv);
+
+		return glm::mix(SoftwareRenderer::sampleLevel(texture, finer, uv), SoftwareRenderer::sampleLevel(texture, finer + 1, uv), blend);
+
+	}
+
+	glm::vec4 SoftwareRenderer::sampleLevel(const SoftwareTexture &texture, int level, const glm::vec2 &uv) {
+
+		// sRGB texels are decoded before they are filtered, as the GPU does.
+		static const std::vector<float> decode = []() {
+
+			std::vector<float> table(256);
+			for (int i = 0; i < 256; i++) {
+
+				float value = i / 255.0f;
+				table[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+
+			}
+
+			return table;
+
+		}();
+
+		int level_width = std::max(1, texture.width >> level);
+		int level_height = std::max(1, texture.height >> level);
+		const unsigned char* pixels = texture.levels[level].data();
+
+		float x = uv.x * level_width - 0.5f;
+		float y = uv.y * level_height - 0.5f;
+		float floor_x = std::floor(x), floor_y = std::floor(y);
+		float fraction_x = x - floor_x, fraction_y = y - floor_y;
+
+		// Repeat, also for the UVs far outside.
+		int x0 = (int) std::fmod(floor_x, (float) level_width);
+		int y0 = (int) std::fmod(floor_y, (float) level_height);
+		if (x0 < 0) x0 += level_width;
+		if (y0 < 0) y0 += level_height;
+		int x1 = (x0 + 1) % level_width;
+		int y1 = (y0 + 1) % level_height;
+
+		auto fetch = [&](int fetch_x, int fetch_y) {
+
+			const unsigned char* texel = pixels + ((size_t) fetch_y * level_width + fetch_x) * 4;
+
+			if (texture.srgb)
+				return glm::vec4(decode[texel[0]], decode[texel[1]], decode[texel[2]], texel[3] / 255.0f);
+
+			return glm::vec4(texel[0], texel[1], texel[2], texel[3]) / 255.0f;
+
+		};
+
+		return glm::mix(glm::mix(fetch(x0, y0), fetch(x1, y0), fraction_x), glm::mix(fetch(x0, y1), fetch(x1, y1), fraction_x), fraction_y);
+
+	}
+
+	void SoftwareRenderer::sampleLanes(const SoftwareTexture &texture, const float* u, const float* v, const float* level, int channels, float out[4][LANES_WIDTH]) {
+
+		// sRGB texels are decoded before they are filtered, as the GPU does.
+		static const std::vector<float> decode = []() {
+
+			std::vector<float> table(256);
+			for (int i = 0; i < 256; i++) {
+
+				float value = i / 255.0f;
+				table[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+
+			}
+
+			return table;
+
+		}();
+
+		int last = (int) texture.levels.size() - 1;
+		int finer[LANES_WIDTH];
+		float blends[LANES_WIDTH];
+		float widths[2][LANES_WIDTH], heights[2][LANES_WIDTH];
+		bool blended = false;
+
+		// The two levels of every lane and their sizes.
+		for (int lane = 0; lane < LANES_WIDTH; lane++) {
+
+			float clamped = glm::clamp(level[lane], 0.0f, (float) last);
+			finer[lane] = (int) clamped;
+			blends[lane] = finer[lane] < last ? clamped - finer[lane] : 0.0f;
+			blended = blended || blends[lane] != 0.0f;
+
+			for (int pass = 0; pass < 2; pass++) {
+
+				int fetched = std::min(finer[lane] + pass, last);
+				widths[pass][lane] = (float) std::max(1, texture.width >> fetched);
+				heights[pass][lane] = (float) std::max(1, texture.height >> fetched);
+
+			}
+
+		}
+
+		Lanes zero = Lanes::fill(0.0f);
+		Lanes one = Lanes::fill(1.0f);
+		Lanes results[4];
+
+		for (int pass = 0; pass < (blended ? 2 : 1); pass++) {
+
+			Lanes width = Lanes::load(widths[pass]), height = Lanes::load(heights[pass]);
+			Lanes x = Lanes::load(u) * width - Lanes::fill(0.5f);
+			Lanes y = Lanes::load(v) * height - Lanes::fill(0.5f);
+			Lanes floor_x = Lanes::floor(x), floor_y = Lanes::floor(y);
+			Lanes fraction_x = x - floor_x, fraction_y = y - floor_y;
+
+			// Repeat, also for the UVs far outside.
+			Lanes x0 = floor_x - Lanes::floor(floor_x / width) * width;
+			Lanes y0 = floor_y - Lanes::floor(floor_y / height) * height;
+			Lanes x1 = x0 + one, y1 = y0 + one;
+			x1 = Lanes::select(Lanes::greater(width, x1), x1, zero);
+			y1 = Lanes::select(Lanes::greater(height, y1), y1, zero);
+
+			float columns[2][LANES_WIDTH], rows[2][LANES_WIDTH];
+			x0.store(columns[0]);
+			x1.store(columns[1]);
+			y0.store(rows[0]);
+			y1.store(rows[1]);
+
+			// Only the fetches go one lane at a time, corner after corner.
+			float corners[4][4][LANES_WIDTH];
+
+			for (int lane = 0; lane < LANES_WIDTH; lane++) {
+
+				int fetched = std::min(finer[lane] + pass, last);
+				const unsigned char* pixels = texture.levels[fetched].data();
+				size_t level_width = (size_t) widths[pass][lane];
+
+				for (int corner = 0; corner < 4; corner++) {
+
+					const unsigned char* texel = pixels + ((size_t) rows[corner / 2][lane] * level_width + (size_t) columns[corner % 2][lane]) * 4;
+
+					for (int channel = 0; channel < channels; channel++)
+						corners[corner][channel][lane] = texture.srgb && channel < 3 ? decode[texel[channel]] : texel[channel] / 255.0f;
+
+				}
+
+			}
+
+			for (int channel = 0; channel < channels; channel++) {
+
+				Lanes bottom_left = Lanes::load(corners[0][channel]), bottom_right = Lanes::load(corners[1][channel]);
+				Lanes top_left = Lanes::load(corners[2][channel]), top_right = Lanes::load(corners[3][channel]);
+				Lanes bottom = bottom_left + (bottom_right - bottom_left) * fraction_x;
+				Lanes top = top_left + (top_right - top_left) * fraction_x;
+				Lanes filtered = bottom + (top - bottom) * fraction_y;
+
+				results[channel] = pass == 0 ? filtered : results[channel] + (filtered - results[channel]) * Lanes::load(blends);
+
+			}
+
+		}
+
+		for (int channel = 0; channel < channels; channel++)
+			results[channel].store(out[channel]);
+
+	}
+
+	void SoftwareRenderer::buildLevels(SoftwareTexture* texture) {
+
+		// Every level down to 1x1, the same box filter the baked chains use.
+		int level_width = texture->width, level_height = texture->height;
+
+		while (level_width > 1 || level_height > 1) {
+
+			std::vector<unsigned char> next((size_t) std::max(1, level_width >> 1) * std::max(1, level_height >> 1) * 4);
+			MipChain::downsample(texture->levels.back().data(), level_width, level_height, next.data());
+			texture->levels.push_back(std::move(next));
+
+			level_width = std::max(1, level_width >> 1);
+			level_height = std::max(1, level_height >> 1);
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
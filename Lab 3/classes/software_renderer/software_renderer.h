@@ -0,0 +1,479 @@
+/**
+ * @file software_renderer.h
+ * @brief SoftwareRenderer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_SOFTWARE_RENDERER_H_
+#define BGQ_OPENGL_CLASSES_SOFTWARE_RENDERER_H_
+
+#define SOFTWARE_TILE 64				/// Pixels along each side of a screen tile.
+#define SOFTWARE_SUBPIXEL_BITS 8		/// Fractional bits of the snapped vertex positions.
+#define SOFTWARE_GUARD_BAND 8.0f		/// Triangles are clipped this many times the screen away from its centre.
+#define SOFTWARE_VERTEX_BATCH 1024		/// Vertices every job transforms.
+#define SOFTWARE_TRIANGLE_BATCH 512		/// Triangles every job sets up and bins.
+#define SOFTWARE_VARYINGS 14			/// Floats passed from the vertices to the pixels.
+#define SOFTWARE_FRAGMENT_BATCH 256		/// Fragments of a tile queued before they are shaded together.
+
+#define SOFTWARE_SHININESS 10.0f		/// Same as SHININESS in uber.frag.
+#define SOFTWARE_LIGHT_POWER 10.0f		/// Same as LIGHT_POWER in uber.frag.
+#define SOFTWARE_MIN_AMBIENT_LIGHT 0.25f	/// Same as MIN_AMBIENT_LIGHT in uber.frag.
+#define SOFTWARE_SCREEN_GAMMA 2.2f		/// Same as SCREEN_GAMMA in uber.frag.
+#define SOFTWARE_BUMP_DEFINITION (1.0f / 1024.0f)	/// Same as BUMP_DEFINITION in uber.frag.
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/light/light.h"
+#include "classes/object/object.h"
+#include "structs/instance_data/instance_data.h"
+#include "structs/lanes/lanes.h"
+#include "structs/software_material/software_material.h"
+#include "structs/software_texture/software_texture.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a SoftwareRenderer class.
+	 *
+	 * Draws the same geometries, cameras, lights and maps as the über-shader
+	 * on the CPU, so there is an image to check against on machines without a
+	 * GPU and numbers that do not depend on a driver.
+	 *
+	 * Every draw transforms the vertices, then sets up the triangles and bins
+	 * them into the screen tiles they touch, and then rasterizes and shades
+	 * every tile. Each of the three is split in jobs, and every thread starts
+	 * on a range of its own and steals from the end of the others once it
+	 * runs out. A tile is only ever drawn by one thread, and the triangles of
+	 * a tile are drawn in the order they were given, so the image is the same
+	 * whatever the number of threads.
+	 *
+	 * The triangles are clipped to the near and far planes and to a guard
+	 * band, and snapped to fixed point, so the edges are exact and two
+	 * triangles sharing one never both draw a pixel on it. Everything is
+	 * interpolated with the perspective, and the maps are filtered
+	 * trilinearly with the level taken from how fast the UVs change.
+	 *
+	 * It shades the Blinn-Phong, bump and normal mapping permutations of
+	 * uber.frag, with the bump slopes taken from taps one texel apart. Other
+	 * feature bits are left out, and parallax is drawn as plain bump mapping.
+	 *
+	 * The fragments that pass the depth test are queued per tile with their
+	 * varyings laid out one array each, and shaded in batches as many at a
+	 * time as the lanes hold. The vector path uses fast logarithms and powers
+	 * for the specular and the gamma, so it is a little off the scalar one,
+	 * which follows the shader with the standard library.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class SoftwareRenderer {
+
+		public:
+
+			/**
+			 * @brief Construct the renderer.
+			 *
+			 * Construct an empty renderer.
+			 */
+			SoftwareRenderer();
+
+			/**
+			 * @brief Construct the renderer.
+			 *
+			 * Construct a renderer with a color and a depth buffer of the given
+			 * size, cleared.
+			 *
+			 * @param width Width of the image in pixels.
+			 * @param height Height of the image in pixels.
+			 * @param threads Number of threads, or 0 for one per core.
+			 * @param vectorized Whether to shade with the lanes or one fragment at a time.
+			 */
+			SoftwareRenderer(int width, int height, int threads = 0, bool vectorized = true);
+
+			/**
+			 * @brief Clears the image.
+			 *
+			 * Clears the color to the given one, the depth to the far plane and
+			 * the counters.
+			 *
+			 * @param color The color.
+			 */
+			void clear(const glm::vec4 &color);
+
+			/**
+			 * @brief Set the camera.
+			 *
+			 * Set the camera whose projection and view the next draws use.
+			 *
+			 * @param camera The camera.
+			 */
+			void setCamera(const Camera &camera);
+
+			/**
+			 * @brief Set the light.
+			 *
+			 * Set the point light the next draws are shaded with.
+			 *
+			 * @param light The light, in world space.
+			 */
+			void setLight(Light light);
+
+			/**
+			 * @brief Set the multipliers.
+			 *
+			 * Set the same UV and bump multipliers the shaders get.
+			 *
+			 * @param coord_mult The UV multiplier.
+			 * @param bump_mult The strength of the bumps.
+			 */
+			void setMultipliers(float coord_mult, float bump_mult);
+
+			/**
+			 * @brief Draws an object.
+			 *
+			 * Draws every geometry of an object with its shininess, the way
+			 * Object::draw does.
+			 *
+			 * @param object The object.
+			 * @param instance The precomputed matrices of this draw.
+			 * @param material The maps of the material.
+			 * @param features The SHADER_* feature bits of the permutation to match.
+			 */
+			void draw(Object &object, const InstanceData &instance, const SoftwareMaterial &material, unsigned int features);
+
+			/**
+			 * @brief Draws some triangles.
+			 *
+			 * Draws an indexed triangle list.
+			 *
+			 * @param vertices The vertices.
+			 * @param indices Three indices per triangle.
+			 * @param instance The precomputed matrices of this draw.
+			 * @param material The maps of the material.
+			 * @param features The SHADER_* feature bits of the permutation to match.
+			 * @param shininess The shininess of the material, as materialShininess.
+			 */
+			void draw(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const InstanceData &instance, const SoftwareMaterial &material, unsigned int features, float shininess);
+
+			/**
+			 * @brief Get the image.
+			 *
+			 * Get the pixels drawn so far, RGBA8 with the bottom row first, the
+			 * same as glReadPixels.
+			 *
+			 * @returns The pixels.
+			 */
+			const std::vector<unsigned char>& getPixels() const;
+
+			/**
+			 * @brief Get the width.
+			 *
+			 * Get the width of the image in pixels.
+			 *
+			 * @returns The width.
+			 */
+			int getWidth() const;
+
+			/**
+			 * @brief Get the height.
+			 *
+			 * Get the height of the image in pixels.
+			 *
+			 * @returns The height.
+			 */
+			int getHeight() const;
+
+			/**
+			 * @brief Get the number of threads.
+			 *
+			 * Get the number of threads every draw runs on.
+			 *
+			 * @returns The number of threads.
+			 */
+			int getThreads() const;
+
+			/**
+			 * @brief Get the number of triangles.
+			 *
+			 * Get the number of triangles set up since the last clear, after
+			 * clipping and without the ones off screen or with no area.
+			 *
+			 * @returns The number of triangles.
+			 */
+			size_t getTriangles() const;
+
+			/**
+			 * @brief Get the number of fragments.
+			 *
+			 * Get the number of fragments that passed the depth test and were
+			 * shaded since the last clear.
+			 *
+			 * @returns The number of fragments.
+			 */
+			size_t getFragments() const;
+
+			/**
+			 * @brief Loads a texture.
+			 *
+			 * Loads an image and builds its levels, the same way the texture
+			 * arrays are loaded for the given usage.
+			 *
+			 * @param image The image.
+			 * @param usage One of the TEXTURE_USAGE_ values. Colors are sRGB.
+			 *
+			 * @returns The texture.
+			 */
+			static SoftwareTexture loadTexture(const std::string &image, int usage);
+
+			/**
+			 * @brief Benchmarks the shading.
+			 *
+			 * Shades the same batches of fragments on one thread with every
+			 * shading model, one at a time and with the lanes, and prints how
+			 * many fragments a second a core gets through and how far apart
+			 * the two are.
+			 *
+			 * @param out Where to print the results.
+			 */
+			static void benchmark(std::ostream &out);
+
+		private:
+
+			/**
+			 * @brief A vertex after the vertex stage.
+			 *
+			 * Its clip space position and what gets interpolated: view space
+			 * position, normal, UVs, tangent and bitangent.
+			 */
+			struct ShadedVertex {
+
+				glm::vec4 clip;
+				float varyings[SOFTWARE_VARYINGS];
+
+			};
+
+			/**
+			 * @brief A triangle ready to rasterize.
+			 *
+			 * The edge functions in fixed point, their fill rule, the pixels it
+			 * may cover, and what is interpolated already divided by w.
+			 */
+			struct Triangle {
+
+				int64_t a[3];
+				int64_t b[3];
+				int64_t c[3];
+				int64_t bias[3];
+				double inverse_area;
+				int min_x, min_y, max_x, max_y;
+				float depth[3];
+				float inverse_w[3];
+				float varyings[3][SOFTWARE_VARYINGS];
+
+			};
+
+			/**
+			 * @brief Fragments waiting to be shaded.
+			 *
+			 * The pixels, varyings and UV derivatives of the fragments of a
+			 * tile, every one in an array of its own so the lanes load them
+			 * straight, and the colors they get.
+			 */
+			struct Fragments {
+
+				int count = 0;
+				size_t pixels[SOFTWARE_FRAGMENT_BATCH];
+				float varyings[SOFTWARE_VARYINGS][SOFTWARE_FRAGMENT_BATCH];
+				float derivatives[4][SOFTWARE_FRAGMENT_BATCH];
+				float colors[3][SOFTWARE_FRAGMENT_BATCH];
+
+			};
+
+			/**
+			 * @brief Clips and sets up a triangle.
+			 *
+			 * Clips a triangle to the near and far planes and the guard band, and
+			 * sets up and bins what is left.
+			 *
+			 * @param corners The three vertices.
+			 * @param job The job setting it up, which owns the triangles and bins.
+			 */
+			void clipTriangle(const ShadedVertex* corners[3], int job);
+
+			/**
+			 * @brief Sets up a triangle.
+			 *
+			 * Snaps a clipped triangle to the pixels, works out its edges and
+			 * adds it to the bins of the tiles it touches.
+			 *
+			 * @param v0 The first vertex.
+			 * @param v1 The second vertex.
+			 * @param v2 The third vertex.
+			 * @param job The job setting it up.
+			 */
+			void setupTriangle(const ShadedVertex &v0, const ShadedVertex &v1, const ShadedVertex &v2, int job);
+
+			/**
+			 * @brief Rasterizes a tile.
+			 *
+			 * Draws every triangle binned to a tile, in order.
+			 *
+			 * @param tile The tile.
+			 * @param jobs The number of setup jobs whose bins are read.
+			 * @param material The maps of the material.
+			 * @param features The feature bits.
+			 * @param shininess The shininess of the material.
+			 * @param light_position The light, in view space.
+			 */
+			void rasterizeTile(int tile, int jobs, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position);
+
+			/**
+			 * @brief Shades a pixel.
+			 *
+			 * Does what uber.frag does for a pixel.
+			 *
+			 * @param varyings The interpolated varyings.
+			 * @param uv_x How much the UVs change to the next pixel on the right.
+			 * @param uv_y How much the UVs change to the next pixel above.
+			 * @param material The maps of the material.
+			 * @param features The feature bits.
+			 * @param shininess The shininess of the material.
+			 * @param light_position The light, in view space.
+			 *
+			 * @returns The color.
+			 */
+			glm::vec3 shade(const float* varyings, const glm::vec2 &uv_x, const glm::vec2 &uv_y, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) const;
+
+			/**
+			 * @brief Shades the queued fragments.
+			 *
+			 * Works out the colors of every queued fragment, with the lanes or
+			 * one at a time.
+			 *
+			 * @param fragments The fragments.
+			 * @param material The maps of the material.
+			 * @param features The feature bits.
+			 * @param shininess The shininess of the material.
+			 * @param light_position The light, in view space.
+			 */
+			void shadeFragments(Fragments &fragments, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) const;
+
+			/**
+			 * @brief Shades a lane of fragments.
+			 *
+			 * Does what shade does for LANES_WIDTH fragments at once.
+			 *
+			 * @param fragments The fragments.
+			 * @param first The first of them.
+			 * @param material The maps of the material.
+			 * @param features The feature bits.
+			 * @param shininess The shininess of the material.
+			 * @param light_position The light, in view space.
+			 */
+			void shadeLanes(Fragments &fragments, int first, const SoftwareMaterial &material, unsigned int features, float shininess, const glm::vec3 &light_position) const;
+
+			/**
+			 * @brief Gets the level to sample.
+			 *
+			 * Gets the level of a texture the GPU would sample, from how fast the
+			 * UVs change across the pixel.
+			 *
+			 * @param texture The texture.
+			 * @param uv_x How much the UVs change to the next pixel on the right.
+			 * @param uv_y How much the UVs change to the next pixel above.
+			 *
+			 * @returns The level, not clamped.
+			 */
+			static float computeLevel(const SoftwareTexture &texture, const glm::vec2 &uv_x, const glm::vec2 &uv_y);
+
+			/**
+			 * @brief Samples a texture.
+			 *
+			 * Samples a texture trilinearly, repeating it.
+			 *
+			 * @param texture The texture.
+			 * @param uv The UVs.
+			 * @param level The level.
+			 *
+			 * @returns The color, linear if the texture is sRGB.
+			 */
+			static glm::vec4 sample(const SoftwareTexture &texture, const glm::vec2 &uv, float level);
+
+			/**
+			 * @brief Samples a level.
+			 *
+			 * Samples a level of a texture bilinearly, repeating it.
+			 *
+			 * @param texture The texture.
+			 * @param level The level.
+			 * @param uv The UVs.
+			 *
+			 * @returns The color, linear if the texture is sRGB.
+			 */
+			static glm::vec4 sampleLevel(const SoftwareTexture &texture, int level, const glm::vec2 &uv);
+
+			/**
+			 * @brief Samples a texture for the lanes.
+			 *
+			 * Samples a texture trilinearly at LANES_WIDTH UVs, each with its own
+			 * level. The coordinates and weights are worked out with the lanes,
+			 * and only the texels are fetched one by one.
+			 *
+			 * @param texture The texture.
+			 * @param u The horizontal UVs.
+			 * @param v The vertical UVs.
+			 * @param level The levels.
+			 * @param channels How many channels are needed, from the red one.
+			 * @param out Output for the channels, linear if the texture is sRGB.
+			 */
+			static void sampleLanes(const SoftwareTexture &texture, const float* u, const float* v, const float* level, int channels, float out[4][LANES_WIDTH]);
+
+			/**
+			 * @brief Builds the levels.
+			 *
+			 * Builds every level of a texture down to 1x1 from the first one.
+			 *
+			 * @param texture The texture, with only its first level.
+			 */
+			static void buildLevels(SoftwareTexture* texture);
+
+			std::vector<unsigned char> color;			/// Color buffer, RGBA8 with the bottom row first.
+			std::vector<float> depth;					/// Depth buffer, from 0 to 1.
+			std::vector<ShadedVertex> shaded;			/// Vertices of the current draw after the vertex stage.
+			std::vector<std::vector<Triangle>> triangles;	/// Triangles set up by every job of the current draw.
+			std::vector<std::vector<int>> bins;			/// Triangles of every job in every tile, job after job.
+			glm::mat4 projection = glm::mat4(1.0f);		/// Projection of the camera.
+			glm::mat4 view = glm::mat4(1.0f);			/// View of the camera.
+			Light light;								/// The light, in world space.
+			float coord_mult = 1.0f;					/// UV multiplier.
+			float bump_mult = 1.0f;						/// Strength of the bumps.
+			int width = 0;								/// Width of the image in pixels.
+			int height = 0;								/// Height of the image in pixels.
+			int tiles_x = 0;							/// Tiles along a row.
+			int tiles_y = 0;							/// Tiles along a column.
+			int threads = 1;							/// Number of threads.
+			bool vectorized = true;						/// Whether to shade with the lanes.
+			size_t triangle_count = 0;					/// Triangles set up since the last clear.
+			std::vector<size_t> fragment_counts;		/// Fragments shaded in every tile since the last clear.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_SOFTWARE_RENDERER_H_
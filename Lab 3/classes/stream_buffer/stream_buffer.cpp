@@ -0,0 +1,206 @@
+/**
+ * @file stream_buffer.cpp
+ * @brief StreamBuffer class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "stream_buffer.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	StreamBuffer::StreamBuffer() {
+
+	}
+
+	StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr region_size) {
+
+		// Store the parameters.
+		this->target = target;
+
+		// Get the alignment that the offsets will need to respect.
+		if (target == GL_UNIFORM_BUFFER)
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &this->alignment);
+
+		// Round the region size up so every region starts aligned.
+		this->region_size = (region_size + this->alignment - 1) / this->alignment * this->alignment;
+
+		// Generate the buffer.
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(this->target, this->ID);
+
+		// Use immutable, persistently mapped storage when the driver has it.
+		this->persistent = GLEW_ARB_buffer_storage;
+
+		if (this->persistent) {
+
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			GLsizeiptr total_size = this->region_size * STREAM_BUFFER_REGIONS;
+
+			glBufferStorage(this->target, total_size, NULL, flags);
+			this->mapped = (unsigned char*) glMapBufferRange(this->target, 0, total_size, flags);
+
+			// If mapping failed, forget about it and orphan instead.
+			if (this->mapped == nullptr) {
+
+				std::cerr << "StreamBuffer warning - Could not map the buffer persistently, orphaning instead." << std::endl;
+				glDeleteBuffers(1, &this->ID);
+				glGenBuffers(1, &this->ID);
+				glBindBuffer(this->target, this->ID);
+				this->persistent = false;
+
+			}
+
+		}
+
+		// The fallback only needs one region because it gets orphaned every frame.
+		if (!this->persistent)
+			glBufferData(this->target, this->region_size, NULL, GL_STREAM_DRAW);
+
+		glBindBuffer(this->target, 0);
+
+	}
+
+	void StreamBuffer::beginFrame() {
+
+		// Start writing at the beginning of the region.
+		this->head = 0;
+
+		if (this->persistent) {
+
+			// Make sure the GPU is not reading from this region anymore.
+			this->waitForRegion(this->current_region);
+
+		} else {
+
+			// Orphan the storage so the driver gives us a fresh block without syncing.
+			glBindBuffer(this->target, this->ID);
+			glBufferData(this->target, this->region_size, NULL, GL_STREAM_DRAW);
+			glBindBuffer(this->target, 0);
+
+		}
+
+	}
+
+	void StreamBuffer::endFrame() {
+
+		if (!this->persistent)
+			return;
+
+		// Fence everything issued this frame and move on to the next region.
+		this->fences[this->current_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->current_region = (this->current_region + 1) % STREAM_BUFFER_REGIONS;
+
+	}
+
+	GLintptr StreamBuffer::write(const void* data, GLsizeiptr size) {
+
+		// Align the write position.
+		GLsizeiptr start = (this->head + this->alignment - 1) / this->alignment * this->alignment;
+
+		if (start + size > this->region_size) {
+
+			std::cerr << "StreamBuffer error - The frame data does not fit in the buffer region." << std::endl;
+			exit(1);
+
+		}
+
+		this->head = start + size;
+
+		if (this->persistent) {
+
+			// Copy straight into the mapped memory.
+			GLintptr offset = this->current_region * this->region_size + start;
+			memcpy(this->mapped + offset, data, size);
+
+			return offset;
+
+		}
+
+		// Upload into the orphaned storage.
+		glBindBuffer(this->target, this->ID);
+		glBufferSubData(this->target, start, size, data);
+		glBindBuffer(this->target, 0);
+
+		return start;
+
+	}
+
+	void StreamBuffer::bindRange(GLuint index, GLintptr offset, GLsizeiptr size) {
+
+		glBindBufferRange(this->target, index, this->ID, offset, size);
+
+	}
+
+	GLuint StreamBuffer::getID() {
+
+		return this->ID;
+
+	}
+
+	bool StreamBuffer::isPersistent() {
+
+		return this->persistent;
+
+	}
+
+	void StreamBuffer::remove() {
+
+		// Wait for every region and get rid of the fences.
+		for (int i = 0; i < STREAM_BUFFER_REGIONS; i++)
+			this->waitForRegion(i);
+
+		// Unmap the buffer before deleting it.
+		if (this->mapped != nullptr) {
+
+			glBindBuffer(this->target, this->ID);
+			glUnmapBuffer(this->target);
+			glBindBuffer(this->target, 0);
+			this->mapped = nullptr;
+
+		}
+
+		glDeleteBuffers(1, &this->ID);
+
+	}
+
+	void StreamBuffer::waitForRegion(int region) {
+
+		GLsync fence = this->fences[region];
+
+		if (fence == 0)
+			return;
+
+		// Flush on the first try so the fence is guaranteed to signal eventually.
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+		while (true) {
+
+			GLenum result = glClientWaitSync(fence, flags, 1000000);
+
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+				break;
+
+			flags = 0;
+
+		}
+
+		glDeleteSync(fence);
+		this->fences[region] = 0;
+
+	}
+
+}  // namespace bgq_opengl
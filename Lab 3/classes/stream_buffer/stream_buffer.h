@@ -0,0 +1,146 @@
+/**
+ * @file stream_buffer.h
+ * @brief StreamBuffer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_STREAM_BUFFER_H_
+#define BGQ_OPENGL_CLASSES_STREAM_BUFFER_H_
+
+#define STREAM_BUFFER_REGIONS 3
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a StreamBuffer class.
+	 *
+	 * Implementation of a ring buffer for the data that changes every frame
+	 * (transforms, per-draw uniforms). When the driver supports buffer storage the
+	 * buffer is mapped persistently and split into one region per frame in flight,
+	 * each guarded by a fence. Otherwise (GL 3.2 / macOS) the buffer is orphaned at
+	 * the beginning of every frame and written with sub-data uploads.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class StreamBuffer {
+
+		public:
+
+			/**
+			 * @brief Constructs an empty stream buffer.
+			 *
+			 * Constructs an empty stream buffer with no OpenGL storage.
+			 */
+			StreamBuffer();
+
+			/**
+			 * @brief Constructs a stream buffer.
+			 *
+			 * Constructs a stream buffer and allocates its storage in OpenGL.
+			 *
+			 * @param target The buffer target (GL_UNIFORM_BUFFER, GL_ARRAY_BUFFER...).
+			 * @param region_size Bytes that can be written in a single frame.
+			 */
+			StreamBuffer(GLenum target, GLsizeiptr region_size);
+
+			/**
+			 * @brief Starts a new frame.
+			 *
+			 * Waits until the GPU is done with the region that will be written next,
+			 * or orphans the buffer when persistent mapping is not available.
+			 */
+			void beginFrame();
+
+			/**
+			 * @brief Ends the current frame.
+			 *
+			 * Fences the region written during this frame and advances the ring.
+			 */
+			void endFrame();
+
+			/**
+			 * @brief Writes data into the buffer.
+			 *
+			 * Copies the data into the current frame region, respecting the offset
+			 * alignment of the target.
+			 *
+			 * @param data The data to copy.
+			 * @param size The size of the data in bytes.
+			 *
+			 * @returns The offset of the data within the buffer.
+			 */
+			GLintptr write(const void* data, GLsizeiptr size);
+
+			/**
+			 * @brief Binds a range of the buffer to an indexed binding point.
+			 *
+			 * Binds a range of the buffer to an indexed binding point.
+			 *
+			 * @param index The binding point.
+			 * @param offset The offset returned by write.
+			 * @param size The size of the range in bytes.
+			 */
+			void bindRange(GLuint index, GLintptr offset, GLsizeiptr size);
+
+			/**
+			 * @brief Get the ID of the buffer.
+			 *
+			 * Get the ID of the buffer.
+			 *
+			 * @returns The OpenGL ID of the buffer.
+			 */
+			GLuint getID();
+
+			/**
+			 * @brief Check if the buffer is persistently mapped.
+			 *
+			 * Check if the buffer is persistently mapped.
+			 *
+			 * @returns True if the persistent path is in use.
+			 */
+			bool isPersistent();
+
+			/**
+			 * @brief Removes the buffer.
+			 *
+			 * Unmaps the buffer, deletes the fences and removes it from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			/**
+			 * @brief Waits for a region to be released by the GPU.
+			 *
+			 * Waits for the fence of a region and deletes it.
+			 *
+			 * @param region The region to wait for.
+			 */
+			void waitForRegion(int region);
+
+			GLuint ID = 0;										/// OpenGL ID of the buffer.
+			GLenum target = GL_UNIFORM_BUFFER;					/// Target the buffer is bound to.
+			GLsizeiptr region_size = 0;							/// Bytes per frame region.
+			GLint alignment = 1;								/// Offset alignment of the target.
+			int current_region = 0;								/// Region written this frame.
+			GLsizeiptr head = 0;								/// Write position within the region.
+			unsigned char* mapped = nullptr;					/// Persistent mapping of the whole buffer.
+			bool persistent = false;							/// Whether buffer storage is used.
+			GLsync fences[STREAM_BUFFER_REGIONS] = { 0, 0, 0 };	/// One fence per frame region.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_STREAM_BUFFER_H_
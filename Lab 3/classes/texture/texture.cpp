@@ -18,13 +18,20 @@
 #include "texture.h"
 
 #include <assert.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
 
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
+#include "classes/block_compressor/block_compressor.h"
+#include "classes/deletion_queue/deletion_queue.h"
+
 namespace bgq_opengl {
 
-	Texture::Texture(const char* image, const char* name, GLuint slot) {
+	Texture::Texture(const char* image, const char* name, GLuint slot, int usage) {
         
         // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
         if (slot < 1) assert(false);
@@ -38,9 +45,19 @@ namespace bgq_opengl {
 		// than this library, so images appear upside down.
 		stbi_set_flip_vertically_on_load(true);
 
-		// Read the texture image and its information.
-		unsigned char* image_bytes = stbi_load(image, &this->texture_width,
-				&this->texture_height, &this->texture_channels, 0);
+		// Read the texture image and its information. Bumps only keep their first channel.
+		int wanted_channels = usage == TEXTURE_USAGE_BUMP ? 1 : 0;
+		unsigned char* image_bytes = stbi_load(image, &this->texture_width, &this->texture_height, &this->texture_channels, wanted_channels);
+
+		if (image_bytes == nullptr) {
+
+			std::cerr << "Texture error - Could not load " << image << ": " << stbi_failure_reason() << std::endl;
+			exit(1);
+
+		}
+
+		if (wanted_channels != 0)
+			this->texture_channels = wanted_channels;
 
 		// Set the slot for the texture.
 		glActiveTexture(GL_TEXTURE0 + slot);
@@ -65,11 +82,46 @@ namespace bgq_opengl {
 		else
 			assert(false);
 
-		// Load the image to OpenGL.
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, this->texture_width, this->texture_height,
+		// Only store the channels the texture is used for. Colors are sRGB, so
+		// they are filtered and shaded in linear space, and normals drop their
+		// third component, which the shaders rebuild.
+		GLenum internal_format = GL_RGBA8;
+		int texel_size = 4;
+
+		if (usage == TEXTURE_USAGE_COLOR) {
+
+			internal_format = GL_SRGB8_ALPHA8;
+
+		} else if (usage == TEXTURE_USAGE_BUMP) {
+
+			internal_format = GL_R8;
+			texel_size = 1;
+
+		} else if (usage == TEXTURE_USAGE_NORMAL) {
+
+			internal_format = GL_RG8;
+			texel_size = 2;
+			this->texture_channels = 2;
+
+		}
+
+		// Load the image to OpenGL. Rows of one or three channels are not aligned to four bytes.
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, internal_format, this->texture_width, this->texture_height,
 				0, color_model, GL_UNSIGNED_BYTE, image_bytes);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 		glGenerateMipmap(GL_TEXTURE_2D);
 
+		// Add up every level of the mip chain OpenGL just generated.
+		for (int width = this->texture_width, height = this->texture_height; ; width = std::max(1, width / 2), height = std::max(1, height / 2)) {
+
+			this->memory += (size_t) width * height * texel_size;
+
+			if (width == 1 && height == 1)
+				break;
+
+		}
+
 		// Clean the memory.
 		stbi_image_free(image_bytes);
 
@@ -78,6 +130,47 @@ namespace bgq_opengl {
 
 	}
 
+	Texture::Texture(Texture &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->ID = other.ID;
+		this->slot = other.slot;
+		this->texture_width = other.texture_width;
+		this->texture_height = other.texture_height;
+		this->texture_channels = other.texture_channels;
+		this->memory = other.memory;
+		this->name = std::move(other.name);
+		other.ID = 0;
+
+	}
+
+	Texture& Texture::operator=(Texture &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->ID = other.ID;
+		this->slot = other.slot;
+		this->texture_width = other.texture_width;
+		this->texture_height = other.texture_height;
+		this->texture_channels = other.texture_channels;
+		this->memory = other.memory;
+		this->name = std::move(other.name);
+		other.ID = 0;
+
+		return *this;
+
+	}
+
+	Texture::~Texture() {
+
+		this->remove();
+
+	}
+
 	GLuint Texture::getID() {
 
 		return this->ID;
@@ -108,6 +201,12 @@ namespace bgq_opengl {
 
 	}
 
+	size_t Texture::getMemory() {
+
+		return this->memory;
+
+	}
+
 	std::string Texture::getName() {
 
 		return this->name;
@@ -124,7 +223,13 @@ namespace bgq_opengl {
 
 	void Texture::remove() {
 
-		glDeleteTextures(1, &this->ID);
+		// Nothing to delete if it was never created or was moved away.
+		if (this->ID == 0)
+			return;
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_TEXTURE, this->ID);
+		this->ID = 0;
 
 	}
 
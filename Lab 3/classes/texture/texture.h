@@ -16,10 +16,13 @@
 #ifndef BGQ_OPENGL_CLASS_TEXTURE_H_
 #define BGQ_OPENGL_CLASS_TEXTURE_H_
 
+#include <cstddef>
 #include <string>
 
 #include "GL/glew.h"
 
+#include "classes/block_compressor/block_compressor.h"
+
 namespace bgq_opengl {
 
 	/**
@@ -37,13 +40,47 @@ namespace bgq_opengl {
 			/**
 			 * @brief Creates a texture from an image.
 			 * 
-			 * Creates a textures and passes it to OpenGL.
+			 * Creates a textures and passes it to OpenGL, only keeping what its
+			 * usage needs: colors as sRGB, bumps as one channel and
+			 * normals as two channels.
 			 * 
 			 * @param image Image containing the texture.
 			 * @param type Texture type.
 			 * @param slot Texture slot.
+			 * @param usage What the image holds, one of the TEXTURE_USAGE_ values.
+			 */
+			Texture(const char* image, const char* type, GLuint slot, int usage = TEXTURE_USAGE_DATA);
+
+			/**
+			 * @brief Moves a texture.
+			 *
+			 * Takes over the OpenGL texture of another one, which is left empty.
+			 *
+			 * @param other The texture to move from.
+			 */
+			Texture(Texture &&other) noexcept;
+
+			/**
+			 * @brief Moves a texture.
+			 *
+			 * Releases the current OpenGL texture and takes over the one of another.
+			 *
+			 * @param other The texture to move from.
+			 *
+			 * @returns This texture.
+			 */
+			Texture& operator=(Texture &&other) noexcept;
+
+			/**
+			 * @brief Destroys the texture.
+			 *
+			 * Queues the OpenGL texture for deletion.
 			 */
-			Texture(const char* image, const char* type, GLuint slot);
+			~Texture();
+
+			// Only one object owns each OpenGL name, so there are no copies.
+			Texture(const Texture&) = delete;
+			Texture& operator=(const Texture&) = delete;
 
 			/**
 			 * @brief Get the ID of the texture.
@@ -90,6 +127,15 @@ namespace bgq_opengl {
 			 */
 			int getChannels();
 
+			/**
+			 * @brief Gets the memory of the texture.
+			 *
+			 * Gets the memory taken by every level of the texture on the GPU.
+			 *
+			 * @returns The memory in bytes.
+			 */
+			size_t getMemory();
+
 			/**
 			 * @brief Gets the texture name.
 			 * 
@@ -122,11 +168,12 @@ namespace bgq_opengl {
 
 		private:
 
-			GLuint ID;					/// Texture OpenGL ID.
-			GLuint slot;				/// Stores the texture slot number.
+			GLuint ID = 0;				/// Texture OpenGL ID.
+			GLuint slot = 0;			/// Stores the texture slot number.
 			int texture_width = 0;		/// Width of the texture in pixels.
 			int texture_height = 0;		/// Height of the texture in pixels.
 			int texture_channels = 0;	/// Number of channels of the texture.
+			size_t memory = 0;			/// Memory of every level on the GPU.
 			std::string name;			/// Texture name.
 
 	};
@@ -0,0 +1,285 @@
+/**
+ * @file texture_array.cpp
+ * @brief TextureArray class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "texture_array.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "stb/stb_image.h"
+
+#include "classes/block_compressor/block_compressor.h"
+#include "classes/deletion_queue/deletion_queue.h"
+
+namespace bgq_opengl {
+
+	TextureArray::TextureArray() {
+
+	}
+
+	TextureArray::TextureArray(const std::vector<std::string> &images, const char* name, GLuint slot) {
+
+		// The slot has to be a positive number because OpenGL does weird stuff on macOS else.
+		assert(slot >= 1);
+		assert(!images.empty());
+
+		this->name = std::string(name);
+		this->slot = slot;
+		this->layers = (int) images.size();
+
+		// Same as the textures, flip them so they are not upside down.
+		stbi_set_flip_vertically_on_load(true);
+
+		glGenTextures(1, &this->ID);
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+
+		for (int layer = 0; layer < this->layers; layer++) {
+
+			// Every layer must share the same format, so always load four channels.
+			int width, height, channels;
+			unsigned char* image_bytes = stbi_load(images[layer].c_str(), &width, &height, &channels, 4);
+
+			if (image_bytes == nullptr) {
+
+				std::cerr << "TextureArray error - Could not load " << images[layer] << ": " << stbi_failure_reason() << std::endl;
+				exit(1);
+
+			}
+
+			if (layer == 0) {
+
+				// The first image decides the size of the whole array.
+				this->texture_width = width;
+				this->texture_height = height;
+				glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, this->layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+			} else if (width != this->texture_width || height != this->texture_height) {
+
+				std::cerr << "TextureArray error - " << images[layer] << " is " << width << "x" << height << " but the array is " << this->texture_width << "x" << this->texture_height << "." << std::endl;
+				exit(1);
+
+			}
+
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, image_bytes);
+
+			stbi_image_free(image_bytes);
+
+		}
+
+		// Build the mip chains of every layer at once.
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	}
+
+	TextureArray::TextureArray(int width, int height, int layers, int format, int usage, const char* name, GLuint slot) {
+
+		// The slot has to be a positive number because OpenGL does weird stuff on macOS else.
+		assert(slot >= 1);
+
+		this->name = std::string(name);
+		this->slot = slot;
+		this->layers = layers;
+		this->texture_width = width;
+		this->texture_height = height;
+		this->format = format;
+		this->usage = usage;
+
+		glGenTextures(1, &this->ID);
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+
+		// The levels come later, so only the sampling is set up.
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	}
+
+	TextureArray::TextureArray(TextureArray &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->ID = other.ID;
+		this->slot = other.slot;
+		this->layers = other.layers;
+		this->texture_width = other.texture_width;
+		this->texture_height = other.texture_height;
+		this->format = other.format;
+		this->usage = other.usage;
+		this->name = std::move(other.name);
+		other.ID = 0;
+
+	}
+
+	TextureArray& TextureArray::operator=(TextureArray &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->ID = other.ID;
+		this->slot = other.slot;
+		this->layers = other.layers;
+		this->texture_width = other.texture_width;
+		this->texture_height = other.texture_height;
+		this->format = other.format;
+		this->usage = other.usage;
+		this->name = std::move(other.name);
+		other.ID = 0;
+
+		return *this;
+
+	}
+
+	TextureArray::~TextureArray() {
+
+		this->remove();
+
+	}
+
+	GLuint TextureArray::getID() const {
+
+		return this->ID;
+
+	}
+
+	GLuint TextureArray::getSlot() const {
+
+		return this->slot;
+
+	}
+
+	int TextureArray::getLayers() const {
+
+		return this->layers;
+
+	}
+
+	int TextureArray::getWidth() const {
+
+		return this->texture_width;
+
+	}
+
+	int TextureArray::getHeight() const {
+
+		return this->texture_height;
+
+	}
+
+	int TextureArray::getFormat() const {
+
+		return this->format;
+
+	}
+
+	int TextureArray::getUsage() const {
+
+		return this->usage;
+
+	}
+
+	std::string TextureArray::getName() const {
+
+		return this->name;
+
+	}
+
+	void TextureArray::bind() {
+
+		glActiveTexture(GL_TEXTURE0 + this->slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+
+	}
+
+	void TextureArray::setLevel(int level, const void* data) {
+
+		int width = std::max(1, this->texture_width >> level);
+		int height = std::max(1, this->texture_height >> level);
+
+		this->bind();
+
+		// Blocks go to the GPU as they are, it samples them without decompressing.
+		if (BlockCompressor::isCompressed(this->format)) {
+
+			GLsizei size = (GLsizei) (BlockCompressor::getSize(width, height, this->format) * this->layers);
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, BlockCompressor::getInternalFormat(this->format, this->usage), width, height, this->layers, 0, size, data);
+			return;
+
+		}
+
+		// Rows of one or two channels are not aligned to four bytes.
+		GLenum internal_format = BlockCompressor::getInternalFormat(this->format, this->usage);
+		GLenum pixel_format = BlockCompressor::getPixelFormat(this->format);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internal_format, width, height, this->layers, 0, pixel_format, GL_UNSIGNED_BYTE, data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	}
+
+	void TextureArray::clearLevel(int level) {
+
+		// Respecifying a level as empty is the only way to free it without recreating the texture.
+		this->bind();
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, 0, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+	}
+
+	void TextureArray::setLevelRange(int base, int max) {
+
+		// Levels outside the range may be missing without making the texture incomplete.
+		this->bind();
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, base);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, max);
+
+	}
+
+	void TextureArray::remove() {
+
+		// Nothing to delete if it was never created or was moved away.
+		if (this->ID == 0)
+			return;
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_TEXTURE, this->ID);
+		this->ID = 0;
+
+	}
+
+	void TextureArray::unbind() {
+
+		glActiveTexture(GL_TEXTURE0 + this->slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,244 @@
+/**
+ * @file texture_array.h
+ * @brief TextureArray class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TEXTURE_ARRAY_H_
+#define BGQ_OPENGL_CLASSES_TEXTURE_ARRAY_H_
+
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/block_compressor/block_compressor.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TextureArray class.
+	 *
+	 * Packs several images of the same size into the layers of a single
+	 * GL_TEXTURE_2D_ARRAY, each with its own mip chain. Shaders pick the layer
+	 * when sampling, so switching between the images needs no bind at all.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TextureArray {
+
+		public:
+
+			/**
+			 * @brief Construct the texture array.
+			 *
+			 * Construct an empty texture array.
+			 */
+			TextureArray();
+
+			/**
+			 * @brief Creates a texture array from images.
+			 *
+			 * Loads every image into a layer, in order, and passes them to OpenGL.
+			 * All the images must have the same size.
+			 *
+			 * @param images The images, one per layer.
+			 * @param name Name of the sampler in the shaders.
+			 * @param slot Texture slot.
+			 */
+			TextureArray(const std::vector<std::string> &images, const char* name, GLuint slot);
+
+			/**
+			 * @brief Creates an empty texture array.
+			 *
+			 * Creates a texture array with no levels, to be filled level by level
+			 * with setLevel().
+			 *
+			 * @param width The width of the finest level.
+			 * @param height The height of the finest level.
+			 * @param layers The number of layers.
+			 * @param format The format of the levels, one of the TEXTURE_FORMAT_ values.
+			 * @param usage What the layers hold, one of the TEXTURE_USAGE_ values.
+			 * @param name Name of the sampler in the shaders.
+			 * @param slot Texture slot.
+			 */
+			TextureArray(int width, int height, int layers, int format, int usage, const char* name, GLuint slot);
+
+			/**
+			 * @brief Moves a texture array.
+			 *
+			 * Takes over the OpenGL texture of another one, which is left empty.
+			 *
+			 * @param other The texture array to move from.
+			 */
+			TextureArray(TextureArray &&other) noexcept;
+
+			/**
+			 * @brief Moves a texture array.
+			 *
+			 * Releases the current OpenGL texture and takes over the one of another.
+			 *
+			 * @param other The texture array to move from.
+			 *
+			 * @returns This texture array.
+			 */
+			TextureArray& operator=(TextureArray &&other) noexcept;
+
+			/**
+			 * @brief Destroys the texture array.
+			 *
+			 * Queues the OpenGL texture for deletion.
+			 */
+			~TextureArray();
+
+			// Only one object owns each OpenGL name, so there are no copies.
+			TextureArray(const TextureArray&) = delete;
+			TextureArray& operator=(const TextureArray&) = delete;
+
+			/**
+			 * @brief Get the ID of the texture array.
+			 *
+			 * Get the ID of the texture array.
+			 *
+			 * @returns The ID of the texture array.
+			 */
+			GLuint getID() const;
+
+			/**
+			 * @brief Get the slot of the texture array.
+			 *
+			 * Get the slot of the texture array.
+			 *
+			 * @returns The slot of the texture array.
+			 */
+			GLuint getSlot() const;
+
+			/**
+			 * @brief Get the number of layers.
+			 *
+			 * Get the number of layers, which is the number of images.
+			 *
+			 * @returns The number of layers.
+			 */
+			int getLayers() const;
+
+			/**
+			 * @brief Gets the width of the layers.
+			 *
+			 * Gets the width of the layers in pixels.
+			 *
+			 * @returns The width of the layers in pixels.
+			 */
+			int getWidth() const;
+
+			/**
+			 * @brief Get the height of the layers.
+			 *
+			 * Gets the height of the layers in pixels.
+			 *
+			 * @returns The height of the layers in pixels.
+			 */
+			int getHeight() const;
+
+			/**
+			 * @brief Get the format.
+			 *
+			 * Gets the format the levels are uploaded in.
+			 *
+			 * @returns One of the TEXTURE_FORMAT_ values.
+			 */
+			int getFormat() const;
+
+			/**
+			 * @brief Get the usage.
+			 *
+			 * Gets what the layers hold, which decides whether they are sRGB.
+			 *
+			 * @returns One of the TEXTURE_USAGE_ values.
+			 */
+			int getUsage() const;
+
+			/**
+			 * @brief Gets the texture array name.
+			 *
+			 * Gets the name of the sampler in the shaders.
+			 *
+			 * @returns The name of the texture array.
+			 */
+			std::string getName() const;
+
+			/**
+			 * @brief Binds the texture array.
+			 *
+			 * Binds the texture array to its slot.
+			 */
+			void bind();
+
+			/**
+			 * @brief Uploads a level.
+			 *
+			 * Allocates a level and fills every layer of it.
+			 *
+			 * @param level The level.
+			 * @param data The pixels of every layer in the format of the array, layer after layer.
+			 */
+			void setLevel(int level, const void* data);
+
+			/**
+			 * @brief Frees a level.
+			 *
+			 * Gives the memory of a level back to the driver.
+			 *
+			 * @param level The level.
+			 */
+			void clearLevel(int level);
+
+			/**
+			 * @brief Limits the levels that are sampled.
+			 *
+			 * Limits sampling to the given levels, which must all be uploaded.
+			 *
+			 * @param base The finest level that is sampled.
+			 * @param max The coarsest level that is sampled.
+			 */
+			void setLevelRange(int base, int max);
+
+			/**
+			 * @brief Removes the texture array from OpenGL.
+			 *
+			 * Removes the texture array from OpenGL.
+			 */
+			void remove();
+
+			/**
+			 * @brief Unbinds the texture array.
+			 *
+			 * Unbinds the texture array.
+			 */
+			void unbind();
+
+		private:
+
+			GLuint ID = 0;				/// Texture OpenGL ID.
+			GLuint slot = 0;			/// Stores the texture slot number.
+			int layers = 0;				/// Number of layers.
+			int texture_width = 0;		/// Width of the layers in pixels.
+			int texture_height = 0;		/// Height of the layers in pixels.
+			int format = TEXTURE_FORMAT_RGBA8;	/// Format of the levels.
+			int usage = TEXTURE_USAGE_DATA;		/// What the layers hold.
+			std::string name;			/// Name of the sampler in the shaders.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_TEXTURE_ARRAY_H_
@@ -0,0 +1,393 @@
+/**
+ * @file texture_streamer.cpp
+ * @brief TextureStreamer class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "classes/block_compressor/block_compressor.h"
+#include "classes/mip_chain/mip_chain.h"
+#include "classes/texture_array/texture_array.h"
+#include "structs/level_read/level_read.h"
+
+namespace bgq_opengl {
+
+	TextureStreamer::TextureStreamer() {
+
+	}
+
+	TextureStreamer::~TextureStreamer() {
+
+		this->stop();
+
+	}
+
+	void TextureStreamer::start(const char* directory, size_t budget) {
+
+		this->stop();
+
+		this->directory = directory;
+		this->budget = budget;
+		this->running = true;
+		this->thread = std::thread(&TextureStreamer::run, this);
+
+	}
+
+	std::shared_ptr<TextureArray> TextureStreamer::add(const std::vector<std::string> &images, int usage, const char* name, GLuint slot, int kernel) {
+
+		int format = BlockCompressor::chooseFor(usage);
+		bool derivatives = usage == TEXTURE_USAGE_DERIVATIVE;
+
+		// Bake the levels once, and again whenever an image changes.
+		std::string filename = derivatives ? BumpBaker::makeFilename(images, kernel, BUMP_OUTPUT_DERIVATIVE, format) : MipChain::makeFilename(images, format);
+		std::string path = (std::filesystem::path(this->directory) / filename).string();
+
+		if (MipChain::isStale(images, format, path)) {
+
+			std::cerr << "TextureStreamer - Baking the mip chain of " << name << " into " << path << std::endl;
+
+			if (derivatives)
+				BumpBaker::bake(images, kernel, BUMP_OUTPUT_DERIVATIVE, format, path);
+			else
+				MipChain::bake(images, format, path);
+
+		}
+
+		MipChain chain(path);
+		int levels = chain.getLevels();
+
+		// The small levels are always there, so the array can be sampled right away.
+		int tail = 0;
+		while (tail < levels - 1 && std::max(chain.getWidth(tail), chain.getHeight(tail)) > TEXTURE_STREAMER_TAIL_SIZE)
+			tail++;
+
+		std::shared_ptr<TextureArray> texture_array = std::make_shared<TextureArray>(chain.getWidth(0), chain.getHeight(0), chain.getLayers(), chain.getFormat(), usage, name, slot);
+		std::vector<unsigned char> pixels;
+
+		for (int level = tail; level < levels; level++) {
+
+			if (!chain.readLevel(level, &pixels)) {
+
+				std::cerr << "TextureStreamer error - Could not read level " << level << " of " << path << "." << std::endl;
+				exit(1);
+
+			}
+
+			texture_array->setLevel(level, pixels.data());
+
+		}
+
+		texture_array->setLevelRange(tail, levels - 1);
+
+		// The thread reads the chains, so they only change under the lock.
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->arrays.push_back(texture_array);
+		this->chains.push_back(chain);
+		this->tails.push_back(tail);
+		this->resident.push_back(tail);
+		this->requested.push_back(tail);
+		this->loading.push_back(0);
+
+		return texture_array;
+
+	}
+
+	void TextureStreamer::request(const TextureArray &texture_array, int level) {
+
+		int index = this->find(texture_array);
+
+		if (index >= 0)
+			this->requested[index] = std::min(this->requested[index], std::max(level, 0));
+
+	}
+
+	void TextureStreamer::update() {
+
+		size_t num_arrays = this->arrays.size();
+
+		// Only ask for what fits. If the requests do not, make everything coarser by the same amount.
+		std::vector<int> wanted(num_arrays);
+		int bias = 0;
+
+		while (true) {
+
+			size_t total = 0;
+
+			for (size_t i = 0; i < num_arrays; i++) {
+
+				wanted[i] = std::min(this->requested[i] + bias, this->tails[i]);
+				total += this->getMemory(i, wanted[i]);
+
+			}
+
+			bool coarsest = true;
+			for (size_t i = 0; i < num_arrays; i++)
+				coarsest = coarsest && wanted[i] == this->tails[i];
+
+			if (total <= this->budget || coarsest)
+				break;
+
+			bias++;
+
+		}
+
+		// Free the levels that are not wanted anymore. Stop sampling them first.
+		for (size_t i = 0; i < num_arrays; i++) {
+
+			if (this->resident[i] >= wanted[i])
+				continue;
+
+			int levels = this->chains[i].getLevels();
+			this->arrays[i]->setLevelRange(wanted[i], levels - 1);
+
+			for (int level = this->resident[i]; level < wanted[i]; level++)
+				this->arrays[i]->clearLevel(level);
+
+			this->resident[i] = wanted[i];
+
+		}
+
+		// Upload the levels that were read, a few per frame so no frame takes the whole hit.
+		std::deque<LevelRead> finished;
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			while (!this->done.empty() && finished.size() < TEXTURE_STREAMER_UPLOADS) {
+
+				finished.push_back(std::move(this->done.front()));
+				this->done.pop_front();
+
+			}
+
+		}
+
+		for (size_t j = 0; j < finished.size(); j++) {
+
+			LevelRead &read = finished[j];
+			size_t i = read.array;
+			this->loading[i] = 0;
+
+			if (read.pixels.empty()) {
+
+				std::cerr << "TextureStreamer warning - Could not read level " << read.level << " of " << this->arrays[i]->getName() << "." << std::endl;
+				continue;
+
+			}
+
+			// It may not be wanted anymore, or not fit, by the time it arrives.
+			if (read.level != this->resident[i] - 1 || read.level < wanted[i])
+				continue;
+
+			this->arrays[i]->setLevel(read.level, read.pixels.data());
+			this->arrays[i]->setLevelRange(read.level, this->chains[i].getLevels() - 1);
+			this->resident[i] = read.level;
+
+		}
+
+		// Ask for the next finer level of every array that needs one, one at a time.
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			for (size_t i = 0; i < num_arrays; i++) {
+
+				if (this->loading[i] || this->resident[i] <= wanted[i])
+					continue;
+
+				LevelRead read;
+				read.array = i;
+				read.level = this->resident[i] - 1;
+
+				this->pending.push_back(std::move(read));
+				this->loading[i] = 1;
+
+			}
+
+		}
+
+		this->wake.notify_one();
+
+		// Every frame has to ask again.
+		for (size_t i = 0; i < num_arrays; i++)
+			this->requested[i] = this->tails[i];
+
+	}
+
+	size_t TextureStreamer::getMemory() const {
+
+		size_t total = 0;
+
+		for (size_t i = 0; i < this->arrays.size(); i++)
+			total += this->getMemory(i, this->resident[i]);
+
+		return total;
+
+	}
+
+	size_t TextureStreamer::getBudget() const {
+
+		return this->budget;
+
+	}
+
+	void TextureStreamer::setBudget(size_t budget) {
+
+		this->budget = budget;
+
+	}
+
+	int TextureStreamer::getResidentLevel(const TextureArray &texture_array) const {
+
+		int index = this->find(texture_array);
+
+		return index >= 0 ? this->resident[index] : -1;
+
+	}
+
+	void TextureStreamer::report(std::ostream &out) const {
+
+		out << "Streamed textures:" << std::endl;
+
+		size_t uncompressed = 0;
+
+		for (size_t i = 0; i < this->arrays.size(); i++) {
+
+			int level = this->resident[i];
+			uncompressed += this->getUncompressedMemory(i, level);
+
+			out << "  " << std::left << std::setw(16) << this->arrays[i]->getName() << std::right
+				<< " " << std::left << std::setw(5) << BlockCompressor::getName(this->chains[i].getFormat()) << std::right
+				<< " level " << level << " (" << this->chains[i].getWidth(level) << "x" << this->chains[i].getHeight(level) << ")  "
+				<< std::fixed << std::setprecision(2) << this->getMemory(i, level) / (1024.0 * 1024.0) << " MB, "
+				<< this->getUncompressedMemory(i, level) / (1024.0 * 1024.0) << " MB as RGBA8" << std::endl;
+
+		}
+
+		out << "  " << std::fixed << std::setprecision(2) << this->getMemory() / (1024.0 * 1024.0) << " of "
+			<< this->budget / (1024.0 * 1024.0) << " MB, " << uncompressed / (1024.0 * 1024.0) << " MB as RGBA8" << std::endl;
+
+	}
+
+	void TextureStreamer::stop() {
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->running = false;
+
+		}
+
+		this->wake.notify_all();
+
+		if (this->thread.joinable())
+			this->thread.join();
+
+		// Nothing is reading anymore, so the arrays can go.
+		this->arrays.clear();
+		this->chains.clear();
+		this->tails.clear();
+		this->resident.clear();
+		this->requested.clear();
+		this->loading.clear();
+		this->pending.clear();
+		this->done.clear();
+
+	}
+
+	int TextureStreamer::computeLevel(float texels_per_pixel) {
+
+		// One texel per pixel or less is the finest level, every halving after that one more level.
+		if (texels_per_pixel <= 1.0f)
+			return 0;
+
+		return (int) std::floor(std::log2(texels_per_pixel));
+
+	}
+
+	void TextureStreamer::run() {
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		while (true) {
+
+			this->wake.wait(lock, [this] { return !this->running || !this->pending.empty(); });
+
+			if (!this->running)
+				break;
+
+			LevelRead read = std::move(this->pending.front());
+			this->pending.pop_front();
+			MipChain chain = this->chains[read.array];
+
+			// Read without holding the lock, so the render loop never waits on the disk.
+			lock.unlock();
+
+			if (!chain.readLevel(read.level, &read.pixels))
+				read.pixels.clear();
+
+			lock.lock();
+			this->done.push_back(std::move(read));
+
+		}
+
+	}
+
+	size_t TextureStreamer::getMemory(size_t index, int level) const {
+
+		size_t total = 0;
+
+		for (int i = level; i < this->chains[index].getLevels(); i++)
+			total += this->chains[index].getLevelSize(i);
+
+		return total;
+
+	}
+
+	size_t TextureStreamer::getUncompressedMemory(size_t index, int level) const {
+
+		size_t total = 0;
+
+		for (int i = level; i < this->chains[index].getLevels(); i++)
+			total += BlockCompressor::getSize(this->chains[index].getWidth(i), this->chains[index].getHeight(i), TEXTURE_FORMAT_RGBA8) * this->chains[index].getLayers();
+
+		return total;
+
+	}
+
+	int TextureStreamer::find(const TextureArray &texture_array) const {
+
+		for (size_t i = 0; i < this->arrays.size(); i++)
+			if (this->arrays[i].get() == &texture_array)
+				return (int) i;
+
+		return -1;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,256 @@
+/**
+ * @file texture_streamer.h
+ * @brief TextureStreamer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TEXTURE_STREAMER_H_
+#define BGQ_OPENGL_CLASSES_TEXTURE_STREAMER_H_
+
+#define TEXTURE_STREAMER_TAIL_SIZE 64		/// Levels this size or smaller are always resident.
+#define TEXTURE_STREAMER_UPLOADS 1			/// Levels uploaded per frame at most.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "classes/bump_baker/bump_baker.h"
+#include "classes/mip_chain/mip_chain.h"
+#include "classes/texture_array/texture_array.h"
+#include "structs/level_read/level_read.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TextureStreamer class.
+	 *
+	 * Keeps texture arrays at the resolution they are actually seen at. Only
+	 * the small levels are uploaded when an array is added. Every frame, the
+	 * render loop tells the streamer which level each array needs, and the
+	 * streamer reads the finer levels from disk in the background, one at a
+	 * time, and frees the levels that are no longer needed.
+	 *
+	 * The resident levels never take more than the memory budget. When the
+	 * requests do not fit, every array is made coarser by the same number of
+	 * levels until they do.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TextureStreamer {
+
+		public:
+
+			/**
+			 * @brief Construct the streamer.
+			 *
+			 * Construct a streamer that does nothing until started.
+			 */
+			TextureStreamer();
+
+			/**
+			 * @brief Destroy the streamer.
+			 *
+			 * Stops the background thread.
+			 */
+			~TextureStreamer();
+
+			/**
+			 * @brief Start streaming.
+			 *
+			 * Starts the background thread that reads the levels.
+			 *
+			 * @param directory Directory where the mip chains are kept.
+			 * @param budget The most memory the resident levels can take, in bytes.
+			 */
+			void start(const char* directory, size_t budget);
+
+			/**
+			 * @brief Adds a texture array.
+			 *
+			 * Bakes the mip chain of the images if it is out of date, and creates
+			 * a texture array with only its small levels. The levels are kept in
+			 * the smallest format that suits what the images hold.
+			 *
+			 * @param images The images, one per layer.
+			 * Derivative maps are baked from the bump maps given as images.
+			 *
+			 * @param usage What the images hold, one of the TEXTURE_USAGE_ values.
+			 * @param name Name of the sampler in the shaders.
+			 * @param slot Texture slot.
+			 * @param kernel Kernel the derivatives are baked with, one of the BUMP_KERNEL_ values.
+			 *
+			 * @returns The texture array, which keeps changing resolution while streamed.
+			 */
+			std::shared_ptr<TextureArray> add(const std::vector<std::string> &images, int usage, const char* name, GLuint slot, int kernel = BUMP_KERNEL_SOBEL);
+
+			/**
+			 * @brief Asks for a level.
+			 *
+			 * Asks for a texture array to be resident down to a level during the
+			 * next update. The finest level asked for in a frame wins.
+			 *
+			 * @param texture_array The texture array.
+			 * @param level The finest level needed.
+			 */
+			void request(const TextureArray &texture_array, int level);
+
+			/**
+			 * @brief Updates the resident levels.
+			 *
+			 * Uploads the levels read since the last update, frees the levels that
+			 * are not needed or do not fit, and queues the reads of the next ones.
+			 * Call once per frame, after the requests.
+			 */
+			void update();
+
+			/**
+			 * @brief Get the resident memory.
+			 *
+			 * Get the memory taken by every resident level.
+			 *
+			 * @returns The memory in bytes.
+			 */
+			size_t getMemory() const;
+
+			/**
+			 * @brief Get the budget.
+			 *
+			 * Get the most memory the resident levels can take.
+			 *
+			 * @returns The budget in bytes.
+			 */
+			size_t getBudget() const;
+
+			/**
+			 * @brief Set the budget.
+			 *
+			 * Set the most memory the resident levels can take. Levels that do not
+			 * fit anymore are freed on the next update.
+			 *
+			 * @param budget The budget in bytes.
+			 */
+			void setBudget(size_t budget);
+
+			/**
+			 * @brief Get the resident level.
+			 *
+			 * Get the finest level of a texture array that is resident.
+			 *
+			 * @param texture_array The texture array.
+			 *
+			 * @returns The level, or -1 if the array is not streamed.
+			 */
+			int getResidentLevel(const TextureArray &texture_array) const;
+
+			/**
+			 * @brief Prints the streamed arrays.
+			 *
+			 * Prints the resident level and memory of every streamed array, next
+			 * to what the same levels would take as RGBA8.
+			 *
+			 * @param out The stream to print to.
+			 */
+			void report(std::ostream &out) const;
+
+			/**
+			 * @brief Stop streaming.
+			 *
+			 * Stops the background thread, waits for it and lets go of the arrays.
+			 */
+			void stop();
+
+			/**
+			 * @brief Get the level to sample.
+			 *
+			 * Get the level a texture should be sampled at, from the number of
+			 * texels that land on each pixel of the screen at its finest level.
+			 *
+			 * @param texels_per_pixel Texels of the finest level per pixel, along one axis.
+			 *
+			 * @returns The level.
+			 */
+			static int computeLevel(float texels_per_pixel);
+
+		private:
+
+			/**
+			 * @brief Body of the background thread.
+			 *
+			 * Reads the queued levels until stopped.
+			 */
+			void run();
+
+			/**
+			 * @brief Get the memory of some levels.
+			 *
+			 * Get the memory taken by the levels of an array from a level down.
+			 *
+			 * @param index The index of the array.
+			 * @param level The finest level.
+			 *
+			 * @returns The memory in bytes.
+			 */
+			size_t getMemory(size_t index, int level) const;
+
+			/**
+			 * @brief Get the uncompressed memory of some levels.
+			 *
+			 * Get the memory the levels of an array from a level down would take
+			 * as RGBA8, the format every texture used to be kept in.
+			 *
+			 * @param index The index of the array.
+			 * @param level The finest level.
+			 *
+			 * @returns The memory in bytes.
+			 */
+			size_t getUncompressedMemory(size_t index, int level) const;
+
+			/**
+			 * @brief Find an array.
+			 *
+			 * Find the index of a streamed array.
+			 *
+			 * @param texture_array The texture array.
+			 *
+			 * @returns The index, or -1 if the array is not streamed.
+			 */
+			int find(const TextureArray &texture_array) const;
+
+			std::string directory = "";							/// Directory of the mip chains.
+			size_t budget = 0;									/// Most memory the resident levels can take.
+
+			std::vector<std::shared_ptr<TextureArray>> arrays;	/// Every streamed array.
+			std::vector<MipChain> chains;						/// Chain of every array.
+			std::vector<int> tails;								/// First level that is always resident, per array.
+			std::vector<int> resident;							/// Finest resident level, per array.
+			std::vector<int> requested;							/// Finest level asked for this frame, per array.
+			std::vector<unsigned char> loading;					/// Whether a level is being read, per array.
+
+			std::deque<LevelRead> pending;						/// Levels to read.
+			std::deque<LevelRead> done;							/// Levels read and not uploaded yet.
+			std::mutex mutex;									/// Guards the chains and the reads.
+			std::condition_variable wake;						/// Wakes the thread up when there is a read.
+			std::thread thread;									/// Background thread.
+			std::atomic<bool> running{false};					/// Whether the thread should keep going.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_TEXTURE_STREAMER_H_
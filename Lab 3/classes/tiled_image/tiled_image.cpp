@@ -0,0 +1,360 @@
+/**
+ * @file tiled_image.cpp
+ * @brief TiledImage class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "tiled_image.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stb/stb_image.h"
+
+#include "classes/mip_chain/mip_chain.h"
+
+namespace bgq_opengl {
+
+	TiledImage::TiledImage() {
+
+	}
+
+	TiledImage::TiledImage(const std::string &path) {
+
+		this->path = path;
+
+		std::ifstream file(path, std::ios::binary);
+
+		uint32_t header[2] = { 0, 0 };
+		int32_t sizes[7] = { 0, 0, 0, 0, 0, 0, 0 };
+		file.read((char*) header, sizeof(header));
+		file.read((char*) sizes, sizeof(sizes));
+
+		if (!file || header[0] != TILED_IMAGE_MAGIC || header[1] != TILED_IMAGE_VERSION) {
+
+			std::cerr << "TiledImage error - " << path << " is not a tiled image." << std::endl;
+			exit(1);
+
+		}
+
+		this->size = sizes[0];
+		this->page_size = sizes[1];
+		this->border = sizes[2];
+		this->layers = sizes[3];
+		this->levels = sizes[4];
+		this->columns = sizes[5];
+		this->rows = sizes[6];
+
+	}
+
+	int TiledImage::getSize() const {
+
+		return this->size;
+
+	}
+
+	int TiledImage::getPageSize() const {
+
+		return this->page_size;
+
+	}
+
+	int TiledImage::getBorder() const {
+
+		return this->border;
+
+	}
+
+	int TiledImage::getLayers() const {
+
+		return this->layers;
+
+	}
+
+	int TiledImage::getLevels() const {
+
+		return this->levels;
+
+	}
+
+	int TiledImage::getColumns() const {
+
+		return this->columns;
+
+	}
+
+	int TiledImage::getRows() const {
+
+		return this->rows;
+
+	}
+
+	int TiledImage::getPages(int level) const {
+
+		return std::max(1, (this->size / this->page_size) >> level);
+
+	}
+
+	size_t TiledImage::getPageBytes() const {
+
+		size_t side = this->page_size + 2 * this->border;
+
+		return side * side * 4 * this->layers;
+
+	}
+
+	bool TiledImage::readPage(int level, int x, int y, std::vector<unsigned char>* data) const {
+
+		// Every read opens its own stream, same as the mip chains.
+		std::ifstream file(this->path, std::ios::binary);
+		file.seekg((std::streamoff) this->getOffset(level, x, y));
+
+		data->resize(this->getPageBytes());
+		file.read((char*) data->data(), data->size());
+
+		return (bool) file;
+
+	}
+
+	void TiledImage::bake(const std::vector<std::vector<std::string>> &layers, int columns, int page_size, int border, const std::string &path) {
+
+		int num_layers = (int) layers.size();
+		int num_images = (int) layers[0].size();
+		int rows = (num_images + columns - 1) / columns;
+		int image_width = 0, image_height = 0;
+
+		// Same as the textures, flip them so they are not upside down.
+		stbi_set_flip_vertically_on_load(true);
+
+		// Lay the images of every layer out in a grid.
+		std::vector<std::vector<unsigned char>> level(num_layers);
+		int size = 0;
+
+		for (int layer = 0; layer < num_layers; layer++) {
+
+			for (int i = 0; i < num_images; i++) {
+
+				int width, height, channels;
+				unsigned char* image_bytes = stbi_load(layers[layer][i].c_str(), &width, &height, &channels, 4);
+
+				if (image_bytes == nullptr) {
+
+					std::cerr << "TiledImage error - Could not load " << layers[layer][i] << ": " << stbi_failure_reason() << std::endl;
+					exit(1);
+
+				}
+
+				if (image_width == 0) {
+
+					image_width = width;
+					image_height = height;
+					size = columns * width;
+
+					if (rows * height != size || size % page_size != 0 || ((size / page_size) & (size / page_size - 1)) != 0) {
+
+						std::cerr << "TiledImage error - A " << columns << "x" << rows << " grid of " << width << "x" << height << " images is not square with a power of two pages of " << page_size << " per side." << std::endl;
+						exit(1);
+
+					}
+
+				} else if (width != image_width || height != image_height) {
+
+					std::cerr << "TiledImage error - " << layers[layer][i] << " is " << width << "x" << height << " but the others are " << image_width << "x" << image_height << "." << std::endl;
+					exit(1);
+
+				}
+
+				if (level[layer].empty())
+					level[layer].resize((size_t) size * size * 4);
+
+				// Copy it row by row into its cell.
+				int cell_x = (i % columns) * width;
+				int cell_y = (i / columns) * height;
+
+				for (int row = 0; row < height; row++)
+					memcpy(level[layer].data() + (((size_t) cell_y + row) * size + cell_x) * 4, image_bytes + (size_t) row * width * 4, (size_t) width * 4);
+
+				stbi_image_free(image_bytes);
+
+			}
+
+		}
+
+		int levels = 1;
+		while ((size / page_size) >> (levels - 1) > 1)
+			levels++;
+
+		// Write to a temporary file first, so a crash never leaves a half written image behind.
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+		std::string temporary = path + ".tmp";
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+		uint32_t header[2] = { TILED_IMAGE_MAGIC, TILED_IMAGE_VERSION };
+		int32_t sizes[7] = { size, page_size, border, num_layers, levels, columns, rows };
+		file.write((const char*) header, sizeof(header));
+		file.write((const char*) sizes, sizeof(sizes));
+
+		int side = page_size + 2 * border;
+		std::vector<unsigned char> page((size_t) side * side * 4 * num_layers);
+		std::vector<unsigned char> next;
+
+		for (int i = 0; i < levels; i++) {
+
+			int level_size = size >> i;
+			int pages = level_size / page_size;
+
+			// Size of the images of the grid in this level.
+			int cell_width = level_size / columns;
+			int cell_height = level_size / rows;
+
+			for (int y = 0; y < pages; y++) {
+
+				for (int x = 0; x < pages; x++) {
+
+					// Cut the page with its border. Every border pixel wraps around inside the image of the
+					// nearest pixel of the page, like the shader does, so the images never bleed into each other.
+					for (int layer = 0; layer < num_layers; layer++) {
+
+						unsigned char* out = page.data() + (size_t) side * side * 4 * layer;
+
+						for (int row = 0; row < side; row++) {
+
+							int pixel_y = y * page_size - border + row;
+							int cell_y = std::clamp(pixel_y, y * page_size, y * page_size + page_size - 1) / cell_height * cell_height;
+							int source_y = cell_y + ((pixel_y - cell_y) % cell_height + cell_height) % cell_height;
+
+							for (int column = 0; column < side; column++) {
+
+								int pixel_x = x * page_size - border + column;
+								int cell_x = std::clamp(pixel_x, x * page_size, x * page_size + page_size - 1) / cell_width * cell_width;
+								int source_x = cell_x + ((pixel_x - cell_x) % cell_width + cell_width) % cell_width;
+
+								memcpy(out + ((size_t) row * side + column) * 4, level[layer].data() + ((size_t) source_y * level_size + source_x) * 4, 4);
+
+							}
+
+						}
+
+					}
+
+					file.write((const char*) page.data(), page.size());
+
+				}
+
+			}
+
+			if (i == levels - 1)
+				break;
+
+			for (int layer = 0; layer < num_layers; layer++) {
+
+				next.resize((size_t) (level_size / 2) * (level_size / 2) * 4);
+				MipChain::downsample(level[layer].data(), level_size, level_size, next.data());
+				level[layer].swap(next);
+
+			}
+
+		}
+
+		file.close();
+
+		if (!file) {
+
+			std::cerr << "TiledImage error - Could not write " << temporary << "." << std::endl;
+			exit(1);
+
+		}
+
+		std::filesystem::rename(temporary, path, error);
+
+		if (error) {
+
+			std::cerr << "TiledImage error - Could not write " << path << ": " << error.message() << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	bool TiledImage::isStale(const std::vector<std::vector<std::string>> &layers, const std::string &path) {
+
+		std::error_code error;
+		auto baked = std::filesystem::last_write_time(path, error);
+
+		if (error)
+			return true;
+
+		for (size_t layer = 0; layer < layers.size(); layer++) {
+
+			for (size_t i = 0; i < layers[layer].size(); i++) {
+
+				auto modified = std::filesystem::last_write_time(layers[layer][i], error);
+				if (error || modified > baked)
+					return true;
+
+			}
+
+		}
+
+		// Images written by another version of the layout are baked again.
+		std::ifstream file(path, std::ios::binary);
+		uint32_t header[2] = { 0, 0 };
+		file.read((char*) header, sizeof(header));
+
+		return !file || header[0] != TILED_IMAGE_MAGIC || header[1] != TILED_IMAGE_VERSION;
+
+	}
+
+	std::string TiledImage::makeFilename(const std::vector<std::vector<std::string>> &layers) {
+
+		std::string filename;
+
+		for (size_t layer = 0; layer < layers.size(); layer++) {
+
+			for (size_t i = 0; i < layers[layer].size(); i++) {
+
+				if (!filename.empty())
+					filename += "+";
+
+				filename += std::filesystem::path(layers[layer][i]).stem().string();
+
+			}
+
+		}
+
+		return filename + ".tiles";
+
+	}
+
+	uint64_t TiledImage::getOffset(int level, int x, int y) const {
+
+		// The pages of the finer levels come first.
+		uint64_t page = 0;
+
+		for (int i = 0; i < level; i++)
+			page += (uint64_t) this->getPages(i) * this->getPages(i);
+
+		page += (uint64_t) y * this->getPages(level) + x;
+
+		return sizeof(uint32_t) * 2 + sizeof(int32_t) * 7 + page * this->getPageBytes();
+
+	}
+
+}  // namespace bgq_opengl
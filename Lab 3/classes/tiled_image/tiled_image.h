@@ -0,0 +1,231 @@
+/**
+ * @file tiled_image.h
+ * @brief TiledImage class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TILED_IMAGE_H_
+#define BGQ_OPENGL_CLASSES_TILED_IMAGE_H_
+
+#define TILED_IMAGE_MAGIC 0x54514742	/// "BGQT" read as a little endian integer.
+#define TILED_IMAGE_VERSION 2			/// Bumped whenever the layout changes.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TiledImage class.
+	 *
+	 * Reads the pages of a large square image from a file where every mip level
+	 * is cut into square pages of the same size, so any page of any level can
+	 * be read on its own. The image is a grid of smaller images, and every page
+	 * carries a border copied from its neighbours, wrapping around the edges of
+	 * the image of the grid it belongs to, so it can be filtered without
+	 * touching other pages or other images. A page holds all the layers, RGBA8.
+	 *
+	 * The file starts with the magic, the version, the size, the page size,
+	 * the border, the number of layers, of levels, of columns and of rows of
+	 * the grid. The pages follow, level after level, finest first, row after
+	 * row.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TiledImage {
+
+		public:
+
+			/**
+			 * @brief Construct the image.
+			 *
+			 * Construct an empty image.
+			 */
+			TiledImage();
+
+			/**
+			 * @brief Opens an image.
+			 *
+			 * Reads the header of a tiled image file.
+			 *
+			 * @param path The tiled image file.
+			 */
+			TiledImage(const std::string &path);
+
+			/**
+			 * @brief Get the size.
+			 *
+			 * Get the width and height of the finest level in pixels.
+			 *
+			 * @returns The size in pixels.
+			 */
+			int getSize() const;
+
+			/**
+			 * @brief Get the page size.
+			 *
+			 * Get the size of a page without its border, in pixels.
+			 *
+			 * @returns The page size in pixels.
+			 */
+			int getPageSize() const;
+
+			/**
+			 * @brief Get the border.
+			 *
+			 * Get the pixels added to every side of a page.
+			 *
+			 * @returns The border in pixels.
+			 */
+			int getBorder() const;
+
+			/**
+			 * @brief Get the number of layers.
+			 *
+			 * Get the number of layers in every page.
+			 *
+			 * @returns The number of layers.
+			 */
+			int getLayers() const;
+
+			/**
+			 * @brief Get the number of levels.
+			 *
+			 * Get the number of levels, down to the one that fits in one page.
+			 *
+			 * @returns The number of levels.
+			 */
+			int getLevels() const;
+
+			/**
+			 * @brief Get the number of columns.
+			 *
+			 * Get the number of images in every row of the grid.
+			 *
+			 * @returns The number of columns.
+			 */
+			int getColumns() const;
+
+			/**
+			 * @brief Get the number of rows.
+			 *
+			 * Get the number of images in every column of the grid.
+			 *
+			 * @returns The number of rows.
+			 */
+			int getRows() const;
+
+			/**
+			 * @brief Get the pages of a level.
+			 *
+			 * Get the number of pages along each side of a level.
+			 *
+			 * @param level The level.
+			 *
+			 * @returns The number of pages along each side.
+			 */
+			int getPages(int level) const;
+
+			/**
+			 * @brief Get the size of a page.
+			 *
+			 * Get the size of a page, border and all layers included.
+			 *
+			 * @returns The size in bytes.
+			 */
+			size_t getPageBytes() const;
+
+			/**
+			 * @brief Reads a page.
+			 *
+			 * Reads every layer of a page from the file.
+			 *
+			 * @param level The level.
+			 * @param x The column of the page.
+			 * @param y The row of the page.
+			 * @param data Output variable for the pixels, layer after layer.
+			 *
+			 * @returns True if the page could be read.
+			 */
+			bool readPage(int level, int x, int y, std::vector<unsigned char>* data) const;
+
+			/**
+			 * @brief Builds a tiled image file.
+			 *
+			 * Lays the images of every layer out in a grid, filters the result down
+			 * to a single page and writes every page. The grid must be square, and
+			 * its side a power of two times the page size. The borders of the pages
+			 * wrap around inside the image they belong to, same as the shader.
+			 *
+			 * @param layers The images of every layer, in the same order in all of them.
+			 * @param columns The number of images in every row of the grid.
+			 * @param page_size The size of a page without its border.
+			 * @param border The pixels added to every side of a page.
+			 * @param path The tiled image file to write.
+			 */
+			static void bake(const std::vector<std::vector<std::string>> &layers, int columns, int page_size, int border, const std::string &path);
+
+			/**
+			 * @brief Check whether a tiled image file is out of date.
+			 *
+			 * Check whether a tiled image file is missing, from an older version,
+			 * or older than any of its images.
+			 *
+			 * @param layers The images of every layer.
+			 * @param path The tiled image file.
+			 *
+			 * @returns True if the file has to be baked again.
+			 */
+			static bool isStale(const std::vector<std::vector<std::string>> &layers, const std::string &path);
+
+			/**
+			 * @brief Builds the filename of a tiled image.
+			 *
+			 * Builds the filename of the tiled image of some images from their names.
+			 *
+			 * @param layers The images of every layer.
+			 *
+			 * @returns The filename, without a directory.
+			 */
+			static std::string makeFilename(const std::vector<std::vector<std::string>> &layers);
+
+		private:
+
+			/**
+			 * @brief Get the offset of a page.
+			 *
+			 * Get where a page starts in the file.
+			 *
+			 * @param level The level.
+			 * @param x The column of the page.
+			 * @param y The row of the page.
+			 *
+			 * @returns The offset in bytes.
+			 */
+			uint64_t getOffset(int level, int x, int y) const;
+
+			std::string path = "";					/// The tiled image file.
+			int size = 0;							/// Width and height of the finest level.
+			int page_size = 0;						/// Size of a page without its border.
+			int border = 0;							/// Pixels added to every side of a page.
+			int layers = 0;							/// Number of layers.
+			int levels = 0;							/// Number of levels.
+			int columns = 0;						/// Images in every row of the grid.
+			int rows = 0;							/// Images in every column of the grid.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_TILED_IMAGE_H_
@@ -0,0 +1,323 @@
+/**
+ * @file transform_store.cpp
+ * @brief TransformStore class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "transform_store.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "structs/lanes/lanes.h"
+
+namespace bgq_opengl {
+
+	int TransformStore::create(int parent) {
+
+		// Parents must exist before their children so update() can run in a single pass.
+		assert(parent < (int) this->parents.size());
+
+		// The components are kept padded to a whole number of registers with identity transforms,
+		// so update() can read them straight when every node changed.
+		size_t padded = (this->parents.size() + LANES_WIDTH) / LANES_WIDTH * LANES_WIDTH;
+
+		if (this->pos_x.size() < padded) {
+
+			this->pos_x.resize(padded, 0.0f);
+			this->pos_y.resize(padded, 0.0f);
+			this->pos_z.resize(padded, 0.0f);
+			this->rot_x.resize(padded, 0.0f);
+			this->rot_y.resize(padded, 0.0f);
+			this->rot_z.resize(padded, 0.0f);
+			this->rot_w.resize(padded, 1.0f);
+			this->scale_x.resize(padded, 1.0f);
+			this->scale_y.resize(padded, 1.0f);
+			this->scale_z.resize(padded, 1.0f);
+
+		}
+
+		this->parents.push_back(parent);
+		this->dirty.push_back(1);
+		this->world_matrices.push_back(glm::mat4(1.0f));
+
+		return (int) this->parents.size() - 1;
+
+	}
+
+	void TransformStore::setPosition(int node, glm::vec3 position) {
+
+		// Only flag the node when something actually changed.
+		if (this->pos_x[node] == position.x && this->pos_y[node] == position.y && this->pos_z[node] == position.z)
+			return;
+
+		this->pos_x[node] = position.x;
+		this->pos_y[node] = position.y;
+		this->pos_z[node] = position.z;
+		this->dirty[node] = 1;
+
+	}
+
+	void TransformStore::setRotation(int node, glm::quat rotation) {
+
+		// Only flag the node when something actually changed.
+		if (this->rot_x[node] == rotation.x && this->rot_y[node] == rotation.y &&
+				this->rot_z[node] == rotation.z && this->rot_w[node] == rotation.w)
+			return;
+
+		this->rot_x[node] = rotation.x;
+		this->rot_y[node] = rotation.y;
+		this->rot_z[node] = rotation.z;
+		this->rot_w[node] = rotation.w;
+		this->dirty[node] = 1;
+
+	}
+
+	void TransformStore::setScale(int node, glm::vec3 scale) {
+
+		// Only flag the node when something actually changed.
+		if (this->scale_x[node] == scale.x && this->scale_y[node] == scale.y && this->scale_z[node] == scale.z)
+			return;
+
+		this->scale_x[node] = scale.x;
+		this->scale_y[node] = scale.y;
+		this->scale_z[node] = scale.z;
+		this->dirty[node] = 1;
+
+	}
+
+	const glm::mat4& TransformStore::getWorldMatrix(int node) const {
+
+		return this->world_matrices[node];
+
+	}
+
+	size_t TransformStore::size() const {
+
+		return this->parents.size();
+
+	}
+
+	size_t TransformStore::update() {
+
+		size_t num_nodes = this->parents.size();
+
+		// Collect the nodes that changed, or whose parent changed, in hierarchy order.
+		this->changed.clear();
+		this->changed_flags.assign(num_nodes, 0);
+
+		for (size_t i = 0; i < num_nodes; i++) {
+
+			int parent = this->parents[i];
+
+			if (this->dirty[i] || (parent >= 0 && this->changed_flags[parent])) {
+
+				this->changed_flags[i] = 1;
+				this->changed.push_back((int) i);
+
+			}
+
+			this->dirty[i] = 0;
+
+		}
+
+		size_t num_changed = this->changed.size();
+		const int* ids = this->changed.data();
+
+		const std::vector<float>* sources[10] = {
+			&this->rot_x, &this->rot_y, &this->rot_z, &this->rot_w,
+			&this->scale_x, &this->scale_y, &this->scale_z,
+			&this->pos_x, &this->pos_y, &this->pos_z
+		};
+
+		const float* planes[10];
+		size_t stride;
+
+		if (num_changed == num_nodes) {
+
+			// Every node changed, so the components already are the planes.
+			stride = this->pos_x.size();
+
+			for (int j = 0; j < 10; j++)
+				planes[j] = sources[j]->data();
+
+		} else {
+
+			// Gather the components of the changed nodes next to each other, one plane per scalar,
+			// so the batch below loads whole registers with no indirection. The planes are padded
+			// to a whole number of registers, with identity transforms in the padding.
+			stride = (num_changed + LANES_WIDTH - 1) / LANES_WIDTH * LANES_WIDTH;
+			this->gathered.resize(stride * 10);
+
+			for (int j = 0; j < 10; j++) {
+
+				const float* source = sources[j]->data();
+				float* plane = this->gathered.data() + j * stride;
+
+				for (size_t k = 0; k < num_changed; k++)
+					plane[k] = source[ids[k]];
+
+				std::fill(plane + num_changed, plane + stride, j == 3 || j == 4 || j == 5 || j == 6 ? 1.0f : 0.0f);
+				planes[j] = plane;
+
+			}
+
+		}
+
+		// Build the local matrices of every changed node in one batch, also one plane per element.
+		// Rotation columns multiplied by the scale, then the translation.
+		this->local.resize(stride * 12);
+		float* out = this->local.data();
+
+		Lanes one = Lanes::fill(1.0f), two = Lanes::fill(2.0f);
+
+		for (size_t k = 0; k < stride; k += LANES_WIDTH) {
+
+			Lanes x = Lanes::load(planes[0] + k), y = Lanes::load(planes[1] + k), z = Lanes::load(planes[2] + k), w = Lanes::load(planes[3] + k);
+			Lanes sx = Lanes::load(planes[4] + k), sy = Lanes::load(planes[5] + k), sz = Lanes::load(planes[6] + k);
+
+			Lanes xx = x * x, yy = y * y, zz = z * z;
+			Lanes xy = x * y, xz = x * z, yz = y * z;
+			Lanes wx = w * x, wy = w * y, wz = w * z;
+
+			((one - two * (yy + zz)) * sx).store(out + k);
+			((two * (xy + wz)) * sx).store(out + stride + k);
+			((two * (xz - wy)) * sx).store(out + stride * 2 + k);
+			((two * (xy - wz)) * sy).store(out + stride * 3 + k);
+			((one - two * (xx + zz)) * sy).store(out + stride * 4 + k);
+			((two * (yz + wx)) * sy).store(out + stride * 5 + k);
+			((two * (xz + wy)) * sz).store(out + stride * 6 + k);
+			((two * (yz - wx)) * sz).store(out + stride * 7 + k);
+			((one - two * (xx + yy)) * sz).store(out + stride * 8 + k);
+
+		}
+
+		for (int j = 0; j < 3; j++)
+			std::copy(planes[7 + j], planes[7 + j] + num_changed, out + stride * (9 + j));
+
+		// Compose with the parents. Parents come first, so their world matrix is already up to date.
+		// Every matrix is affine, so only the upper 3x4 part takes part in the product.
+		for (size_t k = 0; k < num_changed; k++) {
+
+			int i = ids[k];
+			float* w = &this->world_matrices[i][0][0];
+
+			float l[12];
+			for (int j = 0; j < 12; j++)
+				l[j] = out[stride * j + k];
+
+			int parent = this->parents[i];
+
+			if (parent >= 0) {
+
+				const float* p = &this->world_matrices[parent][0][0];
+
+				for (int c = 0; c < 4; c++) {
+
+					float x = l[c * 3], y = l[c * 3 + 1], z = l[c * 3 + 2];
+					w[c * 4] = p[0] * x + p[4] * y + p[8] * z;
+					w[c * 4 + 1] = p[1] * x + p[5] * y + p[9] * z;
+					w[c * 4 + 2] = p[2] * x + p[6] * y + p[10] * z;
+
+				}
+
+				w[12] += p[12];
+				w[13] += p[13];
+				w[14] += p[14];
+
+			} else {
+
+				for (int c = 0; c < 4; c++) {
+
+					w[c * 4] = l[c * 3];
+					w[c * 4 + 1] = l[c * 3 + 1];
+					w[c * 4 + 2] = l[c * 3 + 2];
+
+				}
+
+			}
+
+			w[3] = 0.0f;
+			w[7] = 0.0f;
+			w[11] = 0.0f;
+			w[15] = 1.0f;
+
+		}
+
+		return num_changed;
+
+	}
+
+	void TransformStore::benchmark(std::ostream &out) {
+
+		// A thousand roots with 99 nodes each, every one hanging from the one before.
+		TransformStore store;
+		std::vector<int> roots;
+
+		for (int root = 0; root < 1000; root++) {
+
+			int node = store.create();
+			roots.push_back(node);
+
+			for (int i = 1; i < 100; i++)
+				node = store.create(node);
+
+		}
+
+		store.update();
+
+		out << "TransformStore benchmark, " << store.size() << " nodes:" << std::endl;
+
+		const char* names[3] = { "all changed", "1% of the roots changed", "nothing changed" };
+		float angle = 0.0f;
+
+		for (int test = 0; test < 3; test++) {
+
+			double best = 0.0;
+			size_t updated = 0;
+
+			for (int run = 0; run < 10; run++) {
+
+				angle += 0.01f;
+				glm::quat rotation = glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f));
+
+				if (test == 0)
+					for (size_t i = 0; i < store.size(); i++)
+						store.setRotation((int) i, rotation);
+				else if (test == 1)
+					for (size_t i = 0; i < roots.size(); i += 100)
+						store.setRotation(roots[i], rotation);
+
+				auto start = std::chrono::steady_clock::now();
+				updated = store.update();
+				double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				if (run == 0 || ms < best)
+					best = ms;
+
+			}
+
+			out << "    " << names[test] << ": " << updated << " nodes in " << std::fixed << std::setprecision(3) << best << " ms" << std::endl;
+			out.unsetf(std::ios::floatfield);
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
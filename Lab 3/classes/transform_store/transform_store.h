@@ -0,0 +1,149 @@
+/**
+ * @file transform_store.h
+ * @brief TransformStore class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TRANSFORM_STORE_H_
+#define BGQ_OPENGL_CLASSES_TRANSFORM_STORE_H_
+
+#include <ostream>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TransformStore class.
+	 *
+	 * Stores the transforms of a scene graph in structure-of-arrays layout
+	 * (position, rotation, scale and parent of every node). Setting a component
+	 * flags the node as dirty, and update() only recomputes the world matrices of
+	 * the dirty nodes and their descendants. The normal matrices depend on the
+	 * view, so InstanceBatch computes them per draw from these.
+	 *
+	 * Parents always have a lower index than their children, so a single pass in
+	 * index order is enough to propagate the changes down the hierarchy. The
+	 * local matrices are built LANES_WIDTH at a time from contiguous component
+	 * planes, which are the component arrays themselves when every node changed
+	 * and a gathered copy otherwise.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TransformStore {
+
+		public:
+
+			/**
+			 * @brief Creates a new node.
+			 *
+			 * Creates a new node with an identity transform.
+			 *
+			 * @param parent The index of the parent node, or -1 for a root node.
+			 *
+			 * @returns The index of the new node.
+			 */
+			int create(int parent = -1);
+
+			/**
+			 * @brief Set the position of a node.
+			 *
+			 * Set the position of a node relative to its parent.
+			 *
+			 * @param node The node index.
+			 * @param position The new position.
+			 */
+			void setPosition(int node, glm::vec3 position);
+
+			/**
+			 * @brief Set the rotation of a node.
+			 *
+			 * Set the rotation of a node relative to its parent.
+			 *
+			 * @param node The node index.
+			 * @param rotation The new rotation.
+			 */
+			void setRotation(int node, glm::quat rotation);
+
+			/**
+			 * @brief Set the scale of a node.
+			 *
+			 * Set the scale of a node relative to its parent.
+			 *
+			 * @param node The node index.
+			 * @param scale The new scale.
+			 */
+			void setScale(int node, glm::vec3 scale);
+
+			/**
+			 * @brief Get the world matrix of a node.
+			 *
+			 * Get the world matrix of a node as of the last update.
+			 *
+			 * @param node The node index.
+			 *
+			 * @returns The world matrix.
+			 */
+			const glm::mat4& getWorldMatrix(int node) const;
+
+			/**
+			 * @brief Get the number of nodes.
+			 *
+			 * Get the number of nodes in the store.
+			 *
+			 * @returns The number of nodes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Recomputes the changed matrices.
+			 *
+			 * Recomputes the world matrices of the dirty nodes and their descendants,
+			 * and clears the dirty flags.
+			 *
+			 * @returns The number of nodes that were recomputed.
+			 */
+			size_t update();
+
+			/**
+			 * @brief Measures the store.
+			 *
+			 * Updates a hundred thousand nodes with all of them, a few of them and
+			 * none of them changed, and prints the best of several runs.
+			 *
+			 * @param out The stream to print to.
+			 */
+			static void benchmark(std::ostream &out);
+
+		private:
+
+			// Local transform components, one array per scalar.
+			std::vector<float> pos_x, pos_y, pos_z;
+			std::vector<float> rot_x, rot_y, rot_z, rot_w;
+			std::vector<float> scale_x, scale_y, scale_z;
+
+			std::vector<int> parents;					/// Parent of every node (-1 for roots).
+			std::vector<unsigned char> dirty;			/// Whether the local transform changed.
+			std::vector<glm::mat4> world_matrices;		/// Cached world matrices.
+
+			std::vector<int> changed;					/// Scratch list of nodes to recompute.
+			std::vector<unsigned char> changed_flags;	/// Scratch flags of nodes to recompute.
+			std::vector<float> gathered;				/// Scratch components of the changed nodes, one plane of each.
+			std::vector<float> local;					/// Scratch local matrices of the changed nodes, one plane per element.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_TRANSFORM_STORE_H_
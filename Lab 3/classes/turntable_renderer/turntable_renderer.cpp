@@ -0,0 +1,107 @@
+/**
+ * @file turntable_renderer.cpp
+ * @brief TurntableRenderer class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "turntable_renderer.h"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "GL/glew.h"
+
+#include "classes/render_target/render_target.h"
+
+#include "structs/captured_frame/captured_frame.h"
+#include "structs/image_job/image_job.h"
+
+namespace bgq_opengl {
+
+	TurntableRenderer::TurntableRenderer() {
+
+	}
+
+	TurntableRenderer::TurntableRenderer(int width, int height, int format, ImageWriter* writer) {
+
+		this->width = width;
+		this->height = height;
+		this->format = format;
+		this->writer = writer;
+
+		// Half floats keep what goes over 1 for EXR files.
+		bool half = format == IMAGE_FORMAT_EXR;
+
+		this->target = RenderTarget(width, height, half ? GL_RGBA16F : GL_RGBA8);
+
+		this->capture = FrameCapture(half);
+		this->capture.addConsumer([this](CapturedFrame frame) { this->save(std::move(frame)); });
+
+	}
+
+	void TurntableRenderer::render(const std::function<void()> &draw, const std::string &path) {
+
+		// Keep the state that will be changed.
+		GLint previous_framebuffer = 0;
+		GLint previous_viewport[4];
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+		glGetIntegerv(GL_VIEWPORT, previous_viewport);
+
+		this->target.bind();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		draw();
+
+		// The capture hands it to the writer some frames later.
+		this->paths.push_back(path);
+		this->capture.capture(this->target.getFramebuffer(), this->width, this->height);
+
+		// Restore everything.
+		glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+		glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]);
+
+	}
+
+	void TurntableRenderer::finish() {
+
+		this->capture.finish();
+
+	}
+
+	void TurntableRenderer::remove() {
+
+		this->capture.remove();
+		this->paths.clear();
+		this->target.remove();
+
+	}
+
+	void TurntableRenderer::save(CapturedFrame frame) {
+
+		ImageJob job;
+		job.path = this->paths.front();
+		job.format = this->format;
+		job.width = frame.width;
+		job.height = frame.height;
+		job.pixels = std::move(frame.pixels);
+
+		this->paths.pop_front();
+
+		// Blocks while the writer is too far behind.
+		this->writer->write(std::move(job));
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,119 @@
+/**
+ * @file turntable_renderer.h
+ * @brief TurntableRenderer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TURNTABLE_RENDERER_H_
+#define BGQ_OPENGL_CLASSES_TURNTABLE_RENDERER_H_
+
+#include <deque>
+#include <functional>
+#include <string>
+
+#include "GL/glew.h"
+
+#include "classes/frame_capture/frame_capture.h"
+#include "classes/image_writer/image_writer.h"
+#include "classes/render_target/render_target.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a TurntableRenderer class.
+	 *
+	 * Draws frames offscreen and saves them to files without stalling on any of
+	 * them. The frames are read back through a frame capture, so the GPU keeps
+	 * drawing the next frames while the older ones are copied, and an image
+	 * writer encodes them on its own threads.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TurntableRenderer {
+
+		public:
+
+			/**
+			 * @brief Construct the renderer.
+			 *
+			 * Construct an empty renderer.
+			 */
+			TurntableRenderer();
+
+			/**
+			 * @brief Construct the renderer.
+			 *
+			 * Construct the renderer with an offscreen target of the given size,
+			 * 8 bits per channel for PNG files or half floats for EXR ones.
+			 *
+			 * @param width Width of the frames in pixels.
+			 * @param height Height of the frames in pixels.
+			 * @param format IMAGE_FORMAT_PNG or IMAGE_FORMAT_EXR.
+			 * @param writer The writer the frames are handed to.
+			 */
+			TurntableRenderer(int width, int height, int format, ImageWriter* writer);
+
+			// The capture hands the frames back to this object, so it stays put.
+			TurntableRenderer(const TurntableRenderer&) = delete;
+			TurntableRenderer& operator=(const TurntableRenderer&) = delete;
+
+			/**
+			 * @brief Renders a frame.
+			 *
+			 * Clears the target, draws the frame and starts reading it back. Hands
+			 * the oldest frame to the writer if enough are in flight. Restores the
+			 * framebuffer and viewport afterwards.
+			 *
+			 * @param draw Draws the frame.
+			 * @param path The file the frame is saved to.
+			 */
+			void render(const std::function<void()> &draw, const std::string &path);
+
+			/**
+			 * @brief Finishes the frames in flight.
+			 *
+			 * Hands every frame still being read back to the writer.
+			 */
+			void finish();
+
+			/**
+			 * @brief Removes the renderer from OpenGL.
+			 *
+			 * Removes the target and the capture from OpenGL.
+			 */
+			void remove();
+
+		private:
+
+			/**
+			 * @brief Hands a frame to the writer.
+			 *
+			 * Queues a frame that was read back on the writer, with the oldest
+			 * path that is waiting. The pixels are moved, not copied.
+			 *
+			 * @param frame The frame.
+			 */
+			void save(CapturedFrame frame);
+
+			RenderTarget target;									/// Offscreen target the frames are drawn into.
+			FrameCapture capture;									/// Reads the frames back.
+			std::deque<std::string> paths;							/// File of every frame in flight, oldest first.
+			int width = 0;											/// Width of the frames in pixels.
+			int height = 0;											/// Height of the frames in pixels.
+			int format = IMAGE_FORMAT_PNG;							/// Format of the files.
+			ImageWriter* writer = nullptr;							/// Writer the frames are handed to.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_TURNTABLE_RENDERER_H_
@@ -15,8 +15,11 @@
 
 #include "vao.h"
 
+#include <utility>
+
 #include "GL/glew.h"
 
+#include "classes/deletion_queue/deletion_queue.h"
 #include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
@@ -29,6 +32,35 @@ namespace bgq_opengl {
 
 	}
 
+	VAO::VAO(VAO &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->ID = other.ID;
+		other.ID = 0;
+
+	}
+
+	VAO& VAO::operator=(VAO &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->ID = other.ID;
+		other.ID = 0;
+
+		return *this;
+
+	}
+
+	VAO::~VAO() {
+
+		this->remove();
+
+	}
+
 	void VAO::bind() {
 
 		// Bind the VAO.
@@ -53,8 +85,13 @@ namespace bgq_opengl {
 
 	void VAO::remove() {
 
-		// Deletes the VAO from the GL pipe.
-		glDeleteVertexArrays(1, &this->ID);
+		// Nothing to delete if it was never created or was moved away.
+		if (this->ID == 0)
+			return;
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_VERTEX_ARRAY, this->ID);
+		this->ID = 0;
 
 	}
 
@@ -41,6 +41,37 @@ namespace bgq_opengl {
 		 */
 		VAO();
 
+		/**
+		 * @brief Moves a VAO.
+		 *
+		 * Takes over the OpenGL vertex array of another one, which is left empty.
+		 *
+		 * @param other The VAO to move from.
+		 */
+		VAO(VAO &&other) noexcept;
+
+		/**
+		 * @brief Moves a VAO.
+		 *
+		 * Releases the current OpenGL vertex array and takes over the one of another.
+		 *
+		 * @param other The VAO to move from.
+		 *
+		 * @returns This VAO.
+		 */
+		VAO& operator=(VAO &&other) noexcept;
+
+		/**
+		 * @brief Destroys the VAO.
+		 *
+		 * Queues the OpenGL vertex array for deletion.
+		 */
+		~VAO();
+
+		// Only one object owns each OpenGL name, so there are no copies.
+		VAO(const VAO&) = delete;
+		VAO& operator=(const VAO&) = delete;
+
 		/**
 		 * @brief Binds the VBO.
 		 *
@@ -79,7 +110,7 @@ namespace bgq_opengl {
 
 	private:
 
-		GLuint ID; /// OpenGL VAO ID.
+		GLuint ID = 0; /// OpenGL VAO ID.
 	};
 
 }  // namespace bgq_opengl
@@ -15,14 +15,21 @@
 
 #include "vbo.h"
 
+#include <utility>
 #include <vector>
 
 #include "GL/glew.h"
 
+#include "classes/deletion_queue/deletion_queue.h"
+
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
 
+	VBO::VBO() {
+
+	}
+
 	VBO::VBO(const std::vector<Vertex> &vertices) {
 
 		// Generate the buffer.
@@ -34,6 +41,46 @@ namespace bgq_opengl {
 
 	}
 
+	VBO::VBO(const void* data, GLsizeiptr size) {
+
+		// Generate the buffer.
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+
+		// Link the data.
+		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+
+	}
+
+	VBO::VBO(VBO &&other) noexcept {
+
+		// Take over the other one, then leave it empty.
+		this->ID = other.ID;
+		other.ID = 0;
+
+	}
+
+	VBO& VBO::operator=(VBO &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		// Let go of the current one, then leave the other empty.
+		this->remove();
+
+		this->ID = other.ID;
+		other.ID = 0;
+
+		return *this;
+
+	}
+
+	VBO::~VBO() {
+
+		this->remove();
+
+	}
+
 	void VBO::bind() {
 
 		// Bind the VBO.
@@ -43,8 +90,13 @@ namespace bgq_opengl {
 
 	void VBO::remove() {
 
-		// Delete the buffer in OpenGL.
-		glDeleteBuffers(1, &this->ID);
+		// Nothing to delete if it was never created or was moved away.
+		if (this->ID == 0)
+			return;
+
+		// Deleted once the GPU is done with the frames that may still use it.
+		DeletionQueue::push(DELETE_BUFFER, this->ID);
+		this->ID = 0;
 
 	}
 
@@ -36,6 +36,13 @@ namespace bgq_opengl {
 
 	public:
 
+		/**
+		 * @brief Constructs an empty Vertex Buffer Object.
+		 *
+		 * Constructs a Vertex Buffer Object with no buffer behind it.
+		 */
+		VBO();
+
 		/**
 		 * @brief Constructs a Vertex Buffer Object.
 		 *
@@ -45,6 +52,47 @@ namespace bgq_opengl {
 		 */
 		VBO(const std::vector<Vertex> &vertices);
 
+		/**
+		 * @brief Constructs a Vertex Buffer Object.
+		 *
+		 * Constructs a Vertex Buffer Object from raw data.
+		 *
+		 * @param data The data to upload.
+		 * @param size The size of the data in bytes.
+		 */
+		VBO(const void* data, GLsizeiptr size);
+
+		/**
+		 * @brief Moves a VBO.
+		 *
+		 * Takes over the OpenGL buffer of another one, which is left empty.
+		 *
+		 * @param other The VBO to move from.
+		 */
+		VBO(VBO &&other) noexcept;
+
+		/**
+		 * @brief Moves a VBO.
+		 *
+		 * Releases the current OpenGL buffer and takes over the one of another.
+		 *
+		 * @param other The VBO to move from.
+		 *
+		 * @returns This VBO.
+		 */
+		VBO& operator=(VBO &&other) noexcept;
+
+		/**
+		 * @brief Destroys the VBO.
+		 *
+		 * Queues the OpenGL buffer for deletion.
+		 */
+		~VBO();
+
+		// Only one object owns each OpenGL name, so there are no copies.
+		VBO(const VBO&) = delete;
+		VBO& operator=(const VBO&) = delete;
+
 		/**
 		 * @brief Binds the VBO.
 		 *
@@ -68,7 +116,7 @@ namespace bgq_opengl {
 
 	private:
 
-		GLuint ID; // GL ID of the VBO.
+		GLuint ID = 0; // GL ID of the VBO.
 
 	};
 
@@ -0,0 +1,632 @@
+/**
+ * @file virtual_texture.cpp
+ * @brief VirtualTexture class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "virtual_texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/deletion_queue/deletion_queue.h"
+#include "classes/tiled_image/tiled_image.h"
+#include "structs/page_read/page_read.h"
+
+namespace bgq_opengl {
+
+	VirtualTexture::VirtualTexture() {
+
+	}
+
+	VirtualTexture::~VirtualTexture() {
+
+		this->stop();
+
+	}
+
+	void VirtualTexture::start(const std::vector<std::vector<std::string>> &layers, int columns, const char* directory, GLuint slot) {
+
+		this->stop();
+
+		// Bake the pages once, and again whenever an image changes.
+		std::string path = (std::filesystem::path(directory) / TiledImage::makeFilename(layers)).string();
+
+		if (TiledImage::isStale(layers, path)) {
+
+			std::cerr << "VirtualTexture - Baking the pages into " << path << std::endl;
+			TiledImage::bake(layers, columns, VIRTUAL_TEXTURE_PAGE_SIZE, VIRTUAL_TEXTURE_BORDER, path);
+
+		}
+
+		this->image = TiledImage(path);
+		this->slot = slot;
+
+		if (this->image.getPages(0) > 256) {
+
+			std::cerr << "VirtualTexture error - " << path << " has more pages per side than the feedback can tell apart." << std::endl;
+			exit(1);
+
+		}
+
+		// The atlas has no levels, the page table picks them.
+		int atlas_size = this->getAtlasSize();
+
+		glGenTextures(1, &this->atlas);
+		glActiveTexture(GL_TEXTURE0 + this->slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, this->atlas);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, atlas_size, atlas_size, this->image.getLayers(), 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+
+		// Every entry of the page table is the slot and level of the page to sample, as integers.
+		glGenTextures(1, &this->table);
+		glActiveTexture(GL_TEXTURE0 + this->slot + 1);
+		glBindTexture(GL_TEXTURE_2D, this->table);
+
+		for (int level = 0; level < this->image.getLevels(); level++) {
+
+			int pages = this->image.getPages(level);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8UI, pages, pages, 0, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, NULL);
+			this->entries.push_back(std::vector<unsigned char>((size_t) pages * pages * 4, 0));
+
+		}
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, this->image.getLevels() - 1);
+
+		int capacity = this->getCapacity();
+		this->slot_keys.assign(capacity, 0);
+		this->slot_used.assign(capacity, 0);
+		this->slot_full.assign(capacity, 0);
+
+		// The coarsest page is always there, so every entry has something to fall back on.
+		PageRead coarsest;
+		coarsest.level = this->image.getLevels() - 1;
+		coarsest.key = VirtualTexture::makeKey(coarsest.level, 0, 0);
+
+		if (!this->image.readPage(coarsest.level, 0, 0, &coarsest.pixels)) {
+
+			std::cerr << "VirtualTexture error - Could not read the coarsest page of " << path << "." << std::endl;
+			exit(1);
+
+		}
+
+		this->upload(coarsest);
+		this->slot_used[this->resident[coarsest.key]] = UINT64_MAX;
+		this->updateTable();
+
+		this->running = true;
+		this->thread = std::thread(&VirtualTexture::run, this);
+
+	}
+
+	void VirtualTexture::beginFeedback(int width, int height) {
+
+		// Keep the state that will be changed.
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &this->previous_framebuffer);
+		glGetIntegerv(GL_VIEWPORT, this->previous_viewport);
+
+		int target_width = std::max(1, width / VIRTUAL_TEXTURE_FEEDBACK_SCALE);
+		int target_height = std::max(1, height / VIRTUAL_TEXTURE_FEEDBACK_SCALE);
+
+		// Create the target the first time, and again when the window changes size.
+		if (target_width != this->feedback_width || target_height != this->feedback_height) {
+
+			this->removeFeedback();
+			this->feedback_width = target_width;
+			this->feedback_height = target_height;
+
+			// Use the unit of the page table, and bind it back afterwards.
+			glActiveTexture(GL_TEXTURE0 + this->slot + 1);
+
+			this->feedback = RenderTarget(target_width, target_height, GL_RGBA8UI);
+			glBindTexture(GL_TEXTURE_2D, this->table);
+
+			glGenBuffers(2, this->readback);
+
+			for (int i = 0; i < 2; i++) {
+
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readback[i]);
+				glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) target_width * target_height * 4, NULL, GL_STREAM_READ);
+
+			}
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		}
+
+		this->feedback.bind();
+
+		// Pixels left at zero ask for nothing.
+		GLuint nothing[4] = { 0, 0, 0, 0 };
+		glClearBufferuiv(GL_COLOR, 0, nothing);
+		glClear(GL_DEPTH_BUFFER_BIT);
+
+	}
+
+	void VirtualTexture::endFeedback() {
+
+		int index = this->readback_index;
+
+		// A feedback that was never read is replaced by this one.
+		if (this->readback_fences[index] != nullptr) {
+
+			glDeleteSync(this->readback_fences[index]);
+			this->readback_fences[index] = nullptr;
+
+		}
+
+		// Copy into the buffer without waiting, it is mapped a frame later.
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readback[index]);
+		glReadPixels(0, 0, this->feedback_width, this->feedback_height, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		this->readback_fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->readback_index = 1 - index;
+
+		// Restore everything.
+		glBindFramebuffer(GL_FRAMEBUFFER, this->previous_framebuffer);
+		glViewport(this->previous_viewport[0], this->previous_viewport[1], this->previous_viewport[2], this->previous_viewport[3]);
+
+	}
+
+	void VirtualTexture::update() {
+
+		std::vector<uint32_t> keys;
+
+		if (this->readFeedback(&keys))
+			this->request(keys);
+
+		// Upload the pages that were read, a few per frame so no frame takes the whole hit.
+		std::deque<PageRead> finished;
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			while (!this->done.empty() && finished.size() < VIRTUAL_TEXTURE_UPLOADS) {
+
+				finished.push_back(std::move(this->done.front()));
+				this->done.pop_front();
+
+			}
+
+		}
+
+		for (size_t i = 0; i < finished.size(); i++) {
+
+			this->loading.erase(finished[i].key);
+
+			if (finished[i].pixels.empty()) {
+
+				std::cerr << "VirtualTexture warning - Could not read page " << finished[i].x << "," << finished[i].y << " of level " << finished[i].level << "." << std::endl;
+				continue;
+
+			}
+
+			this->upload(finished[i]);
+
+		}
+
+		if (this->table_dirty)
+			this->updateTable();
+
+	}
+
+	void VirtualTexture::bind() {
+
+		glActiveTexture(GL_TEXTURE0 + this->slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, this->atlas);
+		glActiveTexture(GL_TEXTURE0 + this->slot + 1);
+		glBindTexture(GL_TEXTURE_2D, this->table);
+
+	}
+
+	GLuint VirtualTexture::getSlot() const {
+
+		return this->slot;
+
+	}
+
+	int VirtualTexture::getSize() const {
+
+		return this->image.getSize();
+
+	}
+
+	int VirtualTexture::getPageSize() const {
+
+		return this->image.getPageSize();
+
+	}
+
+	int VirtualTexture::getBorder() const {
+
+		return this->image.getBorder();
+
+	}
+
+	int VirtualTexture::getLevels() const {
+
+		return this->image.getLevels();
+
+	}
+
+	int VirtualTexture::getColumns() const {
+
+		return this->image.getColumns();
+
+	}
+
+	int VirtualTexture::getRows() const {
+
+		return this->image.getRows();
+
+	}
+
+	int VirtualTexture::getAtlasSize() const {
+
+		return VIRTUAL_TEXTURE_ATLAS_PAGES * (this->image.getPageSize() + 2 * this->image.getBorder());
+
+	}
+
+	float VirtualTexture::getFeedbackBias() const {
+
+		// The feedback is smaller, so its derivatives are larger by the same factor.
+		return -std::log2((float) VIRTUAL_TEXTURE_FEEDBACK_SCALE);
+
+	}
+
+	int VirtualTexture::getResidentPages() const {
+
+		return (int) this->resident.size();
+
+	}
+
+	int VirtualTexture::getCapacity() const {
+
+		return VIRTUAL_TEXTURE_ATLAS_PAGES * VIRTUAL_TEXTURE_ATLAS_PAGES;
+
+	}
+
+	void VirtualTexture::report(std::ostream &out) const {
+
+		size_t atlas_size = this->getAtlasSize();
+		size_t memory = atlas_size * atlas_size * 4 * this->image.getLayers();
+
+		out << "Virtual texture:" << std::endl;
+		out << "  " << this->getSize() << "x" << this->getSize() << ", " << this->getLevels() << " levels of "
+			<< this->getPageSize() << "px pages, " << this->image.getLayers() << " layers" << std::endl;
+		out << "  " << this->getResidentPages() << " of " << this->getCapacity() << " pages resident, "
+			<< std::fixed << std::setprecision(2) << memory / (1024.0 * 1024.0) << " MB" << std::endl;
+
+	}
+
+	void VirtualTexture::stop() {
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->running = false;
+
+		}
+
+		this->wake.notify_all();
+
+		if (this->thread.joinable())
+			this->thread.join();
+
+		this->pending.clear();
+		this->done.clear();
+
+		// Deleted once the GPU is done with the frames that may still use them.
+		this->removeFeedback();
+		DeletionQueue::push(DELETE_TEXTURE, this->atlas);
+		DeletionQueue::push(DELETE_TEXTURE, this->table);
+		this->atlas = 0;
+		this->table = 0;
+
+		this->resident.clear();
+		this->slot_keys.clear();
+		this->slot_used.clear();
+		this->slot_full.clear();
+		this->loading.clear();
+		this->entries.clear();
+		this->feedback_count = 0;
+		this->table_dirty = false;
+
+	}
+
+	void VirtualTexture::run() {
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		while (true) {
+
+			this->wake.wait(lock, [this] { return !this->running || !this->pending.empty(); });
+
+			if (!this->running)
+				break;
+
+			PageRead read = std::move(this->pending.front());
+			this->pending.pop_front();
+
+			// Read without holding the lock, so the render loop never waits on the disk.
+			lock.unlock();
+
+			if (!this->image.readPage(read.level, read.x, read.y, &read.pixels))
+				read.pixels.clear();
+
+			lock.lock();
+			this->done.push_back(std::move(read));
+
+		}
+
+	}
+
+	bool VirtualTexture::readFeedback(std::vector<uint32_t>* keys) {
+
+		// The oldest feedback is the one in the buffer that goes next.
+		int index = this->readback_index;
+		GLsync fence = this->readback_fences[index];
+
+		if (fence == nullptr)
+			return false;
+
+		GLenum result = glClientWaitSync(fence, 0, 0);
+
+		if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+			return false;
+
+		glDeleteSync(fence);
+		this->readback_fences[index] = nullptr;
+
+		size_t size = (size_t) this->feedback_width * this->feedback_height * 4;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, this->readback[index]);
+		const unsigned char* pixels = (const unsigned char*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+
+		if (pixels != nullptr) {
+
+			// Neighbouring pixels mostly ask for the same page, so skip the repeats right away.
+			uint32_t last = UINT32_MAX;
+
+			for (size_t i = 0; i < size; i += 4) {
+
+				if (pixels[i + 3] == 0)
+					continue;
+
+				uint32_t key = VirtualTexture::makeKey(pixels[i + 2], pixels[i], pixels[i + 1]);
+
+				if (key != last)
+					keys->push_back(key);
+
+				last = key;
+
+			}
+
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		this->feedback_count++;
+
+		return true;
+
+	}
+
+	void VirtualTexture::request(std::vector<uint32_t> &keys) {
+
+		int levels = this->image.getLevels();
+		size_t count = keys.size();
+
+		// Every page needs the coarser ones over it too, to fall back on while it loads.
+		for (size_t i = 0; i < count; i++) {
+
+			int level = keys[i] >> 24;
+			int y = (keys[i] >> 12) & 0xFFF;
+			int x = keys[i] & 0xFFF;
+
+			for (level++; level < levels; level++) {
+
+				x >>= 1;
+				y >>= 1;
+				keys.push_back(VirtualTexture::makeKey(level, x, y));
+
+			}
+
+		}
+
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+		std::vector<PageRead> missing;
+
+		for (size_t i = 0; i < keys.size(); i++) {
+
+			PageRead read;
+			read.key = keys[i];
+			read.level = keys[i] >> 24;
+			read.y = (keys[i] >> 12) & 0xFFF;
+			read.x = keys[i] & 0xFFF;
+
+			// Anything out of range did not come from the feedback shader.
+			if (read.level >= levels || read.x >= this->image.getPages(read.level) || read.y >= this->image.getPages(read.level))
+				continue;
+
+			auto found = this->resident.find(read.key);
+
+			if (found != this->resident.end())
+				this->slot_used[found->second] = std::max(this->slot_used[found->second], this->feedback_count);
+			else if (this->loading.count(read.key) == 0)
+				missing.push_back(std::move(read));
+
+		}
+
+		// Coarse pages first, so something close shows up as soon as possible.
+		std::stable_sort(missing.begin(), missing.end(), [](const PageRead &a, const PageRead &b) { return a.level > b.level; });
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			for (size_t i = 0; i < missing.size() && this->loading.size() < VIRTUAL_TEXTURE_QUEUE; i++) {
+
+				this->loading.insert(missing[i].key);
+				this->pending.push_back(std::move(missing[i]));
+
+			}
+
+		}
+
+		this->wake.notify_one();
+
+	}
+
+	void VirtualTexture::upload(const PageRead &read) {
+
+		if (this->resident.count(read.key) > 0)
+			return;
+
+		// Take a free slot, or else the one the latest feedback did not ask for and was used the longest ago.
+		int chosen = -1;
+
+		for (int i = 0; i < (int) this->slot_full.size() && chosen < 0; i++)
+			if (!this->slot_full[i])
+				chosen = i;
+
+		if (chosen < 0)
+			for (int i = 0; i < (int) this->slot_full.size(); i++)
+				if (this->slot_used[i] < this->feedback_count && (chosen < 0 || this->slot_used[i] < this->slot_used[chosen]))
+					chosen = i;
+
+		// Everything is in use. The page is asked for again by a later feedback.
+		if (chosen < 0)
+			return;
+
+		if (this->slot_full[chosen])
+			this->resident.erase(this->slot_keys[chosen]);
+
+		int side = this->image.getPageSize() + 2 * this->image.getBorder();
+		int x = chosen % VIRTUAL_TEXTURE_ATLAS_PAGES;
+		int y = chosen / VIRTUAL_TEXTURE_ATLAS_PAGES;
+
+		glActiveTexture(GL_TEXTURE0 + this->slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, this->atlas);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x * side, y * side, 0, side, side, this->image.getLayers(), GL_RGBA, GL_UNSIGNED_BYTE, read.pixels.data());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		this->resident[read.key] = chosen;
+		this->slot_keys[chosen] = read.key;
+		this->slot_used[chosen] = this->feedback_count;
+		this->slot_full[chosen] = 1;
+		this->table_dirty = true;
+
+	}
+
+	void VirtualTexture::updateTable() {
+
+		glActiveTexture(GL_TEXTURE0 + this->slot + 1);
+		glBindTexture(GL_TEXTURE_2D, this->table);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		// From the coarsest level down, so the entries to fall back on are always ready.
+		for (int level = this->image.getLevels() - 1; level >= 0; level--) {
+
+			int pages = this->image.getPages(level);
+			std::vector<unsigned char> &level_entries = this->entries[level];
+
+			for (int y = 0; y < pages; y++) {
+
+				for (int x = 0; x < pages; x++) {
+
+					unsigned char* entry = level_entries.data() + ((size_t) y * pages + x) * 4;
+					auto found = this->resident.find(VirtualTexture::makeKey(level, x, y));
+
+					if (found != this->resident.end()) {
+
+						entry[0] = (unsigned char) (found->second % VIRTUAL_TEXTURE_ATLAS_PAGES);
+						entry[1] = (unsigned char) (found->second / VIRTUAL_TEXTURE_ATLAS_PAGES);
+						entry[2] = (unsigned char) level;
+						entry[3] = 255;
+
+					} else if (level + 1 < this->image.getLevels()) {
+
+						int parent_pages = this->image.getPages(level + 1);
+						const unsigned char* parent = this->entries[level + 1].data() + ((size_t) (y / 2) * parent_pages + x / 2) * 4;
+						std::copy(parent, parent + 4, entry);
+
+					}
+
+				}
+
+			}
+
+			glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, pages, pages, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, level_entries.data());
+
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		this->table_dirty = false;
+
+	}
+
+	void VirtualTexture::removeFeedback() {
+
+		for (int i = 0; i < 2; i++) {
+
+			if (this->readback_fences[i] != nullptr)
+				glDeleteSync(this->readback_fences[i]);
+
+			this->readback_fences[i] = nullptr;
+			DeletionQueue::push(DELETE_BUFFER, this->readback[i]);
+			this->readback[i] = 0;
+
+		}
+
+		this->feedback.remove();
+
+		this->feedback_width = 0;
+		this->feedback_height = 0;
+		this->readback_index = 0;
+
+	}
+
+	uint32_t VirtualTexture::makeKey(int level, int x, int y) {
+
+		return ((uint32_t) level << 24) | ((uint32_t) y << 12) | (uint32_t) x;
+
+	}
+
+}  // namespace bgq_opengl
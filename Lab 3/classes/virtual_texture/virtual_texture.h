@@ -0,0 +1,351 @@
+/**
+ * @file virtual_texture.h
+ * @brief VirtualTexture class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_VIRTUAL_TEXTURE_H_
+#define BGQ_OPENGL_CLASSES_VIRTUAL_TEXTURE_H_
+
+#define VIRTUAL_TEXTURE_PAGE_SIZE 128		/// Pixels along each side of a page, without the border.
+#define VIRTUAL_TEXTURE_BORDER 4			/// Pixels added to every side of a page for filtering.
+#define VIRTUAL_TEXTURE_ATLAS_PAGES 8		/// Pages along each side of the physical atlas.
+#define VIRTUAL_TEXTURE_FEEDBACK_SCALE 8	/// How much smaller the feedback pass is than the screen.
+#define VIRTUAL_TEXTURE_UPLOADS 4			/// Pages uploaded per frame at most.
+#define VIRTUAL_TEXTURE_QUEUE 16			/// Pages being read at most.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/render_target/render_target.h"
+#include "classes/tiled_image/tiled_image.h"
+#include "structs/page_read/page_read.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a VirtualTexture class.
+	 *
+	 * Samples a tiled image far larger than what is kept on the GPU. Only the
+	 * pages that are seen live in a fixed size atlas, and a page table tells
+	 * the shaders where every page of every level is, or which coarser page
+	 * stands in for it until it arrives.
+	 *
+	 * The pages that are seen come from a feedback pass, drawn at a fraction
+	 * of the screen size with the shaders writing the page they need instead
+	 * of a color. It is read back a frame later, and the missing pages are
+	 * read from disk in the background and uploaded a few per frame, evicting
+	 * the ones used the longest ago.
+	 *
+	 * The atlas is bound to its slot and the page table to the next one.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class VirtualTexture {
+
+		public:
+
+			/**
+			 * @brief Construct the virtual texture.
+			 *
+			 * Construct a virtual texture that does nothing until started.
+			 */
+			VirtualTexture();
+
+			/**
+			 * @brief Destroy the virtual texture.
+			 *
+			 * Stops the background thread.
+			 */
+			~VirtualTexture();
+
+			/**
+			 * @brief Start the virtual texture.
+			 *
+			 * Bakes the tiled image if it is out of date, creates the atlas and the
+			 * page table with the coarsest page in them, and starts the background
+			 * thread that reads the pages.
+			 *
+			 * @param layers The images of every layer, laid out in a grid.
+			 * @param columns The number of images in every row of the grid.
+			 * @param directory Directory where the tiled images are kept.
+			 * @param slot Texture slot of the atlas, the page table takes the next one.
+			 */
+			void start(const std::vector<std::vector<std::string>> &layers, int columns, const char* directory, GLuint slot);
+
+			/**
+			 * @brief Starts the feedback pass.
+			 *
+			 * Binds and clears the feedback target. Everything drawn until
+			 * endFeedback() with the feedback shaders asks for its pages.
+			 *
+			 * @param width Width of the screen in pixels.
+			 * @param height Height of the screen in pixels.
+			 */
+			void beginFeedback(int width, int height);
+
+			/**
+			 * @brief Ends the feedback pass.
+			 *
+			 * Starts reading the feedback target back and restores the framebuffer
+			 * and viewport.
+			 */
+			void endFeedback();
+
+			/**
+			 * @brief Updates the resident pages.
+			 *
+			 * Queues the reads of the pages asked for by the last feedback that is
+			 * back, uploads the pages read since the last update and updates the
+			 * page table. Call once per frame, after the feedback pass.
+			 */
+			void update();
+
+			/**
+			 * @brief Binds the virtual texture.
+			 *
+			 * Binds the atlas and the page table to their slots.
+			 */
+			void bind();
+
+			/**
+			 * @brief Get the slot of the atlas.
+			 *
+			 * Get the slot of the atlas. The page table is in the next one.
+			 *
+			 * @returns The slot of the atlas.
+			 */
+			GLuint getSlot() const;
+
+			/**
+			 * @brief Get the size.
+			 *
+			 * Get the width and height of the virtual texture in pixels.
+			 *
+			 * @returns The size in pixels.
+			 */
+			int getSize() const;
+
+			/**
+			 * @brief Get the page size.
+			 *
+			 * Get the size of a page without its border, in pixels.
+			 *
+			 * @returns The page size in pixels.
+			 */
+			int getPageSize() const;
+
+			/**
+			 * @brief Get the border.
+			 *
+			 * Get the pixels added to every side of a page.
+			 *
+			 * @returns The border in pixels.
+			 */
+			int getBorder() const;
+
+			/**
+			 * @brief Get the number of levels.
+			 *
+			 * Get the number of levels of the page table.
+			 *
+			 * @returns The number of levels.
+			 */
+			int getLevels() const;
+
+			/**
+			 * @brief Get the number of columns.
+			 *
+			 * Get the number of images in every row of the grid.
+			 *
+			 * @returns The number of columns.
+			 */
+			int getColumns() const;
+
+			/**
+			 * @brief Get the number of rows.
+			 *
+			 * Get the number of images in every column of the grid.
+			 *
+			 * @returns The number of rows.
+			 */
+			int getRows() const;
+
+			/**
+			 * @brief Get the atlas size.
+			 *
+			 * Get the width and height of the atlas in pixels.
+			 *
+			 * @returns The size in pixels.
+			 */
+			int getAtlasSize() const;
+
+			/**
+			 * @brief Get the feedback bias.
+			 *
+			 * Get the bias to add to the level in the feedback pass, which is drawn
+			 * at a smaller size than the screen.
+			 *
+			 * @returns The bias in levels.
+			 */
+			float getFeedbackBias() const;
+
+			/**
+			 * @brief Get the resident pages.
+			 *
+			 * Get the number of pages in the atlas.
+			 *
+			 * @returns The number of pages.
+			 */
+			int getResidentPages() const;
+
+			/**
+			 * @brief Get the capacity.
+			 *
+			 * Get the number of pages that fit in the atlas.
+			 *
+			 * @returns The number of pages.
+			 */
+			int getCapacity() const;
+
+			/**
+			 * @brief Prints the virtual texture.
+			 *
+			 * Prints the size, the resident pages and the memory of the atlas.
+			 *
+			 * @param out The stream to print to.
+			 */
+			void report(std::ostream &out) const;
+
+			/**
+			 * @brief Stop the virtual texture.
+			 *
+			 * Stops the background thread, waits for it and removes everything from
+			 * OpenGL.
+			 */
+			void stop();
+
+		private:
+
+			/**
+			 * @brief Body of the background thread.
+			 *
+			 * Reads the queued pages until stopped.
+			 */
+			void run();
+
+			/**
+			 * @brief Reads the feedback back.
+			 *
+			 * Collects the pages in the oldest feedback if the GPU is done with it.
+			 *
+			 * @param keys Output variable for the pages asked for.
+			 *
+			 * @returns True if a feedback was read.
+			 */
+			bool readFeedback(std::vector<uint32_t>* keys);
+
+			/**
+			 * @brief Asks for pages.
+			 *
+			 * Marks the resident pages as used and queues the reads of the rest,
+			 * coarsest first.
+			 *
+			 * @param keys The pages asked for.
+			 */
+			void request(std::vector<uint32_t> &keys);
+
+			/**
+			 * @brief Uploads a page.
+			 *
+			 * Copies a page to a free slot of the atlas, or to the one used the
+			 * longest ago if none is free.
+			 *
+			 * @param read The page.
+			 */
+			void upload(const PageRead &read);
+
+			/**
+			 * @brief Updates the page table.
+			 *
+			 * Points every entry to its page, or to the closest coarser page that
+			 * is resident, and uploads every level.
+			 */
+			void updateTable();
+
+			/**
+			 * @brief Removes the feedback target.
+			 *
+			 * Removes the feedback target and the readback buffers from OpenGL.
+			 */
+			void removeFeedback();
+
+			/**
+			 * @brief Packs a page.
+			 *
+			 * Packs the level and position of a page into a key.
+			 *
+			 * @param level The level.
+			 * @param x The column of the page.
+			 * @param y The row of the page.
+			 *
+			 * @returns The key.
+			 */
+			static uint32_t makeKey(int level, int x, int y);
+
+			TiledImage image;										/// The tiled image on disk.
+			GLuint slot = 0;										/// Slot of the atlas.
+			GLuint atlas = 0;										/// Physical pages, one layer per image layer.
+			GLuint table = 0;										/// Page table, one level per image level.
+
+			RenderTarget feedback;									/// Pages asked for by every pixel, with the depth of the pass.
+			GLuint readback[2] = { 0, 0 };							/// Buffers the feedback is read into, in turns.
+			GLsync readback_fences[2] = { nullptr, nullptr };		/// Fences of the reads, null when there is nothing to read.
+			int readback_index = 0;									/// Buffer the next feedback goes into.
+			int feedback_width = 0;									/// Width of the feedback target.
+			int feedback_height = 0;								/// Height of the feedback target.
+			GLint previous_framebuffer = 0;							/// Framebuffer bound before the feedback pass.
+			GLint previous_viewport[4] = { 0, 0, 0, 0 };			/// Viewport before the feedback pass.
+
+			std::unordered_map<uint32_t, int> resident;				/// Atlas slot of every resident page.
+			std::vector<uint32_t> slot_keys;						/// Page in every atlas slot.
+			std::vector<uint64_t> slot_used;						/// Last feedback that asked for every atlas slot.
+			std::vector<unsigned char> slot_full;					/// Whether every atlas slot holds a page.
+			std::unordered_set<uint32_t> loading;					/// Pages being read.
+			std::vector<std::vector<unsigned char>> entries;		/// Page table, level after level.
+			uint64_t feedback_count = 0;							/// Feedbacks read so far.
+			bool table_dirty = false;								/// Whether the page table changed.
+
+			std::deque<PageRead> pending;							/// Pages to read.
+			std::deque<PageRead> done;								/// Pages read and not uploaded yet.
+			std::mutex mutex;										/// Guards the reads.
+			std::condition_variable wake;							/// Wakes the thread up when there is a read.
+			std::thread thread;										/// Background thread.
+			std::atomic<bool> running{false};						/// Whether the thread should keep going.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_VIRTUAL_TEXTURE_H_
@@ -20,9 +20,19 @@
 #include <math.h>
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "GL/glew.h"
@@ -35,19 +45,74 @@
 #include "glm/common.hpp"
 #include "glm/gtx/string_cast.hpp"
 
+#include "classes/block_compressor/block_compressor.h"
 #include "classes/camera/camera.h"
+#include "classes/command_recorder/command_recorder.h"
+#include "classes/command_replay/command_replay.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/deletion_queue/deletion_queue.h"
+#include "classes/frame_capture/frame_capture.h"
+#include "classes/golden_images/golden_images.h"
+#include "classes/image_writer/image_writer.h"
+#include "classes/instance_batch/instance_batch.h"
 #include "classes/light/light.h"
+#include "classes/loader_assimp/loader_assimp.h"
 #include "classes/object/object.h"
 #include "classes/shader/shader.h"
+#include "classes/shader_library/shader_library.h"
 #include "classes/skybox/skybox.h"
+#include "classes/stream_buffer/stream_buffer.h"
+#include "classes/texture_streamer/texture_streamer.h"
+#include "classes/transform_store/transform_store.h"
+#include "classes/turntable_renderer/turntable_renderer.h"
+#include "classes/virtual_texture/virtual_texture.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/captured_frame/captured_frame.h"
+#include "structs/image_job/image_job.h"
+#include "structs/mesh/mesh.h"
 
 void clean() {
 
-	// Delete all the shaders.
-	for (size_t i = 0; i < shaders.size(); i++)
-		shaders[i].remove();
+	// Stop watching the shaders.
+	shader_watcher.stop();
+
+	// Drop the handles, which deletes the textures, meshes and skybox shader.
+	skyboxes.clear();
+	sky_cubemap.reset();
+	base_colors.reset();
+	bump_maps.reset();
+	derivative_maps.reset();
+	normal_maps.reset();
+	objects.clear();
+	shaders.clear();
+	sky_shader.reset();
+	
+	// Anything still listed here leaked a handle.
+	resource_cache.report(std::cerr);
+
+	// Delete the samplers.
+	samplers.clear();
+
+	// Delete the permutations owned by the library.
+	shader_library.remove();
+    
+    // Delete the stream buffer.
+    frame_stream.remove();
+    
+    // Stop streaming and drop the texture arrays.
+    texture_streamer.stop();
+    
+    // Stop paging and delete the virtual texture.
+    virtual_texture.stop();
+    
+    // Save the frames still being read back and delete the readback buffers.
+    frame_capture.finish();
+    frame_capture.remove();
+    capture_writer.stop();
+    
+    // Delete everything that was released, before the context goes away.
+    // Whatever is destroyed after this is freed by the driver along with the context.
+    bgq_opengl::DeletionQueue::close();
     
     // Terminate ImGUI.
     ImGui_ImplGlfwGL3_Shutdown();
@@ -74,56 +139,139 @@ void displayElements() {
     double real_time = std::chrono::duration<double>(current_time.time_since_epoch()).count();
     internal_time = real_time - time_start;
     
+    // Place the replicas for this time, seen from the current camera.
+    poseReplicas(internal_time, cameras[current_camera].getView());
+    
     // Get info from the model.
-    bgq_opengl::BoundingBox bb = objects[current_object].getBoundingBox();
+    bgq_opengl::BoundingBox bb = objects[current_object]->getBoundingBox();
     glm::vec3 centre = (bb.min + bb.max) / 2.0f;
     glm::vec3 size = bb.max - bb.min;
-    float max_dim = std::max(size.x, std::max(size.y, size.z));
-    float scale_rat = NORM_SIZE / max_dim;
+    
+    // Work out how many texels of the finest level land on each pixel, for the closest replica.
+    int framebuffer_width, framebuffer_height;
+    glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+    
+    const glm::mat4 &projection = cameras[current_camera].getProjection();
+    const glm::mat4 &view = cameras[current_camera].getView();
+    float uv_density = objects[current_object]->getUVDensity();
+    float texels_per_pixel = 0.0f;
     
     for (int i = 1; i < shaders.size(); i++) {
         
-        // Pass the parameters to the shaders.
-        shaders[i].activate();
-        shaders[i].passLight(scene_light);
+        const glm::mat4 &world = scene_transforms.getWorldMatrix(model_nodes[i - 1]);
+        float scale = glm::length(glm::vec3(world[0]));
+        
+        // Measure from the closest point of the bounding sphere, never from behind the camera.
+        glm::vec3 position = glm::vec3(view * world * glm::vec4(centre, 1.0f));
+        float distance = std::max(glm::length(position) - glm::length(size) * 0.5f * scale, 0.1f);
         
-        objects[current_object].resetTransforms();
+        float pixels_per_unit = projection[1][1] * framebuffer_height * 0.5f / distance;
+        float uv_per_unit = uv_density * coord_multiplier / scale;
+        texels_per_pixel = std::max(texels_per_pixel, uv_per_unit / pixels_per_unit);
         
-        // Rotate
-        objects[current_object].rotate(0.0, 1.0, 0.0, internal_time * 20.0);
-        objects[current_object].rotate(0.0, 1.0, 0.0, 360.0 / (shaders.size() - 1) * i);
+    }
+    
+    // Only the levels that are seen get streamed in.
+    texture_streamer.request(*base_colors, bgq_opengl::TextureStreamer::computeLevel(texels_per_pixel * base_colors->getWidth()));
+    texture_streamer.request(*bump_maps, bgq_opengl::TextureStreamer::computeLevel(texels_per_pixel * bump_maps->getWidth()));
+    texture_streamer.request(*derivative_maps, bgq_opengl::TextureStreamer::computeLevel(texels_per_pixel * derivative_maps->getWidth()));
+    texture_streamer.request(*normal_maps, bgq_opengl::TextureStreamer::computeLevel(texels_per_pixel * normal_maps->getWidth()));
+    texture_streamer.update();
+    
+    if (virtual_texturing) {
         
-        // Center the object and get it in the right position.
-        objects[current_object].translate(0.0f, 0.0f, 1.0f);
+        // Draw the pages every pixel needs into the small feedback target. It is read back a frame later.
+        // A replay draws into one framebuffer only, so the pass is left out of any recording.
+        if (feedback_shader->isReady()) {
+            
+            bgq_opengl::CommandRecorder* recorder = bgq_opengl::CommandRecorder::suspend();
+            virtual_texture.beginFeedback(framebuffer_width, framebuffer_height);
+            
+            feedback_shader->activate();
+            feedback_shader->passFloat("coordMult", coord_multiplier);
+            feedback_shader->passVirtualTexture(virtual_texture, virtual_texture.getFeedbackBias());
+            
+            for (int i = 1; i < shaders.size(); i++)
+                objects[current_object]->draw(*feedback_shader, cameras[current_camera], frame_stream, frame_instances.get(i - 1));
+            
+            virtual_texture.endFeedback();
+            bgq_opengl::CommandRecorder::resume(recorder);
+            
+        }
+        
+        // Page in what an earlier feedback asked for.
+        virtual_texture.update();
+        
+    }
+    
+    // Filter the textures of the current material with its preset.
+    bgq_opengl::Sampler &sampler = samplers[material_samplers[current_texture]];
+    sampler.bind(base_colors->getSlot());
+    sampler.bind(bump_maps->getSlot());
+    sampler.bind(derivative_maps->getSlot());
+    sampler.bind(normal_maps->getSlot());
+    
+    for (int i = 1; i < shaders.size(); i++) {
         
-        // Resize it to normalize it.
-        objects[current_object].scale(scale_rat, scale_rat, scale_rat);
+        bgq_opengl::Shader* shader = virtual_texturing ? virtual_shaders[i - 1] : shaders[i];
         
-        // Center the object and get it in the right position.
-        objects[current_object].translate(-centre.x, -centre.y, -centre.z);
+        // Skip the replicas whose shader is still compiling instead of stalling the frame.
+        if (!shader->isReady())
+            continue;
         
-        // Pass variables to the shaders.
-        shaders[i].passFloat("lightPower", 10.0f);
-        shaders[i].passFloat("minAmbientLight", 0.5f);
-        shaders[i].passFloat("materialShininess", 0.5f);
-        shaders[i].passFloat("coordMult", coord_multiplier);
-        shaders[i].passFloat("bumpMult", bump_multiplier);
+        // Pass the parameters to the shaders.
+        passParameters(shader);
         
-        // Pass the textures.
-        shaders[i].passTexture(base_colors[current_texture]);
-        shaders[i].passTexture(bump_maps[current_texture]);
-        shaders[i].passTexture(normal_maps[current_texture]);
+        if (virtual_texturing)
+            shader->passVirtualTexture(virtual_texture, 0.0f);
 
         // Draw the object.
-        objects[current_object].draw(shaders[i], cameras[current_camera]);
+        objects[current_object]->draw(*shader, cameras[current_camera], frame_stream, frame_instances.get(i - 1));
         
     }
     
     // Print the skybox.
-    skyboxes[0].draw(shaders[0], cameras[current_camera]);
+    skyboxes[0].draw(*shaders[0], cameras[current_camera]);
         
 }
 
+void poseReplicas(double time, const glm::mat4 &view) {
+    
+    poseReplicas(time, view, objects[current_object]->getBoundingBox(), shaders.size() - 1);
+    
+}
+
+void poseReplicas(double time, const glm::mat4 &view, const bgq_opengl::BoundingBox &bb, int replicas) {
+    
+    // Get info from the model.
+    glm::vec3 centre = (bb.min + bb.max) / 2.0f;
+    glm::vec3 size = bb.max - bb.min;
+    float max_dim = std::max(size.x, std::max(size.y, size.z));
+    float scale_rat = NORM_SIZE / max_dim;
+    
+    // Update the turntable of every shader replica. Only the nodes that change get recomputed.
+    for (int i = 1; i <= turntable_nodes.size(); i++) {
+        
+        // Spin the turntable and spread the replicas on screen evenly around it. A hidden one is posed but never drawn.
+        float angle = time * 20.0 + 360.0 / replicas * i;
+        scene_transforms.setRotation(turntable_nodes[i - 1], glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f)));
+        
+        // Center the object, resize it to normalize it, and get it in the right position.
+        scene_transforms.setPosition(model_nodes[i - 1], glm::vec3(0.0f, 0.0f, 1.0f) - centre * scale_rat);
+        scene_transforms.setScale(model_nodes[i - 1], glm::vec3(scale_rat));
+        
+    }
+    
+    scene_transforms.update();
+    
+    // Compute the model view and normal matrices of every replica in bulk. The scale is uniform.
+    frame_instances.clear();
+    for (int i = 1; i <= model_nodes.size(); i++)
+        frame_instances.add(scene_transforms.getWorldMatrix(model_nodes[i - 1]), true, current_texture);
+    frame_instances.compute(view);
+    
+}
+
 void displayGUI() {
     
     // Init ImGUI for rendering.
@@ -147,6 +295,94 @@ void displayGUI() {
     
     ImGui::SliderFloat("Size", &coord_multiplier, 0.01, 10.0);
     ImGui::SliderFloat("Bump", &bump_multiplier, 0.01, 20.0);
+    
+    // Filtering of the current material.
+    const char* filters[SAMPLER_PRESETS];
+    for (int i = 0; i < SAMPLER_PRESETS; i++)
+        filters[i] = bgq_opengl::Sampler::getPresetName(i);
+    
+    ImGui::Combo("Filtering", &material_samplers[current_texture], filters, SAMPLER_PRESETS);
+    
+    // Page the bump and normal maps of all the materials in from one large texture.
+    ImGui::Checkbox("Virtual texture", &virtual_texturing);
+    ImGui::Text("Pages %d / %d", virtual_texture.getResidentPages(), virtual_texture.getCapacity());
+    
+    if (ImGui::Button("Benchmark filtering"))
+        benchmark_requested = true;
+    
+    if (ImGui::Button("Benchmark bump baker"))
+        baker_benchmark_requested = true;
+    
+    if (ImGui::Button("Benchmark transforms"))
+        transform_benchmark_requested = true;
+    
+    if (ImGui::Button("Benchmark instances"))
+        instance_benchmark_requested = true;
+    
+    // The bump replica is the second one, and the parallax one shades the bumps it hits the same way.
+    if (ImGui::Combo("Bump method", &bump_method, bump_method_names, BUMP_METHODS)) {
+        
+        shaders[2] = &shader_library.get(SHADER_BUMP_MAP | bump_method_features[bump_method] | SHADER_GAMMA);
+        
+        if (parallax_mapping)
+            shaders[4] = &shader_library.get(SHADER_PARALLAX | bump_method_features[bump_method] | SHADER_GAMMA);
+        
+    }
+    
+    if (ImGui::Button("Compare bump methods"))
+        bump_comparison_requested = true;
+    
+    // The parallax replica is the last one, the others spread out to fill its place when it is gone.
+    if (ImGui::Checkbox("Parallax occlusion", &parallax_mapping)) {
+        
+        if (parallax_mapping)
+            shaders.push_back(&shader_library.get(SHADER_PARALLAX | bump_method_features[bump_method] | SHADER_GAMMA));
+        else
+            shaders.pop_back();
+        
+    }
+    
+    ImGui::SliderFloat("Parallax depth", &parallax_scale, 0.0, 0.1);
+    
+    // The march never takes fewer steps than the minimum.
+    if (ImGui::SliderInt("Parallax min steps", &parallax_min_steps, 1, 64))
+        parallax_max_steps = std::max(parallax_max_steps, parallax_min_steps);
+    
+    ImGui::SliderInt("Parallax max steps", &parallax_max_steps, parallax_min_steps, 64);
+    
+    if (ImGui::Button("Compare shading models"))
+        shading_comparison_requested = true;
+    
+    if (ImGui::Button("Render on the CPU"))
+        software_render_requested = true;
+    
+    if (ImGui::Button("Benchmark CPU shading"))
+        software_benchmark_requested = true;
+    
+    // Save every frame of the window, without the GUI, to numbered files.
+    if (ImGui::Checkbox("Record frames", &recording)) {
+        
+        if (recording) {
+            
+            std::error_code error;
+            std::filesystem::create_directories(CAPTURE_DIR, error);
+            
+        } else {
+            
+            frame_capture.finish();
+            
+        }
+        
+    }
+    
+    ImGui::Text("Recorded %ld, %ld stalls", frame_capture.getCaptured(), frame_capture.getStalls());
+    
+    // Record the commands of the next frame, and issue them again offscreen without anything else.
+    if (ImGui::Button("Record commands"))
+        command_record_requested = true;
+    
+    if (ImGui::Button("Replay commands"))
+        command_replay_requested = true;
 
     ImGui::End();
     
@@ -239,6 +475,574 @@ void handleKeyEvents() {
     
 }
 
+void passParameters(bgq_opengl::Shader* shader) {
+    
+    shader->activate();
+    shader->passLight(scene_light);
+    
+    // Pass variables to the shaders.
+    shader->passFloat("materialShininess", 0.5f);
+    shader->passFloat("coordMult", coord_multiplier);
+    shader->passFloat("bumpMult", bump_multiplier);
+    shader->passFloat("parallaxScale", parallax_scale);
+    shader->passInt("parallaxMinSteps", parallax_min_steps);
+    shader->passInt("parallaxMaxSteps", std::max(parallax_max_steps, parallax_min_steps));
+    
+    // Point the samplers to the texture arrays. Nothing gets bound.
+    shader->passTexture(*base_colors);
+    shader->passTexture(*bump_maps);
+    shader->passTexture(*derivative_maps);
+    shader->passTexture(*normal_maps);
+    
+}
+
+void drawReplicas(bgq_opengl::Shader* shader, bgq_opengl::Camera &camera) {
+    
+    drawReplicas(std::vector<bgq_opengl::Shader*>(shaders.size() - 1, shader), camera);
+    
+}
+
+void drawReplicas(const std::vector<bgq_opengl::Shader*> &replica_shaders, bgq_opengl::Camera &camera) {
+    
+    frame_stream.beginFrame();
+    
+    for (int i = 1; i <= replica_shaders.size(); i++) {
+        
+        // Only pass the parameters again when the shader changes.
+        if (i == 1 || replica_shaders[i - 1] != replica_shaders[i - 2])
+            passParameters(replica_shaders[i - 1]);
+        
+        objects[current_object]->draw(*replica_shaders[i - 1], camera, frame_stream, frame_instances.get(i - 1));
+        
+    }
+    
+    frame_stream.endFrame();
+    
+}
+
+void benchmarkSamplers() {
+    
+    bgq_opengl::FillRateBenchmark benchmark(BENCHMARK_SIZE, BENCHMARK_SIZE);
+    
+    std::cerr << "Fill rate of " << BENCHMARK_SIZE << "x" << BENCHMARK_SIZE << " with four taps of the bump map:" << std::endl;
+    
+    for (int i = 0; i < SAMPLER_PRESETS; i++) {
+        
+        double ms = benchmark.measure(*bump_maps, current_texture, samplers[i], BENCHMARK_PASSES);
+        double gigapixels = BENCHMARK_SIZE * BENCHMARK_SIZE / (ms / 1000.0) / 1e9;
+        
+        std::cerr << "    " << bgq_opengl::Sampler::getPresetName(i) << ": " << ms << " ms per pass, " << gigapixels << " Gpixel/s" << std::endl;
+        
+    }
+    
+    benchmark.remove();
+    
+}
+
+void compareBumps() {
+    
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    
+    bgq_opengl::BumpComparison comparison(width, height);
+    
+    // Draws every replica with the same shader, as the frame would.
+    auto drawWith = [](bgq_opengl::Shader* shader) {
+        
+        return [shader]() { drawReplicas(shader, cameras[current_camera]); };
+        
+    };
+    
+    std::vector<unsigned char> reference, pixels;
+    comparison.reference(drawWith(&shader_library.get(SHADER_BUMP_MAP | SHADER_GAMMA)), &reference);
+    
+    std::cerr << "Bump mapping of " << width << "x" << height << ", against the texel taps at twice the size:" << std::endl;
+    
+    for (int i = 0; i < BUMP_METHODS; i++) {
+        
+        double ms = comparison.measure(drawWith(&shader_library.get(SHADER_BUMP_MAP | bump_method_features[i] | SHADER_GAMMA)), BENCHMARK_PASSES, &pixels);
+        
+        std::cerr << "    " << bump_method_names[i] << ": " << ms << " ms per pass, " << bgq_opengl::BumpComparison::computePSNR(pixels, reference) << " dB" << std::endl;
+        
+    }
+    
+    comparison.remove();
+    
+}
+
+void compareShadingModels() {
+    
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    
+    bgq_opengl::BumpComparison comparison(width, height);
+    
+    // Draws every replica with the same shader, so every model covers the same pixels.
+    auto drawWith = [](bgq_opengl::Shader* shader) {
+        
+        return [shader]() { drawReplicas(shader, cameras[current_camera]); };
+        
+    };
+    
+    bgq_opengl::Shader* models[SHADING_MODELS] = {
+        &shader_library.get(SHADER_GAMMA),
+        &shader_library.get(SHADER_BUMP_MAP | bump_method_features[bump_method] | SHADER_GAMMA),
+        &shader_library.get(SHADER_NORMAL_MAP | SHADER_GAMMA),
+        &shader_library.get(SHADER_PARALLAX | bump_method_features[bump_method] | SHADER_GAMMA)
+    };
+    
+    std::vector<unsigned char> pixels;
+    
+    std::cerr << "Shading models of " << width << "x" << height << ", " << shaders.size() - 1 << " replicas each:" << std::endl;
+    
+    for (int i = 0; i < SHADING_MODELS; i++) {
+        
+        double ms = comparison.measure(drawWith(models[i]), BENCHMARK_PASSES, &pixels);
+        
+        std::cerr << "    " << shading_model_names[i] << ": " << ms << " ms per pass" << std::endl;
+        
+    }
+    
+    // The same parallax with every ray taking all the steps, to see what the adaptive count saves.
+    int min_steps = parallax_min_steps;
+    parallax_min_steps = std::max(parallax_max_steps, parallax_min_steps);
+    
+    double ms = comparison.measure(drawWith(models[SHADING_MODELS - 1]), BENCHMARK_PASSES, &pixels);
+    std::cerr << "    " << shading_model_names[SHADING_MODELS - 1] << ", " << parallax_min_steps << " fixed steps: " << ms << " ms per pass" << std::endl;
+    
+    parallax_min_steps = min_steps;
+    
+    comparison.remove();
+    
+}
+
+void loadSoftwareMaterials() {
+    
+    // The maps are only loaded the first time, they take a while.
+    if (!software_materials.empty())
+        return;
+    
+    for (size_t i = 0; i < color_images.size(); i++) {
+        
+        bgq_opengl::SoftwareMaterial material;
+        material.color = bgq_opengl::SoftwareRenderer::loadTexture(color_images[i], TEXTURE_USAGE_COLOR);
+        material.bump = bgq_opengl::SoftwareRenderer::loadTexture(bump_images[i], TEXTURE_USAGE_BUMP);
+        material.normal = bgq_opengl::SoftwareRenderer::loadTexture(normal_images[i], TEXTURE_USAGE_NORMAL);
+        software_materials.push_back(std::move(material));
+        
+    }
+    
+}
+
+void renderSoftware() {
+    
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    
+    loadSoftwareMaterials();
+    
+    // The permutation every replica is drawn with. The software renderer only takes the slopes from texel taps.
+    const unsigned int replica_features[SHADING_MODELS] = { SHADER_GAMMA, SHADER_BUMP_MAP | SHADER_GAMMA, SHADER_NORMAL_MAP | SHADER_GAMMA, SHADER_PARALLAX | SHADER_GAMMA };
+    
+    // The CPU draws parallax as plain bumps, so the parallax replica, the last one, is left out of both sides.
+    int replicas = std::min((int) shaders.size() - 1, SHADING_MODELS - 1);
+    
+    bgq_opengl::SoftwareRenderer renderer(width, height);
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    renderer.clear(background);
+    renderer.setCamera(cameras[current_camera]);
+    renderer.setLight(scene_light);
+    renderer.setMultipliers(coord_multiplier, bump_multiplier);
+    
+    for (int i = 1; i <= replicas; i++)
+        renderer.draw(*objects[current_object], frame_instances.get(i - 1), software_materials[current_texture], replica_features[i - 1]);
+    
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    // The same replicas on the GPU, without the skybox, with the same features and the slopes from texel taps too.
+    std::vector<bgq_opengl::Shader*> replica_shaders;
+    for (int i = 1; i <= replicas; i++)
+        replica_shaders.push_back(&shader_library.get(replica_features[i - 1] | bump_method_features[1]));
+    
+    bgq_opengl::BumpComparison comparison(width, height);
+    std::vector<unsigned char> pixels;
+    
+    double gpu_ms = comparison.measure([&replica_shaders]() { drawReplicas(replica_shaders, cameras[current_camera]); }, BENCHMARK_PASSES, &pixels);
+    
+    comparison.remove();
+    
+    std::cerr << "Software renderer, " << width << "x" << height << " on " << renderer.getThreads() << " threads, " << replicas << " replicas without parallax:" << std::endl;
+    std::cerr << "    " << ms << " ms, " << renderer.getTriangles() << " triangles, " << renderer.getFragments() << " fragments, "
+        << width * height / (ms / 1000.0) / 1e6 << " Mpixel/s, " << renderer.getFragments() / (ms / 1000.0) / 1e6 << " Mfragment/s" << std::endl;
+    std::cerr << "    GPU " << gpu_ms << " ms per pass, " << bgq_opengl::BumpComparison::computePSNR(renderer.getPixels(), pixels) << " dB against it" << std::endl;
+    
+}
+
+void streamFinestLevels() {
+    
+    texture_streamer.setBudget(std::numeric_limits<size_t>::max());
+    
+    const bgq_opengl::TextureArray* arrays[4] = { base_colors.get(), bump_maps.get(), derivative_maps.get(), normal_maps.get() };
+    auto streaming_start = std::chrono::steady_clock::now();
+    
+    while (true) {
+        
+        bool resident = true;
+        
+        for (int i = 0; i < 4; i++) {
+            
+            texture_streamer.request(*arrays[i], 0);
+            resident = resident && texture_streamer.getResidentLevel(*arrays[i]) == 0;
+            
+        }
+        
+        texture_streamer.update();
+        
+        if (resident)
+            break;
+        
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - streaming_start).count() > STREAM_TIMEOUT) {
+            
+            std::cerr << "The finest levels did not stream in, the images may not match." << std::endl;
+            break;
+            
+        }
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        
+    }
+    
+}
+
+std::string goldenName(int object, int texture, int model, int frame) {
+    
+    // Named like torus_bricks_normal-map_0.
+    std::string model_name = shading_model_names[model];
+    std::transform(model_name.begin(), model_name.end(), model_name.begin(), [](unsigned char c) { return c == ' ' ? '-' : (char) std::tolower(c); });
+    
+    return std::string(object_names[object]) + "_" + color_images[texture].substr(0, color_images[texture].find('_')) + "_" + model_name + "_" + std::to_string(frame);
+    
+}
+
+void reportGolden(const std::string &name, const bgq_opengl::GoldenResult &result, int *passed, int *failed, int *recorded) {
+    
+    if (result.recorded) {
+        
+        (*recorded)++;
+        std::cerr << "    " << name << ": recorded" << std::endl;
+        return;
+        
+    }
+    
+    if (result.missing) {
+        
+        (*failed)++;
+        std::cerr << "    " << name << ": FAILED, no golden image, run with --record to record it" << std::endl;
+        return;
+        
+    }
+    
+    if (result.passed)
+        (*passed)++;
+    else
+        (*failed)++;
+    
+    std::cerr << "    " << name << ": " << (result.passed ? "passed" : "FAILED") << ", largest difference " << result.largest_difference
+        << ", " << std::fixed << std::setprecision(3) << result.different_pixels * 100.0 << "% different, SSIM " << std::setprecision(4) << result.ssim << std::endl;
+    std::cerr.unsetf(std::ios::floatfield);
+    
+}
+
+int checkGoldenImages(const std::string &directory) {
+    
+    bgq_opengl::BumpComparison target(GOLDEN_SIZE, GOLDEN_SIZE);
+    bgq_opengl::GoldenImages goldens(directory, golden_record);
+    
+    // The starting camera, whatever the window is.
+    bgq_opengl::Camera camera(glm::vec3(0.0f, 0.75f, 3.0f), glm::vec3(0.0f, -0.25f, -1.0f), 45.0f, 0.1f, 300.0f, GOLDEN_SIZE, GOLDEN_SIZE);
+    
+    // Every level resident, so the images do not depend on what was streamed so far.
+    size_t budget = texture_streamer.getBudget();
+    streamFinestLevels();
+    
+    const bgq_opengl::TextureArray* arrays[4] = { base_colors.get(), bump_maps.get(), derivative_maps.get(), normal_maps.get() };
+    
+    bgq_opengl::Shader* models[SHADING_MODELS] = {
+        &shader_library.get(SHADER_GAMMA),
+        &shader_library.get(SHADER_BUMP_MAP | bump_method_features[bump_method] | SHADER_GAMMA),
+        &shader_library.get(SHADER_NORMAL_MAP | SHADER_GAMMA),
+        &shader_library.get(SHADER_PARALLAX | bump_method_features[bump_method] | SHADER_GAMMA)
+    };
+    
+    // Every replica with the same shader, filtered trilinearly.
+    auto drawWith = [&camera](bgq_opengl::Shader* shader) {
+        
+        return [shader, &camera]() { drawReplicas(shader, camera); };
+        
+    };
+    
+    for (int i = 0; i < 4; i++)
+        samplers[SAMPLER_TRILINEAR].bind(arrays[i]->getSlot());
+    
+    glClearColor(background.x, background.y, background.z, background.w);
+    
+    int object = current_object, texture = current_texture;
+    int passed = 0, failed = 0, recorded = 0;
+    std::vector<unsigned char> pixels;
+    
+    std::cerr << "Golden images of " << GOLDEN_SIZE << "x" << GOLDEN_SIZE << " in " << directory << ":" << std::endl;
+    
+    for (current_object = 0; current_object < objects.size(); current_object++) {
+        
+        for (current_texture = 0; current_texture < color_images.size(); current_texture++) {
+            
+            for (int frame = 0; frame < GOLDEN_FRAMES; frame++) {
+                
+                poseReplicas(golden_times[frame], camera.getView());
+                
+                for (int model = 0; model < SHADING_MODELS; model++) {
+                    
+                    std::string name = goldenName(current_object, current_texture, model, frame);
+                    
+                    target.capture(drawWith(models[model]), &pixels);
+                    reportGolden(name, goldens.check(name, pixels, GOLDEN_SIZE, GOLDEN_SIZE), &passed, &failed, &recorded);
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    std::cerr << "Golden images: " << passed << " passed, " << failed << " failed, " << recorded << " recorded." << std::endl;
+    
+    current_object = object;
+    current_texture = texture;
+    texture_streamer.setBudget(budget);
+    target.remove();
+    
+    return failed;
+    
+}
+
+int checkSoftwareGoldens(const std::string &directory) {
+    
+    bgq_opengl::SoftwareRenderer renderer(GOLDEN_SIZE, GOLDEN_SIZE);
+    bgq_opengl::GoldenImages goldens(directory, golden_record);
+    
+    // The starting camera, the same as the golden images of the GPU.
+    bgq_opengl::Camera camera(glm::vec3(0.0f, 0.75f, 3.0f), glm::vec3(0.0f, -0.25f, -1.0f), 45.0f, 0.1f, 300.0f, GOLDEN_SIZE, GOLDEN_SIZE);
+    scene_light = bgq_opengl::Light(glm::vec3(3.0f, 3.0f, 3.0f), glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    
+    // Nothing was initialised, so create the turntables of the replicas here.
+    for (int i = 0; i < SHADING_MODELS; i++) {
+        
+        turntable_nodes.push_back(scene_transforms.create());
+        model_nodes.push_back(scene_transforms.create(turntable_nodes.back()));
+        
+    }
+    
+    // The software renderer only takes the slopes from texel taps, and draws parallax as bump mapping.
+    const unsigned int features[SHADING_MODELS] = { SHADER_GAMMA, SHADER_BUMP_MAP | SHADER_GAMMA, SHADER_NORMAL_MAP | SHADER_GAMMA, SHADER_PARALLAX | SHADER_GAMMA };
+    
+    loadSoftwareMaterials();
+    
+    int passed = 0, failed = 0, recorded = 0;
+    
+    std::cerr << "Software golden images of " << GOLDEN_SIZE << "x" << GOLDEN_SIZE << " on " << renderer.getThreads() << " threads in " << directory << ":" << std::endl;
+    
+    for (int object = 0; object < (int) (sizeof(object_names) / sizeof(object_names[0])); object++) {
+        
+        // Only the triangles are loaded, no buffer is created for them.
+        std::string file = std::string(object_names[object]) + ".glb";
+        std::vector<bgq_opengl::Mesh> meshes;
+        bgq_opengl::LoaderAssimp loader(file.c_str());
+        loader.loadModel();
+        loader.getMeshes(&meshes);
+        
+        // The bounds of every mesh together, the same as Object::getBoundingBox.
+        bgq_opengl::BoundingBox bb = { meshes[0].vertices[0].position, meshes[0].vertices[0].position };
+        
+        for (size_t i = 0; i < meshes.size(); i++) {
+            
+            for (size_t j = 0; j < meshes[i].vertices.size(); j++) {
+                
+                bb.min = glm::min(bb.min, meshes[i].vertices[j].position);
+                bb.max = glm::max(bb.max, meshes[i].vertices[j].position);
+                
+            }
+            
+        }
+        
+        for (current_texture = 0; current_texture < color_images.size(); current_texture++) {
+            
+            for (int frame = 0; frame < GOLDEN_FRAMES; frame++) {
+                
+                poseReplicas(golden_times[frame], camera.getView(), bb, SHADING_MODELS);
+                
+                for (int model = 0; model < SHADING_MODELS; model++) {
+                    
+                    std::string name = goldenName(object, current_texture, model, frame);
+                    
+                    renderer.clear(background);
+                    renderer.setCamera(camera);
+                    renderer.setLight(scene_light);
+                    renderer.setMultipliers(coord_multiplier, bump_multiplier);
+                    
+                    // Every replica with the same shading model, with the shininess every object is given.
+                    for (int i = 0; i < SHADING_MODELS; i++)
+                        for (size_t j = 0; j < meshes.size(); j++)
+                            renderer.draw(meshes[j].vertices, meshes[j].indices, frame_instances.get(i), software_materials[current_texture], features[model], 200.0f);
+                    
+                    reportGolden(name, goldens.check(name, renderer.getPixels(), GOLDEN_SIZE, GOLDEN_SIZE), &passed, &failed, &recorded);
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    std::cerr << "Software golden images: " << passed << " passed, " << failed << " failed, " << recorded << " recorded." << std::endl;
+    
+    current_texture = 0;
+    
+    return failed;
+    
+}
+
+void renderTurntable() {
+    
+    int format = turntable_exr ? IMAGE_FORMAT_EXR : IMAGE_FORMAT_PNG;
+    
+    // The starting camera, at the size of the window.
+    bgq_opengl::Camera camera(glm::vec3(0.0f, 0.75f, 3.0f), glm::vec3(0.0f, -0.25f, -1.0f), 45.0f, 0.1f, 300.0f, WINDOW_WIDTH, WINDOW_HEIGHT);
+    
+    size_t budget = texture_streamer.getBudget();
+    streamFinestLevels();
+    
+    const bgq_opengl::TextureArray* arrays[4] = { base_colors.get(), bump_maps.get(), derivative_maps.get(), normal_maps.get() };
+    
+    for (int i = 0; i < 4; i++)
+        samplers[SAMPLER_TRILINEAR].bind(arrays[i]->getSlot());
+    
+    // EXR files keep the linear colors.
+    const unsigned int features[SHADING_MODELS] = {
+        0,
+        SHADER_BUMP_MAP | bump_method_features[bump_method],
+        SHADER_NORMAL_MAP,
+        SHADER_PARALLAX | bump_method_features[bump_method]
+    };
+    
+    bgq_opengl::Shader* shader = &shader_library.get(features[turntable_model] | (turntable_exr ? 0 : SHADER_GAMMA));
+    
+    int object = current_object, texture = current_texture;
+    current_object = turntable_object;
+    current_texture = turntable_texture;
+    
+    // Every replica with the same shader, and the skybox behind them.
+    auto draw = [shader, &camera]() {
+        
+        drawReplicas(shader, camera);
+        skyboxes[0].draw(*shaders[0], camera);
+        
+    };
+    
+    glClearColor(background.x, background.y, background.z, background.w);
+    
+    bgq_opengl::ImageWriter writer;
+    writer.start();
+    bgq_opengl::TurntableRenderer renderer(WINDOW_WIDTH, WINDOW_HEIGHT, format, &writer);
+    
+    std::cerr << "Turntable of " << turntable_frames << " frames of " << WINDOW_WIDTH << "x" << WINDOW_HEIGHT << " in " << turntable_directory << ":" << std::endl;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    // One whole turn, never drawing the first pose twice.
+    for (int frame = 0; frame < turntable_frames; frame++) {
+        
+        std::ostringstream path;
+        path << turntable_directory << "/" << object_names[turntable_object] << "_" << std::setw(4) << std::setfill('0') << frame << (turntable_exr ? ".exr" : ".png");
+        
+        poseReplicas(TURNTABLE_PERIOD * frame / turntable_frames, camera.getView());
+        renderer.render(draw, path.str());
+        
+    }
+    
+    renderer.finish();
+    double rendered = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    writer.wait();
+    double written = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cerr << "    Rendered in " << rendered << " s, written in " << written << " s, " << turntable_frames / written << " frames per second" << std::endl;
+    
+    renderer.remove();
+    writer.stop();
+    
+    current_object = object;
+    current_texture = texture;
+    texture_streamer.setBudget(budget);
+    
+}
+
+void replayCommands() {
+    
+    if (!std::filesystem::exists(COMMAND_FILE)) {
+        
+        std::cerr << "Replay: there is no recorded frame in " << COMMAND_FILE << " yet." << std::endl;
+        return;
+        
+    }
+    
+    bgq_opengl::CommandReplay replay(COMMAND_FILE);
+    bgq_opengl::BumpComparison target(replay.getWidth(), replay.getHeight());
+    
+    // Time issuing the commands apart from the GPU running them.
+    double issue_ms = 0.0;
+    int passes = 0;
+    
+    auto draw = [&replay, &issue_ms, &passes]() {
+        
+        auto start = std::chrono::steady_clock::now();
+        replay.draw();
+        issue_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        passes++;
+        
+    };
+    
+    std::vector<unsigned char> pixels;
+    double gpu_ms = target.measure(draw, BENCHMARK_PASSES, &pixels);
+    
+    std::cerr << "Replay of " << replay.getDraws() << " draws, " << replay.getCommands() << " commands, " << replay.getWidth() << "x" << replay.getHeight() << ":" << std::endl;
+    std::cerr << "    " << issue_ms / passes << " ms to issue, " << gpu_ms << " ms on the GPU per pass" << std::endl;
+    
+    replay.remove();
+    target.remove();
+    
+}
+
+void reloadShaders() {
+    
+    std::string filename, contents;
+    
+    // The watcher already read the files, so this only compiles.
+    while (shader_watcher.poll(&filename, &contents)) {
+        
+        size_t reloaded = shader_library.reload(filename, contents);
+        if (sky_shader->reload(filename, contents))
+            reloaded++;
+        
+        std::cerr << "Reloaded " << reloaded << " shader(s) using " << filename << std::endl;
+        
+    }
+    
+}
+
 void initElements() {
     
 	// Create a white light in the center of the world.
@@ -255,55 +1059,107 @@ void initElements() {
     };
     
     // Load the textures.
-    bgq_opengl::Cubemap skycubemap(faces, "skybox", 1);
-    bgq_opengl::Skybox skybox(skycubemap);
-    skyboxes.push_back(skybox);
+    sky_cubemap = resource_cache.getCubemap(faces, "skybox", 1);
+    skyboxes.push_back(bgq_opengl::Skybox(sky_cubemap));
+    
+    // Open the program binary cache so the shaders do not need compiling on every run.
+    program_cache = bgq_opengl::ProgramCache(SHADER_CACHE_DIR);
     
-    bgq_opengl::Shader sky_shader("skybox.vert", "skybox.frag");
-    shaders.push_back(sky_shader);
+    sky_shader = resource_cache.getShader("skybox.vert", "skybox.frag", "", &program_cache);
+    shaders.push_back(sky_shader.get());
     
-	// Get the shaders.
-    bgq_opengl::Shader blinn_phong("blinn_phong.vert", "blinn_phong.frag");
-    shaders.push_back(blinn_phong);
+	// Get the permutations of the über-shader that are actually used.
+    // They are only submitted here, and keep compiling while the textures and objects load.
+    shader_library = bgq_opengl::ShaderLibrary("uber.vert", "uber.frag", &program_cache);
+    shaders.push_back(&shader_library.get(SHADER_GAMMA));
+    shaders.push_back(&shader_library.get(SHADER_BUMP_MAP | bump_method_features[bump_method] | SHADER_GAMMA));
+    shaders.push_back(&shader_library.get(SHADER_NORMAL_MAP | SHADER_GAMMA));
+    shaders.push_back(&shader_library.get(SHADER_PARALLAX | bump_method_features[bump_method] | SHADER_GAMMA));
     
-	bgq_opengl::Shader bump_map("bump_map.vert", "bump_map.frag");
-    shaders.push_back(bump_map);
+    // The same replicas with the maps coming from the virtual texture, and the pass that asks for its pages.
+    // The ray of the parallax would wander off the pages, so that replica is only bump mapped there.
+    virtual_shaders.push_back(&shader_library.get(SHADER_VIRTUAL | SHADER_GAMMA));
+    virtual_shaders.push_back(&shader_library.get(SHADER_VIRTUAL | SHADER_BUMP_MAP | SHADER_GAMMA));
+    virtual_shaders.push_back(&shader_library.get(SHADER_VIRTUAL | SHADER_NORMAL_MAP | SHADER_GAMMA));
+    virtual_shaders.push_back(&shader_library.get(SHADER_VIRTUAL | SHADER_BUMP_MAP | SHADER_GAMMA));
+    feedback_shader = &shader_library.get(SHADER_VIRTUAL | SHADER_FEEDBACK);
     
-    bgq_opengl::Shader normal_map("normal_map.vert", "normal_map.frag");
-    shaders.push_back(normal_map);
+    // Rebuild the shaders whenever their files change.
+    shader_watcher.start({ "skybox.vert", "skybox.frag", "uber.vert", "uber.frag" });
+    
+    // Create a turntable node for every shader replica, with the model hanging from it.
+    for (int i = 1; i < shaders.size(); i++) {
+        
+        turntable_nodes.push_back(scene_transforms.create());
+        model_nodes.push_back(scene_transforms.create(turntable_nodes.back()));
+        
+    }
+    
+    // Create the ring buffer where the per-draw transforms are streamed every frame.
+    frame_stream = bgq_opengl::StreamBuffer(GL_UNIFORM_BUFFER, 64 * 1024);
     
 	// Creates the first camera object
     bgq_opengl::Camera camera(glm::vec3(0.0f, 0.75f, 3.0f), glm::vec3(0.0f, -0.25f, -1.0f), 45.0f, 0.1f, 300.0f, WINDOW_WIDTH, WINDOW_HEIGHT);
 	cameras.push_back(camera);
     
-    // Load the textures.
-    base_colors.push_back(bgq_opengl::Texture("bricks_color.png", "baseColor", 2));
-    base_colors.push_back(bgq_opengl::Texture("foam_color.png", "baseColor", 2));
-    base_colors.push_back(bgq_opengl::Texture("rock_color.png", "baseColor", 2));
-    base_colors.push_back(bgq_opengl::Texture("tiles_color.png", "baseColor", 2));
-
-    bump_maps.push_back(bgq_opengl::Texture("bricks_bump.png", "bumpMap", 3));
-    bump_maps.push_back(bgq_opengl::Texture("foam_bump.png", "bumpMap", 3));
-    bump_maps.push_back(bgq_opengl::Texture("rock_bump.png", "bumpMap", 3));
-    bump_maps.push_back(bgq_opengl::Texture("tiles_bump.png", "bumpMap", 3));
+    // Load the textures. Every material is a layer of each array, in the same order as in the GUI.
+    // Only their small levels are loaded now, the rest are streamed in as they are needed.
+    texture_streamer.start(TEXTURE_CACHE_DIR, (size_t) TEXTURE_BUDGET_MB * 1024 * 1024);
+    // Each is kept in the smallest format that holds what it uses: sRGB BC7, BC1 or RGBA8 for the colors,
+    // BC4 or R8 for the bumps and BC5 or RG8 for the normals.
+    base_colors = texture_streamer.add(color_images, TEXTURE_USAGE_COLOR, "baseColor", 2);
+    bump_maps = texture_streamer.add(bump_images, TEXTURE_USAGE_BUMP, "bumpMap", 3);
+    normal_maps = texture_streamer.add(normal_images, TEXTURE_USAGE_NORMAL, "normalMap", 4);
+    
+    // The slopes of the bump maps, baked once so the bump mapping takes a single fetch.
+    derivative_maps = texture_streamer.add(bump_images, TEXTURE_USAGE_DERIVATIVE, "derivativeMap", 7, BUMP_KERNEL);
+    
+    // They stay bound for good, the material is picked per instance.
+    base_colors->bind();
+    bump_maps->bind();
+    derivative_maps->bind();
+    normal_maps->bind();
+    
+    // The same bump and normal maps, laid out in a 2x2 grid as one virtual texture.
+    virtual_texture.start({ bump_images, normal_images }, 2, TEXTURE_CACHE_DIR, 5);
+    virtual_texture.bind();
 
-    normal_maps.push_back(bgq_opengl::Texture("bricks_normal.png", "normalMap", 4));
-    normal_maps.push_back(bgq_opengl::Texture("foam_normals.png", "normalMap", 4));
-    normal_maps.push_back(bgq_opengl::Texture("rock_normals.png", "normalMap", 4));
-    normal_maps.push_back(bgq_opengl::Texture("tiles_normals.png", "normalMap", 4));
+    // Create one sampler per filtering preset, shared by every texture.
+    for (int i = 0; i < SAMPLER_PRESETS; i++)
+        samplers.push_back(bgq_opengl::Sampler(i));
+    
+    // Every material starts filtered trilinearly.
+    for (int i = 0; i < base_colors->getLayers(); i++)
+        material_samplers.push_back(SAMPLER_TRILINEAR);
 
     // Load the objects.
-    bgq_opengl::Object torus("torus.glb", "Assimp");
-    torus.setShininess(200.0);
-    objects.push_back(torus);
+    objects.push_back(resource_cache.getObject("torus.glb", "Assimp"));
+    objects.push_back(resource_cache.getObject("sphere.glb", "Assimp"));
+    objects.push_back(resource_cache.getObject("glass.glb", "Assimp"));
+    
+    for (size_t i = 0; i < objects.size(); i++)
+        objects[i]->setShininess(200.0);
     
-    bgq_opengl::Object sphere("sphere.glb", "Assimp");
-    sphere.setShininess(200.0);
-    objects.push_back(sphere);
+    // Recorded frames go to numbered PNG files, encoded on other threads.
+    frame_capture.addConsumer([](bgq_opengl::CapturedFrame frame) {
+        
+        std::ostringstream path;
+        path << CAPTURE_DIR << "/frame_" << std::setw(6) << std::setfill('0') << frame.frame << ".png";
+        
+        bgq_opengl::ImageJob job;
+        job.path = path.str();
+        job.format = IMAGE_FORMAT_PNG;
+        job.width = frame.width;
+        job.height = frame.height;
+        job.pixels = std::move(frame.pixels);
+        
+        capture_writer.write(std::move(job));
+        
+    });
     
-    bgq_opengl::Object glass("glass.glb", "Assimp");
-    glass.setShininess(200.0);
-    objects.push_back(glass);
+    resource_cache.report(std::cerr);
+    texture_streamer.report(std::cerr);
+    virtual_texture.report(std::cerr);
     
 }
 
@@ -334,6 +1190,45 @@ void initEnvironment(int argc, char** argv) {
     }
     glfwMakeContextCurrent(window);
     
+    // With --golden <directory> the golden images are checked instead of running.
+    for (int i = 1; i + 1 < argc; i++)
+        if (std::string(argv[i]) == "--golden")
+            golden_directory = argv[i + 1];
+    
+    // With --turntable <object> <material> <model> <frames> <directory> [png|exr] a turn is saved to files instead.
+    for (int i = 1; i + 5 < argc; i++) {
+        
+        if (std::string(argv[i]) != "--turntable")
+            continue;
+        
+        // The names are the ones of the golden images, like torus bricks normal-map.
+        auto find = [](const std::string &name, const std::function<std::string(int)> &names, int count) {
+            
+            for (int j = 0; j < count; j++)
+                if (names(j) == name)
+                    return j;
+            
+            std::cerr << "Error 121-1003 - Unknown turntable argument " << name << "." << std::endl;
+            exit(1);
+            
+        };
+        
+        turntable_object = find(argv[i + 1], [](int j) { return std::string(object_names[j]); }, (int) (sizeof(object_names) / sizeof(object_names[0])));
+        turntable_texture = find(argv[i + 2], [](int j) { return color_images[j].substr(0, color_images[j].find('_')); }, (int) color_images.size());
+        turntable_model = find(argv[i + 3], [](int j) {
+            
+            std::string name = shading_model_names[j];
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return c == ' ' ? '-' : (char) std::tolower(c); });
+            return name;
+            
+        }, SHADING_MODELS);
+        
+        turntable_frames = std::max(1, atoi(argv[i + 4]));
+        turntable_directory = argv[i + 5];
+        turntable_exr = i + 6 < argc && std::string(argv[i + 6]) == "exr";
+        
+    }
+    
     // Initialize GLEW and OpenGL.
     GLenum res = glewInit();
 
@@ -350,6 +1245,10 @@ void initEnvironment(int argc, char** argv) {
     std::cerr << "OpenGL version supported " << glGetString(GL_VERSION) << std::endl;
     std::cerr << "GLSL version supported " << (char *) glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
     
+    // Let the driver compile shaders on as many threads as it wants.
+    if (GLEW_KHR_parallel_shader_compile)
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    
     // Setup ImGui binding
     ImGui_ImplGlfwGL3_Init(window, true);
 
@@ -364,12 +1263,47 @@ void initEnvironment(int argc, char** argv) {
 }
 
 int main(int argc, char** argv) {
+    
+    // With --software-golden <directory> the golden images are checked on the CPU, without a window or a context.
+    // With --record as well, for either kind, the missing golden images are recorded instead of failing.
+    for (int i = 1; i < argc; i++) {
+        
+        if (std::string(argv[i]) == "--record")
+            golden_record = true;
+        
+        if (std::string(argv[i]) == "--software-golden" && i + 1 < argc)
+            software_golden_directory = argv[i + 1];
+        
+    }
+    
+    if (!software_golden_directory.empty())
+        return checkSoftwareGoldens(software_golden_directory) > 0 ? 1 : 0;
 
 	// Initialise the environment.
     initEnvironment(argc, argv);
     
 	// Initialise the objects and elements.
 	initElements();
+    
+    // Check the golden images and quit, failing if any of them changed.
+    if (!golden_directory.empty()) {
+        
+        int failed = checkGoldenImages(golden_directory);
+        clean();
+        
+        return failed > 0 ? 1 : 0;
+        
+    }
+    
+    // Save a turn to files and quit.
+    if (!turntable_directory.empty()) {
+        
+        renderTurntable();
+        clean();
+        
+        return 0;
+        
+    }
 
 	// Main loop.
     while(!glfwWindowShouldClose(window)) {
@@ -386,8 +1320,100 @@ int main(int argc, char** argv) {
         // Handle key events.
         handleKeyEvents();
         
+        // Pick up any shader that was edited.
+        reloadShaders();
+        
+        // Run the benchmark outside of the frame, if asked for.
+        if (benchmark_requested) {
+            
+            benchmarkSamplers();
+            benchmark_requested = false;
+            
+        }
+        
+        if (baker_benchmark_requested) {
+            
+            bgq_opengl::BumpBaker::benchmark(std::cerr);
+            baker_benchmark_requested = false;
+            
+        }
+        
+        if (transform_benchmark_requested) {
+            
+            bgq_opengl::TransformStore::benchmark(std::cerr);
+            transform_benchmark_requested = false;
+            
+        }
+        
+        if (instance_benchmark_requested) {
+            
+            bgq_opengl::InstanceBatch::benchmark(std::cerr);
+            instance_benchmark_requested = false;
+            
+        }
+        
+        if (bump_comparison_requested) {
+            
+            compareBumps();
+            bump_comparison_requested = false;
+            
+        }
+        
+        if (shading_comparison_requested) {
+            
+            compareShadingModels();
+            shading_comparison_requested = false;
+            
+        }
+        
+        if (software_render_requested) {
+            
+            renderSoftware();
+            software_render_requested = false;
+            
+        }
+        
+        if (software_benchmark_requested) {
+            
+            bgq_opengl::SoftwareRenderer::benchmark(std::cerr);
+            software_benchmark_requested = false;
+            
+        }
+        
+        if (command_replay_requested) {
+            
+            replayCommands();
+            command_replay_requested = false;
+            
+        }
+        
+        if (command_record_requested)
+            command_recorder.begin();
+        
         // Display the scene.
+        frame_stream.beginFrame();
         displayElements();
+        frame_stream.endFrame();
+        
+        if (command_record_requested) {
+            
+            if (command_recorder.end(COMMAND_FILE))
+                std::cerr << "Recorded " << command_recorder.getDraws() << " draws, " << command_recorder.getSize() << " bytes, in " << COMMAND_FILE << std::endl;
+            else
+                std::cerr << "Could not write " << COMMAND_FILE << std::endl;
+            
+            command_record_requested = false;
+            
+        }
+        
+        // Start reading the frame back, it is saved some frames later.
+        if (recording) {
+            
+            int framebuffer_width, framebuffer_height;
+            glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+            frame_capture.capture(0, framebuffer_width, framebuffer_height);
+            
+        }
         
         // Make the things to print everything.
         displayGUI();
@@ -396,6 +1422,10 @@ int main(int argc, char** argv) {
         glfwPollEvents();
         glfwSwapBuffers(window);
         
+        // Delete whatever was released once the GPU is done with the frames that used it.
+        bgq_opengl::DeletionQueue::endFrame();
+        bgq_opengl::DeletionQueue::collect();
+        
     }
 
 	// Clean everything and terminate.
@@ -20,7 +20,22 @@
 #define WINDOW_HEIGHT 800
 #define GAME_NAME "Real-time animation"
 #define NORM_SIZE 1.0
+#define SHADER_CACHE_DIR "shader_cache"
+#define BENCHMARK_SIZE 2048
+#define BENCHMARK_PASSES 50
+#define TEXTURE_CACHE_DIR "texture_cache"
+#define TEXTURE_BUDGET_MB 64
+#define BUMP_KERNEL BUMP_KERNEL_SOBEL
+#define BUMP_METHODS 4
+#define SHADING_MODELS 4
+#define GOLDEN_SIZE 512
+#define GOLDEN_FRAMES 2
+#define STREAM_TIMEOUT 30.0
+#define TURNTABLE_PERIOD 18.0
+#define CAPTURE_DIR "captures"
+#define COMMAND_FILE "frame.commands"
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <ctime>
@@ -28,20 +43,89 @@
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
+#include "classes/bump_baker/bump_baker.h"
+#include "classes/bump_comparison/bump_comparison.h"
 #include "classes/camera/camera.h"
+#include "classes/command_recorder/command_recorder.h"
+#include "classes/fill_rate_benchmark/fill_rate_benchmark.h"
+#include "classes/file_watcher/file_watcher.h"
+#include "classes/frame_capture/frame_capture.h"
+#include "classes/golden_images/golden_images.h"
+#include "classes/image_writer/image_writer.h"
+#include "classes/instance_batch/instance_batch.h"
 #include "classes/object/object.h"
+#include "classes/program_cache/program_cache.h"
+#include "classes/resource_cache/resource_cache.h"
+#include "classes/sampler/sampler.h"
 #include "classes/shader/shader.h"
+#include "classes/shader_library/shader_library.h"
 #include "classes/skybox/skybox.h"
-#include "classes/texture/texture.h"
+#include "classes/software_renderer/software_renderer.h"
+#include "classes/stream_buffer/stream_buffer.h"
+#include "classes/texture_array/texture_array.h"
+#include "classes/texture_streamer/texture_streamer.h"
+#include "classes/transform_store/transform_store.h"
 #include "classes/turbulence/turbulence.h"
+#include "classes/turntable_renderer/turntable_renderer.h"
+#include "classes/virtual_texture/virtual_texture.h"
 
+bgq_opengl::ResourceCache resource_cache;       /// Shared GPU resources, declared first so it outlives every handle.
 std::vector<bgq_opengl::Camera> cameras;	    /// Holds all the existing cameras.
-std::vector<bgq_opengl::Object> objects;	    /// Holds all the displayed objects.
-std::vector<bgq_opengl::Shader> shaders;        /// Holds all the initialized shanders.
+std::vector<std::shared_ptr<bgq_opengl::Object>> objects;	/// Holds all the displayed objects.
+std::vector<bgq_opengl::Shader*> shaders;       /// Holds all the initialized shanders.
+std::shared_ptr<bgq_opengl::Shader> sky_shader; /// Shader of the skybox.
+std::shared_ptr<bgq_opengl::Cubemap> sky_cubemap;	/// Cubemap of the skybox.
+bgq_opengl::ShaderLibrary shader_library;       /// Permutations of the über-shader.
+bgq_opengl::FileWatcher shader_watcher;         /// Watches the shader files for hot reload.
 std::vector<bgq_opengl::Skybox> skyboxes;       /// Holds all the initialized skyboxes.
-std::vector<bgq_opengl::Texture> base_colors;   /// Holds all the initialized skyboxes.
-std::vector<bgq_opengl::Texture> normal_maps;   /// Holds all the initialized skyboxes.
-std::vector<bgq_opengl::Texture> bump_maps;     /// Holds all the initialized skyboxes.
+bgq_opengl::TextureStreamer texture_streamer;   /// Streams the levels of the texture arrays.
+const std::vector<std::string> color_images = { "bricks_color.png", "foam_color.png", "rock_color.png", "tiles_color.png" };      /// Color map of every material.
+const std::vector<std::string> bump_images = { "bricks_bump.png", "foam_bump.png", "rock_bump.png", "tiles_bump.png" };           /// Bump map of every material.
+const std::vector<std::string> normal_images = { "bricks_normal.png", "foam_normals.png", "rock_normals.png", "tiles_normals.png" };  /// Normal map of every material.
+std::shared_ptr<bgq_opengl::TextureArray> base_colors;	/// Color maps of every material.
+std::shared_ptr<bgq_opengl::TextureArray> normal_maps;	/// Normal maps of every material.
+std::shared_ptr<bgq_opengl::TextureArray> bump_maps;	/// Bump maps of every material.
+std::shared_ptr<bgq_opengl::TextureArray> derivative_maps;	/// Slopes of the bump maps of every material, baked from them.
+bgq_opengl::VirtualTexture virtual_texture;     /// Bump and normal maps of every material, paged in as seen.
+std::vector<bgq_opengl::Shader*> virtual_shaders;   /// The shader replicas sampling the virtual texture.
+bgq_opengl::Shader* feedback_shader = nullptr;  /// Writes the virtual texture pages every pixel needs.
+bool virtual_texturing = false;                 /// Whether the bump and normal maps come from the virtual texture.
+std::vector<bgq_opengl::Sampler> samplers;      /// One sampler per filtering preset.
+std::vector<int> material_samplers;             /// Filtering preset of every material.
+bool benchmark_requested = false;               /// Whether to run the filtering benchmark next frame.
+bool baker_benchmark_requested = false;         /// Whether to run the bump baker benchmark next frame.
+bool transform_benchmark_requested = false;     /// Whether to run the transform store benchmark next frame.
+bool instance_benchmark_requested = false;      /// Whether to run the instance batch benchmark next frame.
+bool bump_comparison_requested = false;         /// Whether to compare the bump mapping methods next frame.
+const unsigned int bump_method_features[BUMP_METHODS] = { SHADER_BUMP_FIXED, 0, SHADER_BUMP_SCREEN, SHADER_DERIVATIVE_MAP };  /// Shader features of every bump mapping method.
+const char* bump_method_names[BUMP_METHODS] = { "Fixed taps", "Texel taps", "Screen space", "Derivative map" };          /// Name of every bump mapping method.
+int bump_method = 3;                            /// Bump mapping method of the bump and parallax replicas.
+bool shading_comparison_requested = false;      /// Whether to time the shading models next frame.
+const char* shading_model_names[SHADING_MODELS] = { "Blinn-Phong", "Bump map", "Normal map", "Parallax occlusion" };    /// Name of the shading model of every replica.
+bool parallax_mapping = true;                   /// Whether the parallax occlusion replica is drawn.
+float parallax_scale = 0.04f;                   /// Depth of the bumps of the parallax replica, in UV units.
+int parallax_min_steps = 4;                     /// Fewest steps of the parallax ray.
+int parallax_max_steps = 32;                    /// Most steps of the parallax ray.
+bool software_render_requested = false;         /// Whether to draw the scene with the software renderer next frame.
+std::vector<bgq_opengl::SoftwareMaterial> software_materials;  /// Maps of every material for the software renderer, loaded when first needed.
+bool software_benchmark_requested = false;      /// Whether to run the software shading benchmark next frame.
+std::string golden_directory;                   /// Directory of the golden images to check instead of running, if any.
+std::string software_golden_directory;          /// Directory of the golden images to check on the CPU instead of running, if any.
+bool golden_record = false;                     /// Whether the missing golden images are recorded instead of failing.
+const double golden_times[GOLDEN_FRAMES] = { 0.0, 7.5 };  /// Fixed clock of every golden frame, in seconds.
+const char* object_names[] = { "torus", "sphere", "glass" };  /// Name of every object, in the same order as in the GUI.
+std::string turntable_directory;                /// Directory to save a turn to instead of running, if any.
+int turntable_object = 0;                       /// Object of the saved turn.
+int turntable_texture = 0;                      /// Material of the saved turn.
+int turntable_model = 0;                        /// Shading model of every replica in the saved turn.
+int turntable_frames = 0;                       /// Frames of the saved turn.
+bool turntable_exr = false;                     /// Whether the turn is saved as half float EXR files instead of PNG.
+bool recording = false;                         /// Whether the frames of the window are being saved.
+bgq_opengl::FrameCapture frame_capture;         /// Reads the frames of the window back while recording.
+bgq_opengl::ImageWriter capture_writer;         /// Saves the recorded frames.
+bgq_opengl::CommandRecorder command_recorder;   /// Records the commands of a frame.
+bool command_record_requested = false;          /// Whether to record the commands of the next frame.
+bool command_replay_requested = false;          /// Whether to replay the recorded commands next frame.
 int current_camera = 0;                         /// Current camera activated.
 int current_scene = 0;
 int current_object = 0;
@@ -52,6 +136,12 @@ GLFWwindow *window = 0;						    /// Window ID.
 double internal_time = 0;					    /// Time that will rule everything in the game.
 double time_start = 0;						    /// Time that will count as the beginning.
 bgq_opengl::Light scene_light;                  /// The light in the scene.
+bgq_opengl::ProgramCache program_cache;         /// Linked shader binaries kept on disk.
+bgq_opengl::StreamBuffer frame_stream;          /// Ring buffer for the per-frame transforms.
+bgq_opengl::TransformStore scene_transforms;    /// Transforms of the scene graph.
+std::vector<int> turntable_nodes;               /// Rotating root node of every shader replica.
+std::vector<int> model_nodes;                   /// Model node hanging from every turntable.
+bgq_opengl::InstanceBatch frame_instances;      /// Matrices of everything drawn this frame.
 
 const glm::vec4 background(82 / 255.0, 103 / 255.0, 125 / 255.0, 1.0);	/// This is just the fog color.
 
@@ -76,6 +166,31 @@ void clear();
  */
 void displayElements();
 
+/**
+ * @brief Place the replicas.
+ *
+ * Spins the turntables to a time and computes the matrices of every replica
+ * for the frame, spread by the number of replicas on screen.
+ *
+ * @param time The time in seconds.
+ * @param view The view of the camera.
+ */
+void poseReplicas(double time, const glm::mat4 &view);
+
+/**
+ * @brief Place the replicas.
+ *
+ * Spins the turntables to a time and computes the matrices of every replica
+ * for the frame, for an object with the given bounds. The replicas on screen
+ * are spread evenly around the turntable.
+ *
+ * @param time The time in seconds.
+ * @param view The view of the camera.
+ * @param bb The bounding box of the object.
+ * @param replicas The number of replicas on screen.
+ */
+void poseReplicas(double time, const glm::mat4 &view, const bgq_opengl::BoundingBox &bb, int replicas);
+
 /**
  * @brief Display the GUI.
  *
@@ -90,6 +205,168 @@ void displayGUI();
  */
 void handleKeyEvents(unsigned char key, int x, int y);
 
+/**
+ * @brief Pass the parameters to a replica shader.
+ *
+ * Activates a shader of the replicas and passes it the light, the material
+ * parameters and the textures.
+ *
+ * @param shader The shader.
+ */
+void passParameters(bgq_opengl::Shader* shader);
+
+/**
+ * @brief Draw the replicas with one shader.
+ *
+ * Draws every replica on screen with the same shader, in a frame of its own
+ * of the stream buffer.
+ *
+ * @param shader The shader.
+ * @param camera The camera used to draw.
+ */
+void drawReplicas(bgq_opengl::Shader* shader, bgq_opengl::Camera &camera);
+
+/**
+ * @brief Draw the replicas with a shader each.
+ *
+ * Draws the first replicas, each with its own shader, in a frame of its own
+ * of the stream buffer.
+ *
+ * @param replica_shaders The shader of every replica to draw, in order.
+ * @param camera The camera used to draw.
+ */
+void drawReplicas(const std::vector<bgq_opengl::Shader*> &replica_shaders, bgq_opengl::Camera &camera);
+
+/**
+ * @brief Benchmark the filtering presets.
+ *
+ * Measures the fill rate of every sampler preset offscreen on the current bump
+ * map and prints the results.
+ */
+void benchmarkSamplers();
+
+/**
+ * @brief Compare the bump mapping methods.
+ *
+ * Draws the scene offscreen with every bump mapping method and prints how long
+ * each takes and how close it is to the texel taps drawn at twice the size.
+ */
+void compareBumps();
+
+/**
+ * @brief Time the shading models.
+ *
+ * Draws the scene offscreen with the shader of every replica, and the parallax
+ * occlusion with a fixed number of steps too, and prints how long each takes.
+ */
+void compareShadingModels();
+
+/**
+ * @brief Load the maps of the software renderer.
+ *
+ * Loads the color, bump and normal maps of every material for the software
+ * renderer the first time they are needed.
+ */
+void loadSoftwareMaterials();
+
+/**
+ * @brief Draw the scene on the CPU.
+ *
+ * Draws the replicas with the software renderer, then on the GPU offscreen
+ * with the same shading, and prints how long each took and how close they
+ * are. The parallax replica is left out, the CPU has no parallax.
+ */
+void renderSoftware();
+
+/**
+ * @brief Check the golden images on the CPU.
+ *
+ * Loads the objects and maps without any OpenGL context, draws the same
+ * images as checkGoldenImages with the software renderer and checks them
+ * against the golden ones in a directory of their own. The missing ones fail,
+ * or are recorded with --record.
+ *
+ * @param directory Directory of the software golden images.
+ *
+ * @returns The number of images that failed.
+ */
+int checkSoftwareGoldens(const std::string &directory);
+
+/**
+ * @brief Get the name of a golden image.
+ *
+ * Names an image after what is drawn in it, like torus_bricks_normal-map_0.
+ *
+ * @param object The object.
+ * @param texture The material.
+ * @param model The shading model of every replica.
+ * @param frame The golden frame.
+ *
+ * @returns The name, without extension.
+ */
+std::string goldenName(int object, int texture, int model, int frame);
+
+/**
+ * @brief Report a golden image.
+ *
+ * Prints how an image compared to its golden one and counts it.
+ *
+ * @param name The name of the image.
+ * @param result The result of the check.
+ * @param passed Counts the images that passed.
+ * @param failed Counts the images that failed.
+ * @param recorded Counts the images that were recorded.
+ */
+void reportGolden(const std::string &name, const bgq_opengl::GoldenResult &result, int *passed, int *failed, int *recorded);
+
+/**
+ * @brief Check the golden images.
+ *
+ * Draws every object with every material and shading model offscreen, at some
+ * fixed times and from the starting camera, and checks the images against the
+ * golden ones. The missing ones fail, or are recorded with --record.
+ *
+ * @param directory Directory of the golden images.
+ *
+ * @returns The number of images that failed.
+ */
+int checkGoldenImages(const std::string &directory);
+
+/**
+ * @brief Stream in the finest levels.
+ *
+ * Lifts the streaming budget and waits until the finest level of every texture
+ * array is resident, or until STREAM_TIMEOUT seconds go by. The caller puts
+ * the budget back.
+ */
+void streamFinestLevels();
+
+/**
+ * @brief Save a turn to files.
+ *
+ * Draws a whole turn of the turntables offscreen, every replica with the same
+ * shading model, and saves every frame to a numbered PNG or EXR file. The
+ * frames are read back through a ring of pixel buffers and encoded on other
+ * threads, so drawing, reading back and encoding overlap.
+ */
+void renderTurntable();
+
+/**
+ * @brief Replay the recorded commands.
+ *
+ * Issues the commands of the recorded frame offscreen over and over, and
+ * prints how long issuing them takes and how long the GPU takes to run them.
+ */
+void replayCommands();
+
+/**
+ * @brief Reload the shaders that changed.
+ *
+ * Picks up the shader files that changed on disk and rebuilds the programs
+ * that use them.
+ */
+void reloadShaders();
+
 /**
  * @brief Init the elements of the program
  *
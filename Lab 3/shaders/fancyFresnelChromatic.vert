@@ -7,11 +7,15 @@ layout (location = 1) in vec3 inNormal;	// Normal (not necessarily normalized).
 layout (location = 2) in vec3 inColor;	// Color (not necessarily normalized).
 layout (location = 3) in vec2 inUV;		// UV coordinates.
 
-uniform mat4 Model;			// Imports the model matrix.
 uniform mat4 View;			// Imports the View matrix.
 uniform mat4 Projection;	// Imports the projection matrix.
-uniform mat4 modelView;		// Imports the modelView already multiplied.
-uniform mat4 normalMatrix;	// Imports the normal matrix.
+
+layout (std140) uniform Transforms {   // Per-draw matrices, written to the stream buffer.
+    mat4 Model;			// Imports the model matrix.
+    mat4 modelView;		// Imports the modelView already multiplied.
+    mat4 normalMatrix;	// Imports the normal matrix.
+};
+
 uniform vec3 lightPos;		// Light position.
 uniform float time;			// Time in seconds.
 uniform vec3 cameraPosition;        // Position of the camera.
@@ -0,0 +1,25 @@
+#version 330 core
+
+in vec2 screenPosition;     // Position on screen from the VS.
+
+uniform sampler2DArray image;   // The textures being measured.
+uniform float layer;            // The layer being measured.
+
+const float definition = 1.0 / 1024.0;
+
+out vec4 outColor; // Outputs color in RGBA.
+
+void main() {
+
+    // Map the screen onto a floor that recedes into the distance, so pixels cover
+    // stretched footprints of the texture like on a surface seen at a grazing angle.
+    float depth = 1.0 / (1.05 - 0.5 * (screenPosition.y + 1.0));
+    vec2 uv = vec2(screenPosition.x * depth, depth) * 4.0;
+
+    // The same four taps the bump mapping does.
+    float xGradient = texture(image, vec3(uv.x - definition, uv.y, layer)).r - texture(image, vec3(uv.x + definition, uv.y, layer)).r;
+    float yGradient = texture(image, vec3(uv.x, uv.y - definition, layer)).r - texture(image, vec3(uv.x, uv.y + definition, layer)).r;
+
+    outColor = vec4(xGradient, yGradient, 1.0, 1.0);
+
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+out vec2 screenPosition;    // Passes the position on screen to the fragment shader.
+
+void main() {
+
+    // A single triangle that covers the whole screen, built from the vertex index.
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+
+    screenPosition = position;
+    gl_Position = vec4(position, 0.0, 1.0);
+
+}
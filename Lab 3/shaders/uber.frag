@@ -0,0 +1,413 @@
+#version 330 core
+
+// Feature switches, prepended by the ShaderLibrary:
+//     NORMAL_MAP      Take the normal from the normal map.
+//     BUMP_MAP        Derive the normal from the gradient of the bump map.
+//     FRESNEL         Mix in the reflection and refraction of the skybox.
+//     GAMMA           Gamma correct the output.
+//     VIRTUAL_TEXTURE Sample the bump and normal maps through the virtual texture.
+//     FEEDBACK        Output the virtual texture page every pixel needs instead of a color.
+//     DERIVATIVE_MAP  Take the slopes of the bump map from its baked derivative map.
+//     BUMP_SCREEN     Take the slopes of the bump map from screen space derivatives of one fetch.
+//     BUMP_FIXED      Take the slopes of the bump map from four taps a fixed BUMP_DEFINITION apart.
+//     PARALLAX        March the view ray through the bump map and shade where it hits. Needs BUMP_MAP.
+//     NUM_LIGHTS      Number of point lights.
+// The material constants below can be overridden the same way.
+
+#ifndef NUM_LIGHTS
+#define NUM_LIGHTS 1
+#endif
+
+#ifndef SHININESS
+#define SHININESS 10.0
+#endif
+
+#ifndef LIGHT_POWER
+#define LIGHT_POWER 10.0
+#endif
+
+#ifndef MIN_AMBIENT_LIGHT
+#define MIN_AMBIENT_LIGHT 0.25
+#endif
+
+#ifndef SCREEN_GAMMA
+#define SCREEN_GAMMA 2.2
+#endif
+
+// Texel size the bump strength is calibrated to, and the tap offset of BUMP_FIXED.
+#ifndef BUMP_DEFINITION
+#define BUMP_DEFINITION (1.0 / 1024.0)
+#endif
+
+#ifndef DERIVATIVE_RANGE
+#define DERIVATIVE_RANGE 0.5
+#endif
+
+// The feedback only makes sense for the virtual texture.
+#if defined(FEEDBACK) && !defined(VIRTUAL_TEXTURE)
+#define VIRTUAL_TEXTURE
+#endif
+
+#ifndef VIRTUAL_BUMP_LAYER
+#define VIRTUAL_BUMP_LAYER 0.0
+#endif
+
+#ifndef VIRTUAL_NORMAL_LAYER
+#define VIRTUAL_NORMAL_LAYER 1.0
+#endif
+
+in vec3 vertexPosition;     // Position from the VS.
+in vec3 vertexNormal;       // Normal from the VS.
+in vec3 vertexColor;        // Color from the VS.
+in vec2 vertexUV;           // UV coordinates from the VS.
+flat in int vertexMaterial; // Material layer from the VS.
+
+#if defined(NORMAL_MAP) || defined(BUMP_MAP)
+in vec3 vertexTangent;      // Tangent from the VS.
+in vec3 vertexBitangent;    // Bitangent from the VS.
+#endif
+
+#ifdef FRESNEL
+in vec3 Reflect;            // The reflect color.
+in vec3 RefractR;           // The refraction of the red channel.
+in vec3 RefractG;           // The refraction of the green channel.
+in vec3 RefractB;           // The refraction of the blue channel.
+in float Ratio;             // The reflection refraction ratio.
+#endif
+
+uniform vec4 lightColor[NUM_LIGHTS];    // Light colors.
+uniform vec3 lightPos[NUM_LIGHTS];      // Light positions.
+uniform float materialShininess;        // Extra shininess.
+uniform sampler2DArray baseColor;       // The color textures, one layer per material.
+uniform float coordMult;                // UV multiplier.
+
+#ifdef NORMAL_MAP
+uniform sampler2DArray normalMap;       // The normal textures, one layer per material.
+#endif
+
+#ifdef BUMP_MAP
+uniform sampler2DArray bumpMap;         // The bump textures, one layer per material.
+uniform float bumpMult;                 // Strength of the bumps.
+#endif
+
+#ifdef PARALLAX
+uniform float parallaxScale;            // Depth of the bumps, in UV units.
+uniform int parallaxMinSteps;           // Fewest steps the view ray takes.
+uniform int parallaxMaxSteps;           // Most steps the view ray takes.
+#endif
+
+#ifdef DERIVATIVE_MAP
+uniform sampler2DArray derivativeMap;   // The slopes of the bump textures, one layer per material.
+#endif
+
+#ifdef FRESNEL
+uniform samplerCube skybox;             // The skybox.
+uniform float mixColor;                 // The color/fresnel ratio.
+#endif
+
+#ifdef VIRTUAL_TEXTURE
+uniform sampler2DArray virtualAtlas;    // The resident pages, one layer per virtual layer.
+uniform usampler2D virtualPages;        // The page table: atlas slot and level of every page.
+uniform float virtualSize;              // Pixels along each side of the virtual texture.
+uniform vec2 virtualGrid;               // Columns and rows of the grid of materials in the virtual texture.
+uniform float virtualPageSize;          // Pixels along each side of a page, without the border.
+uniform float virtualBorder;            // Pixels added to every side of a page.
+uniform float virtualAtlasSize;         // Pixels along each side of the atlas.
+uniform int virtualLevels;              // Levels of the page table.
+uniform float virtualBias;              // Levels added to the one every pixel asks for.
+
+// Get where the UVs of a material fall in the virtual texture. Every material has its own cell of
+// the grid, and the UVs wrap around inside it.
+vec2 virtualUV(vec2 uv, int material) {
+
+    vec2 cell = vec2(float(material % int(virtualGrid.x)), float(material / int(virtualGrid.x)));
+
+    return (fract(uv) + cell) / virtualGrid;
+
+}
+
+// Get the level a pixel needs, from how fast the UVs change across it. Taken before the wrap, so
+// the pixels on the seam do not ask for the coarsest level.
+int virtualLevel(vec2 uv) {
+
+    vec2 dx = dFdx(uv * virtualSize / virtualGrid);
+    vec2 dy = dFdy(uv * virtualSize / virtualGrid);
+    float lod = 0.5 * log2(max(dot(dx, dx), dot(dy, dy))) + virtualBias;
+
+    return clamp(int(floor(lod)), 0, virtualLevels - 1);
+
+}
+
+// Get the page of a level some virtual UVs fall in.
+ivec2 virtualPage(vec2 virtualCoords, int level) {
+
+    float pages = virtualSize / virtualPageSize / exp2(float(level));
+
+    return ivec2(min(virtualCoords * pages, vec2(pages - 1.0)));
+
+}
+
+// Get where some virtual UVs are in the atlas, in the page asked for or the coarser one standing in for it.
+vec2 virtualAtlasUV(vec2 virtualCoords, int level) {
+
+    uvec4 entry = texelFetch(virtualPages, virtualPage(virtualCoords, level), level);
+    vec2 texel = virtualCoords * virtualSize / exp2(float(entry.b));
+    vec2 inside = mod(texel, virtualPageSize);
+
+    return (vec2(entry.rg) * (virtualPageSize + 2.0 * virtualBorder) + virtualBorder + inside) / virtualAtlasSize;
+
+}
+#endif
+
+#ifdef FEEDBACK
+out uvec4 outColor; // Outputs the page asked for, and 255 in alpha so it is not empty.
+#else
+out vec4 outColor; // Outputs color in RGBA.
+#endif
+
+#ifdef NORMAL_MAP
+// Get a tangent space normal from the red and green of a normal map. The blue may not be
+// stored at all, as in BC5, so it is rebuilt from the other two.
+vec3 decodeNormal(vec2 rg) {
+
+    vec2 xy = rg * 2.0 - 1.0;
+
+    return vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0)));
+
+}
+#endif
+
+#if defined(BUMP_MAP) && !defined(VIRTUAL_TEXTURE)
+// Get how fast the height grows along U and V, in height per UV unit.
+vec2 bumpGradient(vec2 uv, float layer) {
+
+#if defined(DERIVATIVE_MAP)
+    // One fetch. The slopes are stored square rooted, and per texel of the finest level.
+    vec2 encoded = texture(derivativeMap, vec3(uv, layer)).rg * 2.0 - 1.0;
+
+    return sign(encoded) * encoded * encoded * DERIVATIVE_RANGE * vec2(textureSize(derivativeMap, 0).xy);
+#elif defined(BUMP_SCREEN)
+    // One fetch, differentiated across the pixel quad and taken back from screen to UV
+    // space with the chain rule, the way Mikkelsen's surface gradients do.
+    float height = texture(bumpMap, vec3(uv, layer)).r;
+    vec2 heightDerivatives = vec2(dFdx(height), dFdy(height));
+    vec2 uvX = dFdx(uv);
+    vec2 uvY = dFdy(uv);
+    float determinant = uvX.x * uvY.y - uvX.y * uvY.x;
+
+    // UVs that do not change across the quad have no gradient to give.
+    if (abs(determinant) < 1e-12)
+        return vec2(0.0);
+
+    return vec2(uvY.y * heightDerivatives.x - uvX.y * heightDerivatives.y, uvX.x * heightDerivatives.y - uvY.x * heightDerivatives.x) / determinant;
+#else
+#if defined(BUMP_FIXED)
+    // The same offset whatever the texture and the distance.
+    vec2 offset = vec2(BUMP_DEFINITION);
+#else
+    // One texel of the level being sampled, so far away surfaces do not tap finer than they are filtered.
+    vec2 size = vec2(textureSize(bumpMap, 0).xy);
+    vec2 texelsX = dFdx(uv * size);
+    vec2 texelsY = dFdy(uv * size);
+    float lod = clamp(0.5 * log2(max(dot(texelsX, texelsX), dot(texelsY, texelsY))), 0.0, log2(max(size.x, size.y)));
+    vec2 offset = exp2(lod) / size;
+#endif
+
+    float xDifference = texture(bumpMap, vec3(uv.x + offset.x, uv.y, layer)).r - texture(bumpMap, vec3(uv.x - offset.x, uv.y, layer)).r;
+    float yDifference = texture(bumpMap, vec3(uv.x, uv.y + offset.y, layer)).r - texture(bumpMap, vec3(uv.x, uv.y - offset.y, layer)).r;
+
+    return vec2(xDifference, yDifference) / (2.0 * offset);
+#endif
+
+}
+#endif
+
+#if defined(PARALLAX) && !defined(VIRTUAL_TEXTURE)
+// March the view ray from the top of the bumps down into them, and get the UVs where it first
+// goes under the surface. It takes about one step per texel it crosses in the level being
+// sampled, so grazing rays take more and far away surfaces fewer.
+vec2 parallaxUV(vec2 uv, float layer, vec3 viewTangent) {
+
+    // Derivatives have to be taken before the loop, which does not run the same for every pixel.
+    vec2 uvX = dFdx(uv);
+    vec2 uvY = dFdy(uv);
+    vec2 size = vec2(textureSize(bumpMap, 0).xy);
+    vec2 texelsX = uvX * size;
+    vec2 texelsY = uvY * size;
+    float lod = max(0.5 * log2(max(dot(texelsX, texelsX), dot(texelsY, texelsY))), 0.0);
+
+    // How far the UVs move from the top of the bumps to the bottom, kept finite at grazing angles.
+    vec2 shift = viewTangent.xy / max(viewTangent.z, 0.1) * parallaxScale;
+    float texels = length(shift * size) / exp2(lod);
+
+    // Less than half a texel would not show.
+    if (texels < 0.5)
+        return uv;
+
+    int steps = int(clamp(ceil(texels), float(parallaxMinSteps), float(parallaxMaxSteps)));
+    float stepDepth = 1.0 / float(steps);
+    vec2 stepShift = shift * stepDepth;
+
+    vec2 currentUV = uv;
+    float rayDepth = 0.0;
+    float surfaceDepth = 1.0 - textureGrad(bumpMap, vec3(currentUV, layer), uvX, uvY).r;
+    float previousSurfaceDepth = surfaceDepth;
+
+    // Stop as soon as the ray is under the surface.
+    for (int i = 0; i < steps && rayDepth < surfaceDepth; i++) {
+
+        previousSurfaceDepth = surfaceDepth;
+        currentUV -= stepShift;
+        rayDepth += stepDepth;
+        surfaceDepth = 1.0 - textureGrad(bumpMap, vec3(currentUV, layer), uvX, uvY).r;
+
+    }
+
+    // The surface is taken as a straight line between the last two steps, to find where the ray crosses it.
+    float after = surfaceDepth - rayDepth;
+    float before = previousSurfaceDepth - rayDepth + stepDepth;
+    float weight = after / min(after - before, -1e-6);
+
+    return mix(currentUV, currentUV + stepShift, weight);
+
+}
+#endif
+
+void main() {
+    
+    // Multiply UV coords.
+    vec2 uv = vertexUV * coordMult;
+    float layer = float(vertexMaterial);
+
+#ifdef VIRTUAL_TEXTURE
+    // Derivatives have to be taken before anything branches.
+    int virtualLevelNeeded = virtualLevel(uv);
+    vec2 virtualCoords = virtualUV(uv, vertexMaterial);
+#endif
+
+#ifdef FEEDBACK
+    // Ask for the page and stop there.
+    outColor = uvec4(uvec2(virtualPage(virtualCoords, virtualLevelNeeded)), uint(virtualLevelNeeded), 255u);
+    return;
+#endif
+
+    // Get the normal ready to use.
+    vec3 normal = normalize(vertexNormal);
+
+#if defined(NORMAL_MAP) || defined(BUMP_MAP)
+    vec3 tangent = normalize(vertexTangent);
+    vec3 bitangent = normalize(vertexBitangent);
+    
+    // Get the matrix to convert stuff to tangent space.
+    mat3 toTangentSpace = mat3(tangent, bitangent, normal);
+#endif
+
+#if defined(PARALLAX) && !defined(VIRTUAL_TEXTURE)
+    // Move the UVs to where the view ray meets the bumps, before anything is sampled with them.
+    uv = parallaxUV(uv, layer, normalize(transpose(toTangentSpace) * normalize(-vertexPosition)));
+#endif
+
+#if defined(NORMAL_MAP) && defined(VIRTUAL_TEXTURE)
+    // Get the normal from the page of the virtual texture.
+    vec4 mappedNormal = textureLod(virtualAtlas, vec3(virtualAtlasUV(virtualCoords, virtualLevelNeeded), VIRTUAL_NORMAL_LAYER), 0.0);
+    
+    // Transform it.
+    normal = normalize(toTangentSpace * decodeNormal(mappedNormal.rg));
+#elif defined(NORMAL_MAP)
+    // Get the normal from the normal map.
+    vec4 mappedNormal = texture(normalMap, vec3(uv, layer));
+    
+    // Transform it.
+    normal = normalize(toTangentSpace * decodeNormal(mappedNormal.rg));
+#elif defined(BUMP_MAP) && defined(VIRTUAL_TEXTURE)
+    // Compute the new normal from the neighbouring texels of the page, which the border keeps inside it.
+    vec2 atlasUV = virtualAtlasUV(virtualCoords, virtualLevelNeeded);
+    float atlasTexel = 1.0 / virtualAtlasSize;
+    float xGradient = textureLod(virtualAtlas, vec3(atlasUV.x - atlasTexel, atlasUV.y, VIRTUAL_BUMP_LAYER), 0.0).r - textureLod(virtualAtlas, vec3(atlasUV.x + atlasTexel, atlasUV.y, VIRTUAL_BUMP_LAYER), 0.0).r;
+    float yGradient = textureLod(virtualAtlas, vec3(atlasUV.x, atlasUV.y - atlasTexel, VIRTUAL_BUMP_LAYER), 0.0).r - textureLod(virtualAtlas, vec3(atlasUV.x, atlasUV.y + atlasTexel, VIRTUAL_BUMP_LAYER), 0.0).r;
+    
+    // Get the new normals.
+    vec3 newNormal = normalize(vec3(0.0, 0.0, 1.0) + (vec3(1.0, 0.0, 0.0) * xGradient * bumpMult) + (vec3(0.0, 1.0, 0.0) * yGradient * bumpMult));
+    
+    // Transform it.
+    normal = normalize(toTangentSpace * newNormal);
+#elif defined(BUMP_MAP)
+    // Bumps as tall as they would be on a 1024 pixel texture, whatever the size and level sampled.
+    vec2 heightGradient = bumpGradient(uv, layer) * 2.0 * BUMP_DEFINITION;
+    
+    // Get the new normals.
+    vec3 newNormal = normalize(vec3(0.0, 0.0, 1.0) - (vec3(heightGradient, 0.0) * bumpMult));
+    
+    // Transform it.
+    normal = normalize(toTangentSpace * newNormal);
+#endif
+
+    // Get the base color from the texture. It is stored as sRGB, so it comes back linear.
+    vec3 surfaceColor = vec3(texture(baseColor, vec3(uv, layer)));
+
+#ifdef FRESNEL
+    // Get the colors for the refraction from the skybox.
+    vec3 refractColor;
+    refractColor.r = texture(skybox, RefractR).r;
+    refractColor.g = texture(skybox, RefractG).g;
+    refractColor.b = texture(skybox, RefractB).b;
+    
+    // Get the final fresnel color after mixing both reflection and refraction.
+    vec3 fresnelColor = mix(refractColor, vec3(texture(skybox, Reflect)), Ratio);
+
+    // Join the texture and the fresnel.
+    surfaceColor = mix(surfaceColor, fresnelColor, mixColor);
+#endif
+
+    // Get the shininess that would go in this fragment.
+    float fragmentShininess = SHININESS * materialShininess;
+
+    // Get the direction from the position to the camera as a vector.
+    vec3 viewDir = normalize(-vertexPosition);
+
+    // Get the minimum color.
+    vec3 fragmentColor = surfaceColor * MIN_AMBIENT_LIGHT;
+
+    for (int i = 0; i < NUM_LIGHTS; i++) {
+
+        // Get the light direction.
+        vec3 lightDir = lightPos[i] - vertexPosition;
+
+        // Get the distance from the light to this fragment.
+        float dist = length(lightDir);
+        dist = dist * dist;
+        
+        // Normalize the light direction as a vector.
+        lightDir = normalize(lightDir);
+
+        // Get the lambertian component as stated in the docs.
+        float lambertian = max(dot(lightDir, normal), 0.0);
+
+        // init the specular.
+        float specular = 0.0;
+
+        if (lambertian > 0.0) {
+
+            // Blinn-phong calculations.
+            vec3 halfAngle = normalize(lightDir + viewDir);
+            float specAngle = max(dot(halfAngle, normal), 0.0);
+            specular = pow(specAngle, fragmentShininess);
+           
+        }
+
+        // Add the diffuse and specular colors.
+        fragmentColor += surfaceColor * (lambertian + specular) * vec3(lightColor[i]) * LIGHT_POWER / dist;
+
+    }
+
+#ifdef GAMMA
+    // Apply gamma correction.
+    fragmentColor = pow(fragmentColor, vec3(1.0 / SCREEN_GAMMA));
+#endif
+
+#ifndef FEEDBACK
+    // Final color.
+    outColor = vec4(fragmentColor, 1.0);
+#endif
+    
+}
@@ -0,0 +1,83 @@
+#version 330 core
+
+// Feature switches, prepended by the ShaderLibrary:
+//     NORMAL_MAP, BUMP_MAP    Perturb the normal in tangent space.
+//     FRESNEL                 Mix in the reflection and refraction of the skybox.
+
+layout (location = 0) in vec3 inVertex;    // Vertex.
+layout (location = 1) in vec3 inNormal;    // Normal (not necessarily normalized).
+layout (location = 2) in vec3 inColor;    // Color (not necessarily normalized).
+layout (location = 3) in vec2 inUV;        // UV coordinates.
+layout (location = 4) in vec3 inTangents;   // Tangents.
+layout (location = 5) in vec3 inBitangents; // Bitangents.
+
+uniform mat4 Projection;    // Imports the projection matrix.
+
+layout (std140) uniform Transforms {   // Per-draw matrices, written to the stream buffer.
+    mat4 Model;            // Imports the model matrix.
+    mat4 modelView;        // Imports the modelView already multiplied.
+    mat4 normalMatrix;    // Imports the normal matrix.
+    int materialLayer;    // Layer of the material in the texture arrays.
+};
+
+#ifdef FRESNEL
+uniform float etaR;            // Fresnel red ratio.
+uniform float etaG;            // Fresnel green ratio.
+uniform float etaB;            // Fresnel blue ratio.
+uniform float fresnelPower;    // The fresnel interpolation step.
+#endif
+
+out vec3 vertexNormal;        // Passes the normal to the fragment shader.
+out vec3 vertexColor;        // Passes the color to the fragment shader.
+out vec2 vertexUV;            // Passes the UV coordinates to the fragment shader.
+out vec3 vertexPosition;    // Passes the current vertex to the fragment shader.
+flat out int vertexMaterial; // Passes the material layer to the fragment shader.
+
+#if defined(NORMAL_MAP) || defined(BUMP_MAP)
+out vec3 vertexTangent;     // Passes the tangent to the fragment shader.
+out vec3 vertexBitangent;   // Passes the bitangent to the fragment shader.
+#endif
+
+#ifdef FRESNEL
+out vec3 Reflect;           // Passes the reflection texture coordinates to the fragment shader.
+out vec3 RefractR;          // Passes the red refraction texture coordinates to the fragment shader.
+out vec3 RefractG;          // Passes the green refraction texture coordinates to the fragment shader.
+out vec3 RefractB;          // Passes the blue refraction texture coordinates to the fragment shader.
+out float Ratio;            // Passes the fresnel ratio to the fragment shader.
+#endif
+
+void main() {
+
+    // Assigns the direct passes.
+    vertexNormal = vec3(normalMatrix * vec4(inNormal, 0.0));
+    vertexColor = inColor;
+    vertexUV = mat2(0.0, -1.0, 1.0, 0.0) * inUV;
+    vertexPosition = vec3(modelView * vec4(inVertex, 1.0));
+    vertexMaterial = materialLayer;
+
+#if defined(NORMAL_MAP) || defined(BUMP_MAP)
+    vertexTangent = vec3(normalMatrix * vec4(inTangents, 0.0));
+    vertexBitangent = vec3(normalMatrix * vec4(inBitangents, 0.0));
+#endif
+
+#ifdef FRESNEL
+    // Get the F component of the fresnel.
+    float F = ((1.0 - etaG) * (1.0 - etaG)) / ((1.0 + etaG) * (1.0 + etaG));
+
+    // Get the other components of the fresnel.
+    vec3 i = normalize(vertexPosition);
+    vec3 n = normalize(vertexNormal);
+
+    // Compute the fresnel equation.
+    Ratio = F + (1.0 - F) * pow((1.0 - dot(-i, n)), fresnelPower);
+
+    RefractR = refract(i, n, etaR);
+    RefractG = refract(i, n, etaG);
+    RefractB = refract(i, n, etaB);
+    Reflect = reflect(i, n);
+#endif
+
+    // Sets the visualized position by applying the camera matrix.
+    gl_Position = Projection * vec4(vertexPosition, 1.0);
+    
+}
@@ -0,0 +1,40 @@
+/**
+ * @file captured_frame.h
+ * @brief CapturedFrame struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_CAPTURED_FRAME_H_
+#define BGQ_OPENGL_STRUCT_CAPTURED_FRAME_H_
+
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A captured frame struct.
+	 *
+	 * This Struct represents a frame read back from a framebuffer.
+	 */
+	struct CapturedFrame {
+
+		long frame = 0;						// Number of the capture, counting from 0.
+		int width = 0;						// Width in pixels.
+		int height = 0;						// Height in pixels.
+		bool half = false;					// Whether the pixels are RGBA16F instead of RGBA8.
+		std::vector<unsigned char> pixels;	// The pixels, bottom row first.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_CAPTURED_FRAME_H_
@@ -0,0 +1,39 @@
+/**
+ * @file golden_result.h
+ * @brief GoldenResult struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_GOLDEN_RESULT_H_
+#define BGQ_OPENGL_STRUCT_GOLDEN_RESULT_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A golden result struct.
+	 *
+	 * This Struct represents how an image compares to its golden image.
+	 */
+	struct GoldenResult {
+
+		bool recorded = false;			// Whether there was no golden image and the image became it.
+		bool missing = false;			// Whether there was no golden image to compare with, which fails.
+		bool passed = true;				// Whether the image is within the tolerances.
+		int largest_difference = 0;		// Largest difference of a channel, out of 255.
+		double different_pixels = 0.0;	// Fraction of the pixels with a channel further off than the tolerance.
+		double ssim = 1.0;				// Mean structural similarity of the luma.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_GOLDEN_RESULT_H_
@@ -0,0 +1,41 @@
+/**
+ * @file image_job.h
+ * @brief ImageJob struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_IMAGE_JOB_H_
+#define BGQ_OPENGL_STRUCT_IMAGE_JOB_H_
+
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief An image job struct.
+	 *
+	 * This Struct represents an image waiting to be encoded and written.
+	 */
+	struct ImageJob {
+
+		std::string path;					// File to write.
+		int format = 0;						// One of the IMAGE_FORMAT_ values.
+		int width = 0;						// Width in pixels.
+		int height = 0;						// Height in pixels.
+		std::vector<unsigned char> pixels;	// RGBA8 or RGBA16F as the format wants, bottom row first.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_IMAGE_JOB_H_
@@ -0,0 +1,41 @@
+/**
+ * @file instance_data.h
+ * @brief InstanceData struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_INSTANCEDATA_H_
+#define BGQ_OPENGL_STRUCT_INSTANCEDATA_H_
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The per-instance data.
+	 *
+	 * This Struct holds the matrices and material of a drawn instance. Its layout matches the
+	 * std140 Transforms uniform block of the shaders.
+	 */
+	struct InstanceData {
+
+		glm::mat4 model;			/// Model matrix.
+		glm::mat4 model_view;		/// Model matrix already multiplied by the view.
+		glm::mat4 normal_matrix;	/// Inverse transpose of the model view.
+		int material = 0;			/// Layer of the material in the texture arrays.
+		int padding[3] = {};		/// Keeps the size a multiple of 16 bytes, as std140 wants.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_INSTANCEDATA_H_
@@ -0,0 +1,479 @@
+/**
+ * @file lanes.h
+ * @brief Lanes struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_LANES_H_
+#define BGQ_OPENGL_STRUCT_LANES_H_
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define LANES_WIDTH 8		/// Floats per register with AVX.
+#define LANES_NAME "AVX"	/// Name of the instruction set.
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define LANES_WIDTH 4		/// Floats per register with SSE2.
+#define LANES_NAME "SSE2"	/// Name of the instruction set.
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LANES_WIDTH 4		/// Floats per register with NEON.
+#define LANES_NAME "NEON"	/// Name of the instruction set.
+#else
+#include <cmath>
+#define LANES_WIDTH 1		/// No vector instructions, one float at a time.
+#define LANES_NAME "scalar"	/// Name of the instruction set.
+#endif
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A lanes struct.
+	 *
+	 * This Struct holds as many floats as fit in a vector register of the
+	 * instruction set the compiler targets, AVX, SSE2 or NEON, or a single
+	 * float without any. Every operation works on all the lanes at once, so
+	 * the same loop is vectorized everywhere and still builds without them.
+	 */
+	struct Lanes {
+
+#if defined(__AVX__)
+		__m256 value;		// The floats.
+#elif defined(__SSE2__)
+		__m128 value;		// The floats.
+#elif defined(__ARM_NEON)
+		float32x4_t value;	// The floats.
+#else
+		float value;		// The float.
+#endif
+
+		/**
+		 * @brief Loads the lanes.
+		 *
+		 * Loads LANES_WIDTH floats, which do not have to be aligned.
+		 *
+		 * @param source The floats.
+		 *
+		 * @returns The lanes.
+		 */
+		static inline Lanes load(const float* source) {
+
+#if defined(__AVX__)
+			return { _mm256_loadu_ps(source) };
+#elif defined(__SSE2__)
+			return { _mm_loadu_ps(source) };
+#elif defined(__ARM_NEON)
+			return { vld1q_f32(source) };
+#else
+			return { *source };
+#endif
+
+		}
+
+		/**
+		 * @brief Fills the lanes.
+		 *
+		 * Sets every lane to the same float.
+		 *
+		 * @param value The float.
+		 *
+		 * @returns The lanes.
+		 */
+		static inline Lanes fill(float value) {
+
+#if defined(__AVX__)
+			return { _mm256_set1_ps(value) };
+#elif defined(__SSE2__)
+			return { _mm_set1_ps(value) };
+#elif defined(__ARM_NEON)
+			return { vdupq_n_f32(value) };
+#else
+			return { value };
+#endif
+
+		}
+
+		/**
+		 * @brief Stores the lanes.
+		 *
+		 * Stores LANES_WIDTH floats, which do not have to be aligned.
+		 *
+		 * @param destination Where to store the floats.
+		 */
+		inline void store(float* destination) const {
+
+#if defined(__AVX__)
+			_mm256_storeu_ps(destination, this->value);
+#elif defined(__SSE2__)
+			_mm_storeu_ps(destination, this->value);
+#elif defined(__ARM_NEON)
+			vst1q_f32(destination, this->value);
+#else
+			*destination = this->value;
+#endif
+
+		}
+
+		inline Lanes operator+(const Lanes &other) const {
+
+#if defined(__AVX__)
+			return { _mm256_add_ps(this->value, other.value) };
+#elif defined(__SSE2__)
+			return { _mm_add_ps(this->value, other.value) };
+#elif defined(__ARM_NEON)
+			return { vaddq_f32(this->value, other.value) };
+#else
+			return { this->value + other.value };
+#endif
+
+		}
+
+		inline Lanes operator-(const Lanes &other) const {
+
+#if defined(__AVX__)
+			return { _mm256_sub_ps(this->value, other.value) };
+#elif defined(__SSE2__)
+			return { _mm_sub_ps(this->value, other.value) };
+#elif defined(__ARM_NEON)
+			return { vsubq_f32(this->value, other.value) };
+#else
+			return { this->value - other.value };
+#endif
+
+		}
+
+		inline Lanes operator*(const Lanes &other) const {
+
+#if defined(__AVX__)
+			return { _mm256_mul_ps(this->value, other.value) };
+#elif defined(__SSE2__)
+			return { _mm_mul_ps(this->value, other.value) };
+#elif defined(__ARM_NEON)
+			return { vmulq_f32(this->value, other.value) };
+#else
+			return { this->value * other.value };
+#endif
+
+		}
+
+		inline Lanes operator/(const Lanes &other) const {
+
+#if defined(__AVX__)
+			return { _mm256_div_ps(this->value, other.value) };
+#elif defined(__SSE2__)
+			return { _mm_div_ps(this->value, other.value) };
+#elif defined(__ARM_NEON)
+			return { vdivq_f32(this->value, other.value) };
+#else
+			return { this->value / other.value };
+#endif
+
+		}
+
+		/**
+		 * @brief Gets the smallest lanes.
+		 *
+		 * Gets the smallest of two floats in every lane.
+		 *
+		 * @param a Some lanes.
+		 * @param b Some other lanes.
+		 *
+		 * @returns The smallest lanes.
+		 */
+		static inline Lanes min(const Lanes &a, const Lanes &b) {
+
+#if defined(__AVX__)
+			return { _mm256_min_ps(a.value, b.value) };
+#elif defined(__SSE2__)
+			return { _mm_min_ps(a.value, b.value) };
+#elif defined(__ARM_NEON)
+			return { vminq_f32(a.value, b.value) };
+#else
+			return { a.value < b.value ? a.value : b.value };
+#endif
+
+		}
+
+		/**
+		 * @brief Gets the largest lanes.
+		 *
+		 * Gets the largest of two floats in every lane.
+		 *
+		 * @param a Some lanes.
+		 * @param b Some other lanes.
+		 *
+		 * @returns The largest lanes.
+		 */
+		static inline Lanes max(const Lanes &a, const Lanes &b) {
+
+#if defined(__AVX__)
+			return { _mm256_max_ps(a.value, b.value) };
+#elif defined(__SSE2__)
+			return { _mm_max_ps(a.value, b.value) };
+#elif defined(__ARM_NEON)
+			return { vmaxq_f32(a.value, b.value) };
+#else
+			return { a.value > b.value ? a.value : b.value };
+#endif
+
+		}
+
+		/**
+		 * @brief Gets the square root.
+		 *
+		 * Gets the square root of every lane.
+		 *
+		 * @param a The lanes.
+		 *
+		 * @returns The square roots.
+		 */
+		static inline Lanes sqrt(const Lanes &a) {
+
+#if defined(__AVX__)
+			return { _mm256_sqrt_ps(a.value) };
+#elif defined(__SSE2__)
+			return { _mm_sqrt_ps(a.value) };
+#elif defined(__ARM_NEON)
+			return { vsqrtq_f32(a.value) };
+#else
+			return { std::sqrt(a.value) };
+#endif
+
+		}
+
+		/**
+		 * @brief Gets the absolute value.
+		 *
+		 * Clears the sign of every lane.
+		 *
+		 * @param a The lanes.
+		 *
+		 * @returns The absolute values.
+		 */
+		static inline Lanes abs(const Lanes &a) {
+
+#if defined(__AVX__)
+			return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.value) };
+#elif defined(__SSE2__)
+			return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.value) };
+#elif defined(__ARM_NEON)
+			return { vabsq_f32(a.value) };
+#else
+			return { std::fabs(a.value) };
+#endif
+
+		}
+
+		/**
+		 * @brief Copies the sign.
+		 *
+		 * Gets the magnitude of every lane of a with the sign of the same lane
+		 * of b.
+		 *
+		 * @param a The magnitudes.
+		 * @param b The signs.
+		 *
+		 * @returns The lanes with the signs copied.
+		 */
+		static inline Lanes copySign(const Lanes &a, const Lanes &b) {
+
+#if defined(__AVX__)
+			__m256 sign = _mm256_set1_ps(-0.0f);
+			return { _mm256_or_ps(_mm256_andnot_ps(sign, a.value), _mm256_and_ps(sign, b.value)) };
+#elif defined(__SSE2__)
+			__m128 sign = _mm_set1_ps(-0.0f);
+			return { _mm_or_ps(_mm_andnot_ps(sign, a.value), _mm_and_ps(sign, b.value)) };
+#elif defined(__ARM_NEON)
+			return { vbslq_f32(vdupq_n_u32(0x80000000u), b.value, a.value) };
+#else
+			return { std::copysign(a.value, b.value) };
+#endif
+
+		}
+
+		/**
+		 * @brief Rounds down.
+		 *
+		 * Rounds every lane down to the nearest whole number. Without SSE4.1
+		 * the lanes must fit in an int.
+		 *
+		 * @param a The lanes.
+		 *
+		 * @returns The rounded lanes.
+		 */
+		static inline Lanes floor(const Lanes &a) {
+
+#if defined(__AVX__)
+			return { _mm256_floor_ps(a.value) };
+#elif defined(__SSE2__)
+			__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.value));
+			return { _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a.value), _mm_set1_ps(1.0f))) };
+#elif defined(__ARM_NEON)
+			return { vrndmq_f32(a.value) };
+#else
+			return { std::floor(a.value) };
+#endif
+
+		}
+
+		/**
+		 * @brief Compares the lanes.
+		 *
+		 * Gets a mask of the lanes where a is greater than b, only meant to be
+		 * given to select.
+		 *
+		 * @param a Some lanes.
+		 * @param b Some other lanes.
+		 *
+		 * @returns The mask.
+		 */
+		static inline Lanes greater(const Lanes &a, const Lanes &b) {
+
+#if defined(__AVX__)
+			return { _mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ) };
+#elif defined(__SSE2__)
+			return { _mm_cmpgt_ps(a.value, b.value) };
+#elif defined(__ARM_NEON)
+			return { vreinterpretq_f32_u32(vcgtq_f32(a.value, b.value)) };
+#else
+			return { a.value > b.value ? 1.0f : 0.0f };
+#endif
+
+		}
+
+		/**
+		 * @brief Selects some lanes.
+		 *
+		 * Gets the lanes of a where the mask is set and those of b elsewhere.
+		 *
+		 * @param mask The mask, from greater.
+		 * @param a The lanes where the mask is set.
+		 * @param b The lanes where it is not.
+		 *
+		 * @returns The selected lanes.
+		 */
+		static inline Lanes select(const Lanes &mask, const Lanes &a, const Lanes &b) {
+
+#if defined(__AVX__)
+			return { _mm256_blendv_ps(b.value, a.value, mask.value) };
+#elif defined(__SSE2__)
+			return { _mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value)) };
+#elif defined(__ARM_NEON)
+			return { vbslq_f32(vreinterpretq_u32_f32(mask.value), a.value, b.value) };
+#else
+			return { mask.value != 0.0f ? a.value : b.value };
+#endif
+
+		}
+
+		/**
+		 * @brief Gets the base 2 logarithm.
+		 *
+		 * Gets the base 2 logarithm of every lane, from the exponent of the
+		 * float and a polynomial of its mantissa, to about 1e-7. Lanes of zero
+		 * or less come out as about -100.
+		 *
+		 * @param a The lanes.
+		 *
+		 * @returns The logarithms.
+		 */
+		static inline Lanes log2(const Lanes &a) {
+
+#if LANES_WIDTH == 1
+			return { std::log2(a.value > 1e-30f ? a.value : 1e-30f) };
+#else
+			// Denormals would have the wrong exponent, so they are raised first.
+			Lanes x = Lanes::max(a, Lanes::fill(1e-30f));
+			Lanes exponent, mantissa;
+
+#if defined(__AVX__)
+			exponent = { _mm256_cvtepi32_ps(_mm256_castps_si256(_mm256_and_ps(x.value, _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000))))) };
+			mantissa = { _mm256_or_ps(_mm256_and_ps(x.value, _mm256_castsi256_ps(_mm256_set1_epi32(0x007fffff))), _mm256_set1_ps(1.0f)) };
+#elif defined(__SSE2__)
+			exponent = { _mm_cvtepi32_ps(_mm_castps_si128(_mm_and_ps(x.value, _mm_castsi128_ps(_mm_set1_epi32(0x7f800000))))) };
+			mantissa = { _mm_or_ps(_mm_and_ps(x.value, _mm_castsi128_ps(_mm_set1_epi32(0x007fffff))), _mm_set1_ps(1.0f)) };
+#else
+			uint32x4_t bits = vreinterpretq_u32_f32(x.value);
+			exponent = { vcvtq_f32_s32(vreinterpretq_s32_u32(vandq_u32(bits, vdupq_n_u32(0x7f800000)))) };
+			mantissa = { vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f800000))) };
+#endif
+
+			exponent = exponent * Lanes::fill(1.0f / 8388608.0f) - Lanes::fill(127.0f);
+
+			// Keep the mantissa around 1, where the series is best.
+			Lanes high = Lanes::greater(mantissa, Lanes::fill(1.41421356f));
+			mantissa = Lanes::select(high, mantissa * Lanes::fill(0.5f), mantissa);
+			exponent = Lanes::select(high, exponent + Lanes::fill(1.0f), exponent);
+
+			// log2(m) = 2 / ln(2) * atanh((m - 1) / (m + 1)).
+			Lanes one = Lanes::fill(1.0f);
+			Lanes t = (mantissa - one) / (mantissa + one);
+			Lanes t2 = t * t;
+			Lanes series = Lanes::fill(0.41219858f) * t2 + Lanes::fill(0.57707802f);
+			series = series * t2 + Lanes::fill(0.96179669f);
+			series = series * t2 + Lanes::fill(2.88539008f);
+
+			return exponent + series * t;
+#endif
+
+		}
+
+		/**
+		 * @brief Raises 2 to the lanes.
+		 *
+		 * Gets 2 to the power of every lane, building the power of the whole
+		 * part in the exponent of the float and a polynomial of the rest, to
+		 * about 1e-5 relative. The lanes are clamped between -126 and 127.
+		 *
+		 * @param a The lanes.
+		 *
+		 * @returns The powers.
+		 */
+		static inline Lanes exp2(const Lanes &a) {
+
+#if LANES_WIDTH == 1
+			return { std::exp2(a.value < -126.0f ? -126.0f : a.value > 127.0f ? 127.0f : a.value) };
+#else
+			Lanes x = Lanes::min(Lanes::max(a, Lanes::fill(-126.0f)), Lanes::fill(127.0f));
+			Lanes whole = Lanes::floor(x);
+			Lanes fraction = x - whole;
+
+			// The Taylor series of 2^f up to the sixth power.
+			Lanes series = Lanes::fill(1.5403530e-4f) * fraction + Lanes::fill(1.3333558e-3f);
+			series = series * fraction + Lanes::fill(9.6181291e-3f);
+			series = series * fraction + Lanes::fill(5.5504109e-2f);
+			series = series * fraction + Lanes::fill(2.4022651e-1f);
+			series = series * fraction + Lanes::fill(6.9314718e-1f);
+			series = series * fraction + Lanes::fill(1.0f);
+
+			// The biased exponent shifted in place, as a float so it needs no integer lanes.
+			Lanes biased = (whole + Lanes::fill(127.0f)) * Lanes::fill(8388608.0f);
+			Lanes power;
+
+#if defined(__AVX__)
+			power = { _mm256_castsi256_ps(_mm256_cvtps_epi32(biased.value)) };
+#elif defined(__SSE2__)
+			power = { _mm_castsi128_ps(_mm_cvtps_epi32(biased.value)) };
+#else
+			power = { vreinterpretq_f32_s32(vcvtq_s32_f32(biased.value)) };
+#endif
+
+			return series * power;
+#endif
+
+		}
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_LANES_H_
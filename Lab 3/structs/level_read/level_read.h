@@ -0,0 +1,39 @@
+/**
+ * @file level_read.h
+ * @brief LevelRead struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_LEVEL_READ_H_
+#define BGQ_OPENGL_STRUCT_LEVEL_READ_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A level read struct.
+	 *
+	 * This Struct represents a mip level read from disk for a streamed texture.
+	 */
+	struct LevelRead {
+
+		size_t array = 0;					// Index of the streamed array.
+		int level = 0;						// Level that was read.
+		std::vector<unsigned char> pixels;	// Pixels of every layer, empty if the read failed.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_LEVEL_READ_H_
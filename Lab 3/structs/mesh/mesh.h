@@ -0,0 +1,43 @@
+/**
+ * @file mesh.h
+ * @brief Mesh struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_MESH_H_
+#define BGQ_OPENGL_STRUCT_MESH_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A mesh struct.
+	 *
+	 * This Struct holds the triangles of a loaded model in memory, before any
+	 * OpenGL buffer is made from them.
+	 */
+	struct Mesh {
+
+		std::vector<Vertex> vertices;	// Vertices of the triangles.
+		std::vector<GLuint> indices;	// Three indices per triangle.
+		float shininess = 0.0f;			// Shininess of the material.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_MESH_H_
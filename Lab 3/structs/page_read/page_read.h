@@ -0,0 +1,41 @@
+/**
+ * @file page_read.h
+ * @brief PageRead struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_PAGE_READ_H_
+#define BGQ_OPENGL_STRUCT_PAGE_READ_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A page read struct.
+	 *
+	 * This Struct represents a page of a virtual texture read from disk.
+	 */
+	struct PageRead {
+
+		uint32_t key = 0;					// Level and position of the page, packed.
+		int x = 0;							// Column of the page within its level.
+		int y = 0;							// Row of the page within its level.
+		int level = 0;						// Level of the page.
+		std::vector<unsigned char> pixels;	// Pixels of every layer, empty if the read failed.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_PAGE_READ_H_
@@ -0,0 +1,37 @@
+/**
+ * @file pending_deletion.h
+ * @brief PendingDeletion struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_PENDING_DELETION_H_
+#define BGQ_OPENGL_STRUCT_PENDING_DELETION_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A pending deletion struct.
+	 *
+	 * This Struct represents an OpenGL object waiting to be deleted.
+	 */
+	struct PendingDeletion {
+
+		int type;	// One of the DELETE_* types.
+		GLuint id;	// OpenGL name of the object.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_PENDING_DELETION_H_
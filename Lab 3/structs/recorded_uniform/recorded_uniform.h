@@ -0,0 +1,40 @@
+/**
+ * @file recorded_uniform.h
+ * @brief RecordedUniform struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_RECORDED_UNIFORM_H_
+#define BGQ_OPENGL_STRUCT_RECORDED_UNIFORM_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A recorded uniform struct.
+	 *
+	 * This Struct represents a uniform of a program whose value is recorded
+	 * with every draw.
+	 */
+	struct RecordedUniform {
+
+		GLint location = -1;	// Location in the program.
+		GLenum type = 0;		// Type, like GL_FLOAT_VEC3.
+		int components = 0;		// Number of floats or integers in the value.
+		bool integer = false;	// Whether it is read as integers.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_RECORDED_UNIFORM_H_
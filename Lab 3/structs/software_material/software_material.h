@@ -0,0 +1,39 @@
+/**
+ * @file software_material.h
+ * @brief SoftwareMaterial struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_SOFTWARE_MATERIAL_H_
+#define BGQ_OPENGL_STRUCT_SOFTWARE_MATERIAL_H_
+
+#include "structs/software_texture/software_texture.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A software material struct.
+	 *
+	 * This Struct holds the maps of a material for the software renderer, the
+	 * same ones the texture arrays hold a layer of.
+	 */
+	struct SoftwareMaterial {
+
+		SoftwareTexture color;	// Base color, sRGB.
+		SoftwareTexture bump;	// Heights in red.
+		SoftwareTexture normal;	// Tangent space normal in red and green.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_SOFTWARE_MATERIAL_H_
@@ -0,0 +1,40 @@
+/**
+ * @file software_texture.h
+ * @brief SoftwareTexture struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_SOFTWARE_TEXTURE_H_
+#define BGQ_OPENGL_STRUCT_SOFTWARE_TEXTURE_H_
+
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A software texture struct.
+	 *
+	 * This Struct holds the pixels of a texture in memory, for the software
+	 * renderer to sample.
+	 */
+	struct SoftwareTexture {
+
+		int width = 0;									// Width of the finest level.
+		int height = 0;									// Height of the finest level.
+		bool srgb = false;								// Whether the texels are sRGB, decoded before filtering.
+		std::vector<std::vector<unsigned char>> levels;	// Every level, finest first, RGBA8 with the bottom row first.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_SOFTWARE_TEXTURE_H_